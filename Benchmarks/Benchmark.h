@@ -0,0 +1,55 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include <chrono>
+
+namespace EE
+{
+    namespace Benchmarks
+    {
+        typedef void (*BenchmarkFunction)();
+
+        //* Adds a benchmark to the ones BenchmarkMain runs, made by EE_BENCHMARK
+        struct BenchmarkRegistration
+        {
+            BenchmarkRegistration( const char* name, BenchmarkFunction function );
+        };
+
+        //* Keeps the optimizer from dropping work whose result is otherwise unused
+        template<typename T>
+        FORCEINLINE void Consume( const T& value )
+        {
+            static volatile uint8 sink;
+            const uint8* bytes = reinterpret_cast<const uint8*>( &value );
+            for ( size_t i = 0; i < sizeof( T ); i++ )
+                sink = bytes[ i ];
+        }
+
+        //* Prints the best time per item of several runs of function, it's run once before to warm the caches
+        template<typename Function>
+        double Measure( const char* name, uint64 itemCount, const Function& function )
+        {
+            constexpr uint32 kRunCount = 7;
+
+            function();
+            double bestSeconds = 1e30;
+            for ( uint32 run = 0; run < kRunCount; run++ )
+            {
+                const auto start = std::chrono::steady_clock::now();
+                function();
+                const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+                bestSeconds = elapsed.count() < bestSeconds ? elapsed.count() : bestSeconds;
+            }
+
+            const double nanosecondsPerItem = bestSeconds * 1e9 / (double)(itemCount > 0 ? itemCount : 1);
+            printf( "  %-40s %10.2f ns/item\n", name, nanosecondsPerItem );
+            return nanosecondsPerItem;
+        }
+    }
+}
+
+#define EE_BENCHMARK( Name ) \
+    static void Name(); \
+    static EE::Benchmarks::BenchmarkRegistration Name##Registration( #Name, Name ); \
+    static void Name()
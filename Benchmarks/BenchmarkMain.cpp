@@ -0,0 +1,44 @@
+#include "Benchmark.h"
+
+#include "Core/Collections.h"
+
+namespace EE
+{
+    namespace Benchmarks
+    {
+        struct BenchmarkEntry
+        {
+            const char* name;
+            BenchmarkFunction function;
+        };
+
+        // Filled during static initialization, before main
+        static TArray<BenchmarkEntry>& GetBenchmarks()
+        {
+            static TArray<BenchmarkEntry> benchmarks;
+            return benchmarks;
+        }
+
+        BenchmarkRegistration::BenchmarkRegistration( const char* name, BenchmarkFunction function )
+        {
+            GetBenchmarks().push_back( BenchmarkEntry{ name, function } );
+        }
+    }
+}
+
+//* Runs every benchmark, or only the ones whose name contains the first argument. Build it optimized
+int main( int argc, char** argv )
+{
+    using namespace EE::Benchmarks;
+
+    const char* filter = argc > 1 ? argv[ 1 ] : NULL;
+    for ( const BenchmarkEntry& benchmark : GetBenchmarks() )
+    {
+        if ( filter != NULL && strstr( benchmark.name, filter ) == NULL )
+            continue;
+
+        printf( "%s\n", benchmark.name );
+        benchmark.function();
+    }
+    return 0;
+}
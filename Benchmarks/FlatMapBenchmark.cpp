@@ -0,0 +1,99 @@
+#include "Benchmark.h"
+
+#include "Core/Collections.h"
+
+#include <random>
+
+namespace EE
+{
+    using namespace Benchmarks;
+
+    //* Unique keys in random order, the second half is never inserted and is used for misses
+    template<typename K, typename MakeKey>
+    static TArray<K> MakeKeys( uint32 count, const MakeKey& makeKey )
+    {
+        std::mt19937_64 random( 7 );
+        TArray<K> keys;
+        keys.reserve( count * 2 );
+        TFlatMap<K, bool> used;
+        while ( keys.size() < count * 2 )
+        {
+            K key = makeKey( random() );
+            if ( used.try_emplace( key, true ).second )
+                keys.push_back( std::move( key ) );
+        }
+        return keys;
+    }
+
+    template<typename Map, typename K>
+    static void RunMap( const char* name, const TArray<K>& keys, uint32 count )
+    {
+        printf( " %s\n", name );
+
+        Measure( "insert", count, [ & ]()
+        {
+            Map map;
+            for ( uint32 i = 0; i < count; i++ )
+                map.emplace( keys[ i ], i );
+            Consume( map.size() );
+        } );
+
+        Map map;
+        for ( uint32 i = 0; i < count; i++ )
+            map.emplace( keys[ i ], i );
+
+        Measure( "find hit", count, [ & ]()
+        {
+            uint64 sum = 0;
+            for ( uint32 i = 0; i < count; i++ )
+                sum += map.find( keys[ i ] )->second;
+            Consume( sum );
+        } );
+
+        Measure( "find miss", count, [ & ]()
+        {
+            uint64 found = 0;
+            for ( uint32 i = count; i < count * 2; i++ )
+                found += map.find( keys[ i ] ) != map.end();
+            Consume( found );
+        } );
+
+        Measure( "iterate", count, [ & ]()
+        {
+            uint64 sum = 0;
+            for ( const auto& [ key, value ] : map )
+                sum += value;
+            Consume( sum );
+        } );
+
+        Measure( "erase and insert", count, [ & ]()
+        {
+            for ( uint32 i = 0; i < count; i += 2 )
+                map.erase( keys[ i ] );
+            for ( uint32 i = 0; i < count; i += 2 )
+                map.emplace( keys[ i ], i );
+            Consume( map.size() );
+        } );
+    }
+
+    template<typename K, typename MakeKey>
+    static void CompareMaps( const char* label, uint32 count, const MakeKey& makeKey )
+    {
+        printf( " %s, %u keys\n", label, count );
+        const TArray<K> keys = MakeKeys<K>( count, makeKey );
+        RunMap<TMap<K, uint32>>( "TMap", keys, count );
+        RunMap<TFlatMap<K, uint32>>( "TFlatMap", keys, count );
+    }
+
+    EE_BENCHMARK( FlatMap )
+    {
+        const auto makeInteger = []( uint64 value ) { return (uint32)value; };
+        const auto makeString = []( uint64 value ) { return std::to_string( value ); };
+
+        // Small maps stay in cache, large ones measure the memory accesses per operation
+        CompareMaps<uint32>( "uint32", 1000, makeInteger );
+        CompareMaps<uint32>( "uint32", 1000000, makeInteger );
+        CompareMaps<std::string>( "std::string", 1000, makeString );
+        CompareMaps<std::string>( "std::string", 1000000, makeString );
+    }
+}
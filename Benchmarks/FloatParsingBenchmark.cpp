@@ -0,0 +1,91 @@
+#include "Benchmark.h"
+
+#include "Core/Collections.h"
+#include "Utils/TextFormattingMath.h"
+
+#include <charconv>
+#include <random>
+
+namespace EE
+{
+    using namespace Benchmarks;
+
+    //* Vertex positions as exporters write them, six decimals and mixed signs
+    static U8String MakeVertexText( uint32 vertexCount, const char* format )
+    {
+        std::mt19937 random( 42 );
+        std::uniform_real_distribution<float> distribution( -100.F, 100.F );
+        U8String text;
+        char line[ 128 ];
+        for ( uint32 i = 0; i < vertexCount; i++ )
+        {
+            const int32 size = snprintf( line, sizeof( line ), format, distribution( random ), distribution( random ), distribution( random ) );
+            text.append( line, size );
+        }
+        return text;
+    }
+
+    static void RunFloatParsing( const char* label, const U8String& text, uint32 valueCount )
+    {
+        printf( " %s\n", label );
+
+        Measure( "strtof", valueCount, [ & ]()
+        {
+            const char* it = text.c_str();
+            char* end;
+            float sum = 0;
+            for ( uint32 i = 0; i < valueCount; i++, it = end )
+                sum += strtof( it, &end );
+            Consume( sum );
+        } );
+
+        Measure( "std::from_chars", valueCount, [ & ]()
+        {
+            const char* it = text.data();
+            const char* const last = it + text.size();
+            float sum = 0;
+            for ( uint32 i = 0; i < valueCount; i++ )
+            {
+                while ( *it == ' ' || *it == '\n' ) ++it;
+                float value = 0;
+                it = std::from_chars( it, last, value ).ptr;
+                sum += value;
+            }
+            Consume( sum );
+        } );
+
+        Measure( "Text::ParseFloat", valueCount, [ & ]()
+        {
+            std::string_view view( text );
+            float sum = 0;
+            for ( uint32 i = 0; i < valueCount; i++ )
+            {
+                if ( view.front() == '\n' ) view.remove_prefix( 1 );
+                sum += Text::ParseFloat( &view );
+            }
+            Consume( sum );
+        } );
+
+        Measure( "Text::ParseFloat3", valueCount, [ & ]()
+        {
+            std::string_view view( text );
+            Vector3f sum( 0.F );
+            Vector3f vector;
+            for ( uint32 i = 0; i < valueCount / 3; i++ )
+            {
+                if ( view.front() == '\n' ) view.remove_prefix( 1 );
+                Text::ParseFloat3( &view, vector );
+                sum.x += vector.x; sum.y += vector.y; sum.z += vector.z;
+            }
+            Consume( sum );
+        } );
+    }
+
+    EE_BENCHMARK( FloatParsing )
+    {
+        constexpr uint32 kVertexCount = 1000000;
+        RunFloatParsing( "Six decimals", MakeVertexText( kVertexCount, "%.6f %.6f %.6f\n" ), kVertexCount * 3 );
+        RunFloatParsing( "Nine significant digits", MakeVertexText( kVertexCount, "%.9g %.9g %.9g\n" ), kVertexCount * 3 );
+        RunFloatParsing( "Exponents", MakeVertexText( kVertexCount, "%.7e %.7e %.7e\n" ), kVertexCount * 3 );
+    }
+}
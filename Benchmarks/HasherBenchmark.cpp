@@ -0,0 +1,137 @@
+#include "Benchmark.h"
+
+#include "Core/Collections.h"
+#include "Rendering/Mesh.h"
+#include "Utils/Hasher.h"
+
+#include <random>
+
+namespace EE
+{
+    using namespace Benchmarks;
+
+    //* HashCombine as it was before the wyhash mix, kept to compare against
+    static void PreviousHashCombine( uint64* ) {}
+
+    template <typename T, typename... Rest>
+    static void PreviousHashCombine( uint64* seed, const T& value, Rest... rest )
+    {
+        std::hash<T> hasher;
+        *seed ^= hasher( value ) + 0x9e3779b9 + (*seed << 6) + (*seed >> 2);
+        PreviousHashCombine( seed, rest... );
+    }
+
+    //* Index triplets like the ones used to weld vertices
+    struct CornerKey
+    {
+        uint32 position;
+        uint32 uv;
+        uint32 normal;
+    };
+
+    static float RandomFloat( std::mt19937& random )
+    {
+        return std::uniform_real_distribution<float>( -1.F, 1.F )( random );
+    }
+
+    EE_BENCHMARK( Hasher )
+    {
+        constexpr uint32 kCount = 1000000;
+        std::mt19937 random( 3 );
+
+        TArray<StaticVertex> vertices( kCount );
+        for ( StaticVertex& vertex : vertices )
+        {
+            vertex.position = Vector3f( RandomFloat( random ), RandomFloat( random ), RandomFloat( random ) );
+            vertex.normal = Vector3f( RandomFloat( random ), RandomFloat( random ), RandomFloat( random ) );
+            vertex.tangent = Vector3f( RandomFloat( random ), RandomFloat( random ), RandomFloat( random ) );
+            vertex.uv0 = Vector2f( RandomFloat( random ), RandomFloat( random ) );
+            vertex.uv1 = Vector2f( RandomFloat( random ), RandomFloat( random ) );
+            vertex.color = Vector4f( RandomFloat( random ), RandomFloat( random ), RandomFloat( random ), 1.F );
+        }
+
+        printf( " StaticVertex fields, %u vertices\n", kCount );
+        Measure( "previous HashCombine", kCount, [ & ]()
+        {
+            uint64 sum = 0;
+            for ( const StaticVertex& t : vertices )
+            {
+                uint64 hash = 0;
+                PreviousHashCombine( &hash, t.position.x, t.position.y, t.position.z, t.normal.x, t.normal.y, t.normal.z,
+                    t.tangent.x, t.tangent.y, t.tangent.z, t.uv0.x, t.uv0.y, t.uv1.x, t.uv1.y, t.color.x, t.color.y, t.color.z, t.color.w );
+                sum += hash;
+            }
+            Consume( sum );
+        } );
+        Measure( "HashCombine", kCount, [ & ]()
+        {
+            uint64 sum = 0;
+            for ( const StaticVertex& t : vertices )
+            {
+                uint64 hash = 0;
+                HashCombine( &hash, t.position.x, t.position.y, t.position.z, t.normal.x, t.normal.y, t.normal.z,
+                    t.tangent.x, t.tangent.y, t.tangent.z, t.uv0.x, t.uv0.y, t.uv1.x, t.uv1.y, t.color.x, t.color.y, t.color.z, t.color.w );
+                sum += hash;
+            }
+            Consume( sum );
+        } );
+
+        TArray<CornerKey> keys( kCount );
+        for ( CornerKey& key : keys )
+            key = CornerKey{ (uint32)random(), (uint32)random(), (uint32)random() };
+
+        printf( " Index triplets, %u keys\n", kCount );
+        Measure( "previous HashCombine", kCount, [ & ]()
+        {
+            uint64 sum = 0;
+            for ( const CornerKey& key : keys )
+            {
+                uint64 hash = 0;
+                PreviousHashCombine( &hash, key.position, key.uv, key.normal );
+                sum += hash;
+            }
+            Consume( sum );
+        } );
+        Measure( "HashCombine", kCount, [ & ]()
+        {
+            uint64 sum = 0;
+            for ( const CornerKey& key : keys )
+            {
+                uint64 hash = 0;
+                HashCombine( &hash, key.position, key.uv, key.normal );
+                sum += hash;
+            }
+            Consume( sum );
+        } );
+        Measure( "HashValueBytes", kCount, [ & ]()
+        {
+            uint64 sum = 0;
+            for ( const CornerKey& key : keys )
+                sum += HashValueBytes( key );
+            Consume( sum );
+        } );
+
+        // Buffers the size of a mesh source file
+        TArray<uint8> bytes( 64u << 20 );
+        for ( uint8& byte : bytes )
+            byte = (uint8)random();
+
+        printf( " %zu MiB buffer, ns per KiB\n", bytes.size() >> 20 );
+        Measure( "std::hash<std::string_view>", bytes.size() >> 10, [ & ]()
+        {
+            Consume( std::hash<std::string_view>()( std::string_view( reinterpret_cast<const char*>( bytes.data() ), bytes.size() ) ) );
+        } );
+        Measure( "HashBytes", bytes.size() >> 10, [ & ]()
+        {
+            Consume( HashBytes( bytes.data(), bytes.size() ) );
+        } );
+        Measure( "CRC32 byte by byte", bytes.size() >> 10, [ & ]()
+        {
+            Consume( ~CRC32Implementation( bytes.data(), bytes.size(), ~0u ) );
+        } );
+        Measure( "EncodeCRC32", bytes.size() >> 10, [ & ]()
+        {
+            Consume( EncodeCRC32( bytes.data(), bytes.size() ) );
+        } );
+    }
+}
@@ -8,7 +8,7 @@
 
 namespace EE
 {
-	AudioDevice::AudioDevice() : PlayInfoList()
+	AudioDevice::AudioDevice() : PlayInfoList(), PlayInfoPool( Memory::MemoryTag_Audio )
 	{
 		volume = 1.F;
 		static SDL_AudioSpec sampleSpecs;
@@ -71,7 +71,8 @@ namespace EE
 		if ( Sample == NULL ) return 0;
 
 		static size_t Increment = 0;
-		PlayInfoList.emplace( ++Increment, new SamplePlayInfo( Sample, volume, Loop, !PlayOnAdd, Increment ) );
+		++Increment;
+		PlayInfoList.emplace( Increment, PlayInfoPool.Acquire( Sample, volume, Loop, !PlayOnAdd, Increment ) );
 		return Increment;
 	}
 
@@ -80,8 +81,8 @@ namespace EE
 		auto PlayInfoIt = PlayInfoList.find( Identifier );
 		if ( PlayInfoIt != PlayInfoList.end() )
 		{
-			delete PlayInfoIt->second;
-			PlayInfoList.erase( Identifier );
+			PlayInfoPool.Release( PlayInfoIt->second );
+			PlayInfoList.erase( PlayInfoIt );
 		}
 	}
 
@@ -3,20 +3,21 @@
 
 #include "Engine/Ticker.h"
 #include "Audio/AudioSample.h"
+#include "Utils/Memory.h"
 
 namespace EE
 {
 	AudioSample::AudioSample( unsigned char* Buffer, uint32 SampleSize, uint32 BufferLength, uint32 Frecuency, uint32 ChannelCount )
 		: SampleSize( SampleSize ), BufferLength( BufferLength ), Frecuency( Frecuency ), ChannelCount( ChannelCount ), format( EAudioFormat::Float32 )
 	{
-		this->Buffer = new unsigned char[ BufferLength ];
+		this->Buffer = static_cast<unsigned char*>( Memory::TaggedAlloc( BufferLength, 16, Memory::MemoryTag_Audio ) );
 		memcpy( this->Buffer, Buffer, BufferLength );
 		Duration = (int64)(((BufferLength * 8u / (SampleSize * ChannelCount)) / (float)Frecuency) * Ticker::Mili::GetSizeInNano());
 	}
 
 	AudioSample::~AudioSample()
 	{
-		delete Buffer;
+		Memory::TaggedFree( Buffer );
 	}
 
 	unsigned char* AudioSample::GetBufferAt( uint32 Offset )
@@ -0,0 +1,523 @@
+#include "CoreMinimal.h"
+
+#include "Core/JobSystem.h"
+#include "Utils/Memory.h"
+
+#include <condition_variable>
+#include <thread>
+
+namespace EE
+{
+    struct Job
+    {
+        JobFunction function;
+        JobCounter* counter;
+
+        Job( JobFunction&& function, JobCounter* counter ) : function( std::move( function ) ), counter( counter ) {}
+    };
+
+    struct JobCache;
+
+    struct JobSlot
+    {
+        // Storage must be the first member, job pointers are reinterpreted as slots
+        alignas(Job) uint8 storage[ sizeof( Job ) ];
+        JobCache* owner;
+        JobSlot* nextFree;
+    };
+
+    //* Job memory of a thread. Jobs are made from the cache of the thread that runs them and go back to the cache
+    //* they came from, the owner frees to its own list and other threads push to a lock-free stack that the owner
+    //* takes whole once its list runs out. Only pushes race there, so the stack has no ABA problem
+    struct JobCache
+    {
+        static constexpr uint32 ChunkSize = 256;
+
+        JobSlot* localFree = NULL;
+        std::atomic<JobSlot*> remoteFree = NULL;
+        TArray<JobSlot*> chunks;
+    };
+
+    //* Caches of finished threads are kept for new ones, their jobs may still be released by other threads
+    class JobCacheRegistry
+    {
+    public:
+        JobCache* Acquire()
+        {
+            std::unique_lock<std::mutex> lock( _lock );
+            if ( _idleCaches.empty() )
+                return new JobCache();
+
+            JobCache* cache = _idleCaches.back();
+            _idleCaches.pop_back();
+            return cache;
+        }
+
+        void Return( JobCache* cache )
+        {
+            std::unique_lock<std::mutex> lock( _lock );
+            _idleCaches.push_back( cache );
+        }
+
+        static JobCacheRegistry& Get()
+        {
+            // Never destroyed, workers stopped during the static destruction still return their caches
+            static JobCacheRegistry* registry = new JobCacheRegistry();
+            return *registry;
+        }
+
+    private:
+        std::mutex _lock;
+        TArray<JobCache*> _idleCaches;
+    };
+
+    struct JobCacheOwner
+    {
+        JobCache* cache = NULL;
+
+        ~JobCacheOwner()
+        {
+            if ( cache != NULL )
+                JobCacheRegistry::Get().Return( cache );
+        }
+    };
+
+    static thread_local JobCacheOwner GJobCacheOwner;
+
+    // Worker of the calling thread, -1 on threads the job system didn't start
+    static thread_local int32 GJobWorkerIndex = -1;
+
+    static JobSlot* AllocateJobChunk( JobCache& cache )
+    {
+        const size_t size = sizeof( JobSlot ) * JobCache::ChunkSize;
+        JobSlot* chunk = static_cast<JobSlot*>( Memory::TaggedAlloc( size, alignof( JobSlot ), Memory::MemoryTag_Jobs ) );
+        cache.chunks.push_back( chunk );
+        for ( uint32 i = 0; i < JobCache::ChunkSize; i++ )
+        {
+            chunk[ i ].owner = &cache;
+            chunk[ i ].nextFree = i + 1 < JobCache::ChunkSize ? &chunk[ i + 1 ] : NULL;
+        }
+        return chunk;
+    }
+
+    static Job* AcquireJob( JobFunction&& function, JobCounter* counter )
+    {
+        JobCache*& cache = GJobCacheOwner.cache;
+        if ( cache == NULL )
+            cache = JobCacheRegistry::Get().Acquire();
+
+        JobSlot* slot = cache->localFree;
+        if ( slot == NULL )
+        {
+            slot = cache->remoteFree.exchange( NULL, std::memory_order_acquire );
+            if ( slot == NULL )
+                slot = AllocateJobChunk( *cache );
+        }
+        cache->localFree = slot->nextFree;
+        return ::new (slot->storage) Job( std::move( function ), counter );
+    }
+
+    static void ReleaseJob( Job* job )
+    {
+        JobSlot* slot = reinterpret_cast<JobSlot*>( job );
+        job->~Job();
+
+        JobCache* cache = slot->owner;
+        if ( cache == GJobCacheOwner.cache )
+        {
+            slot->nextFree = cache->localFree;
+            cache->localFree = slot;
+            return;
+        }
+
+        JobSlot* head = cache->remoteFree.load( std::memory_order_relaxed );
+        do
+        {
+            slot->nextFree = head;
+        }
+        while ( cache->remoteFree.compare_exchange_weak( head, slot, std::memory_order_release, std::memory_order_relaxed ) == false );
+    }
+
+    //* Fixed capacity Chase-Lev deque. Only the owner pushes and pops at the bottom, any thread steals from the top
+    class JobDeque
+    {
+    public:
+        static constexpr int64 Capacity = 4096;
+
+        JobDeque() : _top( 0 ), _bottom( 0 ), _jobs() {}
+
+        //* Returns false when full, the job goes to the shared queue then
+        bool Push( Job* job )
+        {
+            const int64 bottom = _bottom.load( std::memory_order_relaxed );
+            const int64 top = _top.load( std::memory_order_acquire );
+            if ( bottom - top >= Capacity )
+                return false;
+
+            _jobs[ bottom & (Capacity - 1) ].store( job, std::memory_order_relaxed );
+            _bottom.store( bottom + 1, std::memory_order_release );
+            return true;
+        }
+
+        Job* Pop()
+        {
+            const int64 bottom = _bottom.load( std::memory_order_relaxed ) - 1;
+            _bottom.store( bottom, std::memory_order_relaxed );
+            std::atomic_thread_fence( std::memory_order_seq_cst );
+            int64 top = _top.load( std::memory_order_relaxed );
+
+            if ( top > bottom )
+            {
+                _bottom.store( bottom + 1, std::memory_order_relaxed );
+                return NULL;
+            }
+
+            Job* job = _jobs[ bottom & (Capacity - 1) ].load( std::memory_order_relaxed );
+            if ( top == bottom )
+            {
+                // Last job, races with thieves for it
+                if ( _top.compare_exchange_strong( top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed ) == false )
+                    job = NULL;
+                _bottom.store( bottom + 1, std::memory_order_relaxed );
+            }
+            return job;
+        }
+
+        Job* Steal()
+        {
+            int64 top = _top.load( std::memory_order_acquire );
+            std::atomic_thread_fence( std::memory_order_seq_cst );
+            const int64 bottom = _bottom.load( std::memory_order_acquire );
+            if ( top >= bottom )
+                return NULL;
+
+            Job* job = _jobs[ top & (Capacity - 1) ].load( std::memory_order_relaxed );
+            if ( _top.compare_exchange_strong( top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed ) == false )
+                return NULL;
+            return job;
+        }
+
+    private:
+        std::atomic<int64> _top;
+        // Thieves only write the top, keep them off the line the owner writes
+        alignas( 64 ) std::atomic<int64> _bottom;
+        std::atomic<Job*> _jobs[ Capacity ];
+    };
+
+    struct alignas( 64 ) JobWorker
+    {
+        JobDeque deque;
+        std::thread thread;
+    };
+
+    class JobScheduler
+    {
+    public:
+        ~JobScheduler()
+        {
+            Stop();
+        }
+
+        void Start( uint32 workerCount )
+        {
+            if ( _workerCount > 0 )
+                return;
+
+            if ( workerCount == 0 )
+                workerCount = std::max( std::thread::hardware_concurrency(), 2u ) - 1;
+            _stop.store( false, std::memory_order_relaxed );
+            _workers = std::make_unique<JobWorker[]>( workerCount );
+            _workerCount = workerCount;
+            for ( uint32 i = 0; i < workerCount; i++ )
+                _workers[ i ].thread = std::thread( &JobScheduler::WorkerLoop, this, (int32)i );
+        }
+
+        void Stop()
+        {
+            if ( _workerCount == 0 )
+                return;
+
+            {
+                std::unique_lock<std::mutex> lock( _sleepLock );
+                _stop.store( true, std::memory_order_relaxed );
+            }
+            _sleepCondition.notify_all();
+            for ( uint32 i = 0; i < _workerCount; i++ )
+                _workers[ i ].thread.join();
+            _workerCount = 0;
+            _workers.reset();
+        }
+
+        void Submit( Job* job )
+        {
+            const int32 workerIndex = GJobWorkerIndex;
+            if ( workerIndex < 0 || _workers[ workerIndex ].deque.Push( job ) == false )
+            {
+                std::unique_lock<std::mutex> lock( _sharedLock );
+                _sharedJobs.push( job );
+                _sharedCount.fetch_add( 1, std::memory_order_relaxed );
+            }
+            Wake( false );
+        }
+
+        void SubmitBackground( Job* job )
+        {
+            {
+                std::unique_lock<std::mutex> lock( _backgroundLock );
+                _backgroundJobs.push( job );
+                _backgroundCount.fetch_add( 1, std::memory_order_relaxed );
+            }
+            // Threads sleeping in Wait can't take it, a single notify could land on one of them
+            Wake( true );
+        }
+
+        void Execute( Job* job )
+        {
+            job->function();
+            JobCounter* counter = job->counter;
+            ReleaseJob( job );
+
+            if ( counter == NULL )
+                return;
+
+            TArray<Job*> ready;
+            bool isDone;
+            {
+                std::unique_lock<std::mutex> lock( counter->_lock );
+                isDone = counter->_count.fetch_sub( 1, std::memory_order_acq_rel ) == 1;
+                if ( isDone )
+                    ready.swap( counter->_continuations );
+            }
+            // The counter may be gone from here on, Wait returns as soon as it can take its lock
+
+            for ( Job* readyJob : ready )
+                Submit( readyJob );
+            if ( isDone )
+                Wake( true );
+        }
+
+        //* Own deque first, newest jobs are hot in cache, then the shared queue, then other workers.
+        //* Background jobs come last and only when the caller is a worker loop, never from Wait
+        Job* FindJob( int32 workerIndex, bool takeBackground )
+        {
+            Job* job = NULL;
+            if ( workerIndex >= 0 && (job = _workers[ workerIndex ].deque.Pop()) != NULL )
+                return job;
+
+            if ( _sharedCount.load( std::memory_order_relaxed ) > 0 )
+            {
+                std::unique_lock<std::mutex> lock( _sharedLock );
+                if ( _sharedJobs.empty() == false )
+                {
+                    job = _sharedJobs.front();
+                    _sharedJobs.pop();
+                    _sharedCount.fetch_sub( 1, std::memory_order_relaxed );
+                    return job;
+                }
+            }
+
+            const uint32 start = workerIndex >= 0 ? (uint32)workerIndex + 1 : _stealStart.fetch_add( 1, std::memory_order_relaxed );
+            for ( uint32 i = 0; i < _workerCount; i++ )
+            {
+                const uint32 victim = (start + i) % _workerCount;
+                if ( (int32)victim != workerIndex && (job = _workers[ victim ].deque.Steal()) != NULL )
+                    return job;
+            }
+
+            if ( takeBackground && _backgroundCount.load( std::memory_order_relaxed ) > 0 )
+            {
+                std::unique_lock<std::mutex> lock( _backgroundLock );
+                if ( _backgroundJobs.empty() == false )
+                {
+                    job = _backgroundJobs.front();
+                    _backgroundJobs.pop();
+                    _backgroundCount.fetch_sub( 1, std::memory_order_relaxed );
+                    return job;
+                }
+            }
+            return NULL;
+        }
+
+        //* Runs a job or sleeps until new jobs are queued or a counter reaches zero, returns false once stopped
+        template<typename Predicate>
+        bool WorkOrSleep( int32 workerIndex, bool takeBackground, Predicate keepSleeping )
+        {
+            if ( Job* job = FindJob( workerIndex, takeBackground ) )
+            {
+                Execute( job );
+                return true;
+            }
+
+            // Announced before the last look, a Submit after it either is seen here or wakes this thread
+            _sleepers.fetch_add( 1, std::memory_order_seq_cst );
+            const uint64 epoch = _epoch.load( std::memory_order_seq_cst );
+            if ( Job* job = FindJob( workerIndex, takeBackground ) )
+            {
+                _sleepers.fetch_sub( 1, std::memory_order_relaxed );
+                Execute( job );
+                return true;
+            }
+
+            {
+                std::unique_lock<std::mutex> lock( _sleepLock );
+                _sleepCondition.wait( lock, [ & ]
+                {
+                    return _epoch.load( std::memory_order_relaxed ) != epoch || _stop.load( std::memory_order_relaxed ) || keepSleeping() == false;
+                } );
+            }
+            _sleepers.fetch_sub( 1, std::memory_order_relaxed );
+            return _stop.load( std::memory_order_relaxed ) == false;
+        }
+
+        void Wake( bool everyone )
+        {
+            _epoch.fetch_add( 1, std::memory_order_seq_cst );
+            if ( _sleepers.load( std::memory_order_seq_cst ) == 0 )
+                return;
+
+            {
+                std::unique_lock<std::mutex> lock( _sleepLock );
+            }
+            if ( everyone )
+                _sleepCondition.notify_all();
+            else
+                _sleepCondition.notify_one();
+        }
+
+        FORCEINLINE uint32 GetWorkerCount() const { return _workerCount; }
+
+        static JobScheduler& Get()
+        {
+            static JobScheduler scheduler;
+            return scheduler;
+        }
+
+    private:
+        void WorkerLoop( int32 workerIndex )
+        {
+            GJobWorkerIndex = workerIndex;
+            while ( WorkOrSleep( workerIndex, true, [] { return true; } ) ) {}
+
+            // Stopping, whatever is still queued runs before the worker leaves
+            while ( Job* job = FindJob( workerIndex, true ) )
+                Execute( job );
+            GJobWorkerIndex = -1;
+        }
+
+        std::unique_ptr<JobWorker[]> _workers;
+        uint32 _workerCount = 0;
+
+        //* Jobs from threads without a deque and overflow of full deques
+        TQueue<Job*> _sharedJobs;
+        std::mutex _sharedLock;
+        std::atomic<uint32> _sharedCount = 0;
+        std::atomic<uint32> _stealStart = 0;
+
+        //* Long jobs taken by the worker loops only
+        TQueue<Job*> _backgroundJobs;
+        std::mutex _backgroundLock;
+        std::atomic<uint32> _backgroundCount = 0;
+
+        std::mutex _sleepLock;
+        std::condition_variable _sleepCondition;
+        std::atomic<uint32> _sleepers = 0;
+        //* Changes on every submitted job and finished counter
+        std::atomic<uint64> _epoch = 0;
+        std::atomic<bool> _stop = false;
+    };
+
+    // Initialize and Exit come from the engine and from the resource loader, which may start on any thread
+    static std::mutex GJobSystemLock;
+    static uint32 GJobSystemReferences = 0;
+
+    bool JobSystem::Initialize( uint32 workerCount )
+    {
+        std::unique_lock<std::mutex> lock( GJobSystemLock );
+        GJobSystemReferences++;
+        JobScheduler::Get().Start( workerCount );
+        return true;
+    }
+
+    void JobSystem::Exit()
+    {
+        std::unique_lock<std::mutex> lock( GJobSystemLock );
+        if ( GJobSystemReferences == 0 || --GJobSystemReferences > 0 )
+            return;
+
+        JobScheduler::Get().Stop();
+    }
+
+    void JobSystem::Run( JobFunction function, JobCounter* counter )
+    {
+        JobScheduler& scheduler = JobScheduler::Get();
+        if ( scheduler.GetWorkerCount() == 0 )
+        {
+            function();
+            return;
+        }
+
+        if ( counter != NULL )
+            counter->_count.fetch_add( 1, std::memory_order_relaxed );
+        scheduler.Submit( AcquireJob( std::move( function ), counter ) );
+    }
+
+    void JobSystem::Run( JobFunction function, JobCounter* counter, JobCounter& dependency )
+    {
+        JobScheduler& scheduler = JobScheduler::Get();
+        if ( scheduler.GetWorkerCount() == 0 )
+        {
+            function();
+            return;
+        }
+
+        if ( counter != NULL )
+            counter->_count.fetch_add( 1, std::memory_order_relaxed );
+        Job* job = AcquireJob( std::move( function ), counter );
+        {
+            std::unique_lock<std::mutex> lock( dependency._lock );
+            if ( dependency.IsDone() == false )
+            {
+                dependency._continuations.push_back( job );
+                return;
+            }
+        }
+        scheduler.Submit( job );
+    }
+
+    void JobSystem::RunBackground( JobFunction function, JobCounter* counter )
+    {
+        JobScheduler& scheduler = JobScheduler::Get();
+        if ( scheduler.GetWorkerCount() == 0 )
+        {
+            function();
+            return;
+        }
+
+        if ( counter != NULL )
+            counter->_count.fetch_add( 1, std::memory_order_relaxed );
+        scheduler.SubmitBackground( AcquireJob( std::move( function ), counter ) );
+    }
+
+    void JobSystem::Wait( JobCounter& counter )
+    {
+        JobScheduler& scheduler = JobScheduler::Get();
+        const int32 workerIndex = GJobWorkerIndex;
+        while ( counter.IsDone() == false )
+        {
+            scheduler.WorkOrSleep( workerIndex, false, [ &counter ] { return counter.IsDone() == false; } );
+        }
+
+        // The last job may still be releasing the lock of the counter
+        std::unique_lock<std::mutex> lock( counter._lock );
+    }
+
+    uint32 JobSystem::GetWorkerCount()
+    {
+        return JobScheduler::Get().GetWorkerCount();
+    }
+
+    int32 JobSystem::GetWorkerIndex()
+    {
+        return GJobWorkerIndex;
+    }
+}
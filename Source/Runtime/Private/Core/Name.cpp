@@ -1,35 +1,151 @@
-
 #include "CoreMinimal.h"
 
 #include "Core/Name.h"
 
 #include "Utils/Hasher.h"
+#include "Utils/Memory.h"
 #include "Utils/TextFormatting.h"
 #include "Core/Collections.h"
 
+#include <atomic>
+
 namespace EE
 {
-    static TMap<uint64, U8String> GNamesTable = TMap<uint64, U8String>();
-    static TMap<uint64, uint64> GNameCountTable = TMap<uint64, uint64>();
-    
-    Name GEmptyName = { "", 0 };
+    struct NameEntry
+    {
+        std::atomic<NameEntry*> next;
+        std::atomic<uint64> count;
+        uint64 id;
+        uint32 length;
+        U8Char text[ 1 ];
 
-    Name::Name( const U8Char* text )
-        : _id( ConstU8StringToHash( text ) )
-        , _number()
+        std::string_view View() const { return std::string_view( text, length ); }
+    };
+
+    // Names are never released, entries are bump allocated from chunks that live until exit
+    struct NameChunk
+    {
+        NameChunk* previous;
+        std::atomic<uint32> offset;
+        uint32 capacity;
+        uint8* data;
+    };
+
+    constexpr uint32 kNameChunkSize = 64u << 10u;
+    constexpr uint32 kNameBucketCount = 1u << 16u;
+
+    // Zero initialized before any dynamic initializer runs, so names can be created during static init
+    static std::atomic<NameEntry*> GNameBuckets[ kNameBucketCount ];
+    static std::atomic<NameChunk*> GNameChunk;
+
+    static void* AllocateNameMemory( size_t size )
     {
-        if ( GNamesTable.try_emplace( _id, text ).second )
+        size = (size + alignof(NameEntry) - 1) & ~(alignof(NameEntry) - 1);
+
+        // Big names get their own block instead of wasting the rest of a chunk
+        if ( size > kNameChunkSize / 4 )
+        {
+            return Memory::AlignedAlloc( size, alignof(NameEntry) );
+        }
+
+        while ( true )
         {
-            GNamesTable.emplace( _id, text );
-            GNameCountTable.emplace( _id, 0 );
-            _number = 0;
+            NameChunk* chunk = GNameChunk.load( std::memory_order_acquire );
+            if ( chunk != NULL )
+            {
+                const uint32 offset = chunk->offset.fetch_add( (uint32)size, std::memory_order_relaxed );
+                if ( offset + size <= chunk->capacity )
+                    return chunk->data + offset;
+            }
+
+            NameChunk* newChunk = new NameChunk();
+            newChunk->previous = chunk;
+            newChunk->offset.store( 0, std::memory_order_relaxed );
+            newChunk->capacity = kNameChunkSize;
+            newChunk->data = (uint8*)Memory::AlignedAlloc( kNameChunkSize, 64 );
+            if ( GNameChunk.compare_exchange_strong( chunk, newChunk, std::memory_order_acq_rel ) == false )
+            {
+                // Another thread already replaced the chunk
+                Memory::AlignedFree( newChunk->data );
+                delete newChunk;
+            }
         }
-        else
+    }
+
+    static NameEntry* FindNameEntry( uint64 id )
+    {
+        NameEntry* entry = GNameBuckets[ id & (kNameBucketCount - 1) ].load( std::memory_order_acquire );
+        while ( entry != NULL && entry->id != id )
+            entry = entry->next.load( std::memory_order_acquire );
+        return entry;
+    }
+
+    //* Returns the entry for the text and if it was inserted by this call
+    static NameEntry* FindOrAddNameEntry( std::string_view text, uint64 id, bool& outInserted )
+    {
+        std::atomic<NameEntry*>& bucket = GNameBuckets[ id & (kNameBucketCount - 1) ];
+        NameEntry* head = bucket.load( std::memory_order_acquire );
+        NameEntry* searchEnd = NULL;
+        NameEntry* newEntry = NULL;
+
+        while ( true )
         {
-            _number = ++GNameCountTable[_id];
+            // Only the entries pushed since the last attempt need to be checked
+            for ( NameEntry* entry = head; entry != searchEnd; entry = entry->next.load( std::memory_order_acquire ) )
+            {
+                if ( entry->id == id )
+                {
+                    outInserted = false;
+                    // newEntry is left unused in the pool, races on the same new name are rare
+                    return entry;
+                }
+            }
+
+            if ( newEntry == NULL )
+            {
+                newEntry = (NameEntry*)AllocateNameMemory( offsetof( NameEntry, text ) + text.size() + 1 );
+                ::new (&newEntry->next) std::atomic<NameEntry*>( NULL );
+                ::new (&newEntry->count) std::atomic<uint64>( 0 );
+                newEntry->id = id;
+                newEntry->length = (uint32)text.size();
+                memcpy( newEntry->text, text.data(), text.size() );
+                newEntry->text[ text.size() ] = '\0';
+            }
+
+            newEntry->next.store( head, std::memory_order_relaxed );
+            searchEnd = head;
+            if ( bucket.compare_exchange_weak( head, newEntry, std::memory_order_release, std::memory_order_acquire ) )
+            {
+                outInserted = true;
+                return newEntry;
+            }
         }
     }
 
+    Name GEmptyName = { ""_name, 0 };
+
+    Name::Name( const U8Char* text )
+        : _id( ConstU8StringToHash( text ) )
+        , _number()
+        , _entry()
+    {
+        bool inserted;
+        NameEntry* entry = FindOrAddNameEntry( text, _id, inserted );
+        _entry = entry;
+        _number = inserted ? 0 : entry->count.fetch_add( 1, std::memory_order_relaxed ) + 1;
+    }
+
+    Name::Name( const NameLiteral& literal )
+        : _id( literal.id )
+        , _number()
+        , _entry()
+    {
+        bool inserted;
+        NameEntry* entry = FindOrAddNameEntry( std::string_view( literal.text, literal.length ), _id, inserted );
+        _entry = entry;
+        _number = inserted ? 0 : entry->count.fetch_add( 1, std::memory_order_relaxed ) + 1;
+    }
+
     Name::Name( const U8String& text )
         : Name( text.c_str() )
     {
@@ -38,36 +154,48 @@ namespace EE
     Name::Name( uint64 id )
         : _id()
         , _number()
+        , _entry()
     {
-        if ( GNameCountTable.find( id ) == GNameCountTable.end() )
+        NameEntry* entry = FindNameEntry( id );
+        if ( entry == NULL )
         {
             /// Create empty <see cref=Name/>
-            _id = GEmptyName.GetID();
-            _number = ++GNameCountTable[ _id ];
-        }
-        else
-        {
-            _id = id;
-            _number = ++GNameCountTable[ _id ];
+            entry = const_cast<NameEntry*>( GEmptyName._entry );
         }
+
+        _id = entry->id;
+        _entry = entry;
+        _number = entry->count.fetch_add( 1, std::memory_order_relaxed ) + 1;
     }
-    
+
     Name::Name( const U8Char* text, uint64 number )
         : _id( ConstU8StringToHash( text ) )
         , _number( number )
+        , _entry()
+    {
+        bool inserted;
+        _entry = FindOrAddNameEntry( text, _id, inserted );
+    }
+
+    Name::Name( const NameLiteral& literal, uint64 number )
+        : _id( literal.id )
+        , _number( number )
+        , _entry()
     {
+        bool inserted;
+        _entry = FindOrAddNameEntry( std::string_view( literal.text, literal.length ), _id, inserted );
     }
 
     Name::~Name() { }
 
-    const U8String& Name::GetName() const
+    std::string_view Name::GetName() const
     {
-        return GNamesTable[ _id ];
+        return _entry->View();
     }
 
     U8String Name::GetInstanceName() const
     {
-        return GNamesTable[ _id ] + "_" + Text::ToUTF8( _number );
+        return U8String( GetName() ) + "_" + Text::ToUTF8( _number );
     }
 
     const uint64& Name::GetNumber() const
@@ -89,19 +217,9 @@ namespace EE
 
     bool Name::operator<(const Name & other) const
     {
-        uint32 i = 0;
-        const U8String& entryName = GetName();
-        const U8String& otherName = other.GetName();
-        const uint64& length = entryName.length();
-        const uint64& otherLength = otherName.length();
-        
-        while ((i < length) && (i < otherLength))
-        {
-            if (entryName[i] < otherName[i]) return true;
-            else if (entryName[i] > otherName[i]) return false;
-            ++i;
-        }
-        return (length + _number < otherLength + other._number);
+        if ( _id == other._id )
+            return _number < other._number;
+        return _id < other._id;
     }
 
     bool Name::operator!=(const Name & other) const
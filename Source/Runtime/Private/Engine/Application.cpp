@@ -7,6 +7,7 @@
 #include "Engine/Input.h"
 
 #include "Math/CoreMath.h"
+#include "Utils/Memory.h"
 
 #if defined(ES_PLATFORM_WINDOWS) & defined(ES_PLATFORM_CUDA)
 #include "CUDA/CoreCUDA.h"
@@ -53,6 +54,7 @@ namespace EE
     void Application::MainLoop()
     {
         Ticker::Tick();
+        Memory::GFrameArena->NextFrame();
 
         GEngine->PollEvents();
         OnProcessInput();
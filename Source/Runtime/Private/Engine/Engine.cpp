@@ -9,6 +9,8 @@
 #include "Platform/PlatformDevice.h"
 
 #include "Utils/TextFormatting.h"
+#include "Utils/Memory.h"
+#include "Core/JobSystem.h"
 
 #define SDL_MAIN_HANDLED
 #include <SDL3/SDL_main.h>
@@ -20,6 +22,9 @@ namespace EE
 {
     bool GWantToTerminate = false;
 
+    // Size of each frame region of the engine frame arena
+    constexpr size_t kFrameArenaSize = 4u << 20u;
+
     bool GameEngine::Initialize( int argc, U8Char* argv[] )
     {
         GMainApplication = CreateApplication( argc, argv );
@@ -38,7 +43,9 @@ namespace EE
         GDynamicRHI = PlatformCreateDynamicRHI( GMainApplication->GetPreferedRHI() );
         GInput = PlatformCreateInput();
         GPlatformDevice = PlatformCreatePlatformDevice();
+        JobSystem::Initialize();
         GPhysicsEngine = CreatePhysicsEngine();
+        Memory::GFrameArena = new Memory::FrameArena( kFrameArenaSize, 2 );
 
 #ifdef EE_PLATFORM_CUDA
         CUDA::FindCudaDevice();
@@ -75,6 +82,9 @@ namespace EE
         delete GInput;
         delete GMainApplication;
         delete GPhysicsEngine;
+        JobSystem::Exit();
+        delete Memory::GFrameArena;
+        Memory::GFrameArena = NULL;
 
         SDL_Quit();
     }
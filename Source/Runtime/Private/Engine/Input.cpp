@@ -50,10 +50,9 @@ namespace EE
     {
         if ( index == -1 )
         {
-            TArray<int> Indices;
-            Indices = GetJoysticksConnected();
-            if ( Indices.empty() ) index = 0;
-            else index = Indices[ 0 ];
+            const TInlineArray<int, EE_MAX_GAMEPAD_COUNT> indices = GetJoysticksConnected();
+            if ( indices.empty() ) index = 0;
+            else index = indices[ 0 ];
         }
 
         if ( frame != UINT64_MAX && frame != GGamepadButtonStates[ index ][ button ].frameDown )
@@ -65,8 +64,7 @@ namespace EE
     {
         if ( index == -1 )
         {
-            TArray<int> indices;
-            indices = GetJoysticksConnected();
+            const TInlineArray<int, EE_MAX_GAMEPAD_COUNT> indices = GetJoysticksConnected();
             if ( indices.empty() ) index = 0;
             else index = indices[ 0 ];
         }
@@ -81,16 +79,16 @@ namespace EE
 
     bool Input::GetJoystickState( int index, const JoystickState** state )
     {
-        *state = &GJoystickDeviceStates[ index ];
-        return (*state)->instanceID;
+        if ( state != NULL )
+            *state = &GJoystickDeviceStates[ index ];
+        return GJoystickDeviceStates[ index ].instanceID;
     }
 
     void Input::SendHapticImpulse( int index, int channel, float amplitude, int duration )
     {
         if ( index == -1 )
         {
-            TArray<int> indices;
-            indices = GetJoysticksConnected();
+            const TInlineArray<int, EE_MAX_GAMEPAD_COUNT> indices = GetJoysticksConnected();
             if ( indices.empty() ) index = 0;
             else index = indices[ 0 ];
         }
@@ -99,9 +97,9 @@ namespace EE
             SDL_PlayHapticRumble( (SDL_Haptic*)joystick->hapticDevice, amplitude, duration );
     }
 
-    TArray<int> Input::GetJoysticksConnected()
+    TInlineArray<int, EE_MAX_GAMEPAD_COUNT> Input::GetJoysticksConnected()
     {
-        TArray<int> indices; int count = 0;
+        TInlineArray<int, EE_MAX_GAMEPAD_COUNT> indices; int count = 0;
         for ( int i = 0; i < EE_MAX_GAMEPAD_COUNT; i++ )
         {
             if ( GetJoystickState( i, NULL ) )
@@ -116,20 +116,14 @@ namespace EE
         return str;
     }
 
-    TArray<char> FileManager::ReadBinaryStream( const File* file )
+    MappedFileView FileManager::ReadBinaryStream( const File* file )
     {
-        FileStream<U8String> stream( *file );
-        TArray<char> buffer;
-        if ( stream.Open( std::ios::ate | std::ios::binary | std::ios::in, false ) )
+        MappedFileView view( *file, MappedFileHint_Sequential );
+        if ( view.GetError() != 0 )
         {
-            size_t fileSize = stream.GetPosition();
-            buffer.resize( fileSize );
-
-            stream.MoveCursor( 0 );
-            stream.ReadStream( buffer.data(), fileSize );
-            stream.Close();
+            EE_LOG_ERROR( "Error mapping file '{}', returned code {}", file->GetPath(), view.GetError() );
         }
-        return buffer;
+        return view;
     }
 }
 
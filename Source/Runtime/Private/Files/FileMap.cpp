@@ -1,4 +1,3 @@
-
 #include "CoreMinimal.h"
 
 #include "Utils/TextFormatting.h"
@@ -7,41 +6,362 @@
 #include "Platform/PrePlatform.h"
 #include "Platform/Platform.h"
 
+#if defined(__APPLE__) || defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+#if defined(__linux__)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#endif
+
 namespace EE
 {
+    enum EFileReadState : int32
+    {
+        FileReadState_Free,
+        FileReadState_Pending,
+        FileReadState_Done,
+    };
+
+    struct FileReadRequest
+    {
+        uint64 offset;
+        uint64 size;
+        void* buffer;
+        uint64 bytesRead;
+        int error;
 #ifdef _WIN32
+        OVERLAPPED overlapped;
+        HANDLE readEvent;
+        EFileReadState state;
+#elif defined(__APPLE__) || defined(__linux__)
+        int file;
+        std::atomic<int32> state;
+#endif
+#if defined(__linux__)
+        iovec vector;
+        //* Submitted to the io_uring, the slot stays busy until its completion is reaped
+        bool inRing;
+#endif
+    };
+
+#if defined(__linux__)
+    // Minimal io_uring setup over the raw syscalls, one ring per file sized to FileMap::MaxRequests
+    struct IOUring
+    {
+        int ring;
+        void* sqMemory;
+        size_t sqMemorySize;
+        void* cqMemory;
+        size_t cqMemorySize;
+        io_uring_sqe* sqes;
+        size_t sqesSize;
+        uint32* sqHead;
+        uint32* sqTail;
+        uint32* sqMask;
+        uint32* sqArray;
+        uint32* cqHead;
+        uint32* cqTail;
+        uint32* cqMask;
+        io_uring_cqe* cqes;
+    };
+
+    static void DestroyIOUring( IOUring* uring )
+    {
+        if ( uring->sqes != NULL ) munmap( uring->sqes, uring->sqesSize );
+        if ( uring->cqMemory != NULL && uring->cqMemory != uring->sqMemory ) munmap( uring->cqMemory, uring->cqMemorySize );
+        if ( uring->sqMemory != NULL ) munmap( uring->sqMemory, uring->sqMemorySize );
+        close( uring->ring );
+        delete uring;
+    }
+
+    //* Returns NULL when io_uring is not available (old kernel, seccomp, memlock limits)
+    static IOUring* CreateIOUring( uint32 entries )
+    {
+        io_uring_params params{};
+        int ring = (int)syscall( __NR_io_uring_setup, entries, &params );
+        if ( ring < 0 )
+            return NULL;
+
+        IOUring* uring = new IOUring{};
+        uring->ring = ring;
+        uring->sqMemorySize = params.sq_off.array + params.sq_entries * sizeof( uint32 );
+        uring->cqMemorySize = params.cq_off.cqes + params.cq_entries * sizeof( io_uring_cqe );
+        if ( params.features & IORING_FEAT_SINGLE_MMAP )
+            uring->sqMemorySize = uring->cqMemorySize = std::max( uring->sqMemorySize, uring->cqMemorySize );
+
+        void* sqMemory = mmap( NULL, uring->sqMemorySize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring, IORING_OFF_SQ_RING );
+        if ( sqMemory == MAP_FAILED )
+        {
+            DestroyIOUring( uring );
+            return NULL;
+        }
+        uring->sqMemory = sqMemory;
+
+        void* cqMemory = sqMemory;
+        if ( (params.features & IORING_FEAT_SINGLE_MMAP) == 0 )
+        {
+            cqMemory = mmap( NULL, uring->cqMemorySize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring, IORING_OFF_CQ_RING );
+            if ( cqMemory == MAP_FAILED )
+            {
+                DestroyIOUring( uring );
+                return NULL;
+            }
+        }
+        uring->cqMemory = cqMemory;
+
+        uring->sqesSize = params.sq_entries * sizeof( io_uring_sqe );
+        void* sqes = mmap( NULL, uring->sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring, IORING_OFF_SQES );
+        if ( sqes == MAP_FAILED )
+        {
+            DestroyIOUring( uring );
+            return NULL;
+        }
+        uring->sqes = static_cast<io_uring_sqe*>( sqes );
+
+        uint8* sq = static_cast<uint8*>( sqMemory );
+        uring->sqHead = reinterpret_cast<uint32*>( sq + params.sq_off.head );
+        uring->sqTail = reinterpret_cast<uint32*>( sq + params.sq_off.tail );
+        uring->sqMask = reinterpret_cast<uint32*>( sq + params.sq_off.ring_mask );
+        uring->sqArray = reinterpret_cast<uint32*>( sq + params.sq_off.array );
+
+        uint8* cq = static_cast<uint8*>( cqMemory );
+        uring->cqHead = reinterpret_cast<uint32*>( cq + params.cq_off.head );
+        uring->cqTail = reinterpret_cast<uint32*>( cq + params.cq_off.tail );
+        uring->cqMask = reinterpret_cast<uint32*>( cq + params.cq_off.ring_mask );
+        uring->cqes = reinterpret_cast<io_uring_cqe*>( cq + params.cq_off.cqes );
+        return uring;
+    }
+
+    // Completions with this user data belong to cancellations, not to read requests
+    static constexpr uint64 IOUringCancelUserData = ~0ull;
+
+    //* Returns an error when the entry never reached the kernel, the submission queue is then left as it was
+    static int SubmitIOUring( IOUring* uring, const io_uring_sqe& entry )
+    {
+        const uint32 tail = *uring->sqTail;
+        const uint32 index = tail & *uring->sqMask;
+        uring->sqes[ index ] = entry;
+        uring->sqArray[ index ] = index;
+        __atomic_store_n( uring->sqTail, tail + 1, __ATOMIC_RELEASE );
+
+        int error = 0;
+        while ( syscall( __NR_io_uring_enter, uring->ring, 1, 0, 0, NULL, 0 ) < 0 )
+        {
+            if ( errno != EINTR )
+            {
+                error = errno;
+                break;
+            }
+        }
+
+        // The kernel only takes entries inside io_uring_enter, one it didn't take can be withdrawn.
+        // One it took is in flight even if the call failed and its completion will come
+        if ( __atomic_load_n( uring->sqHead, __ATOMIC_ACQUIRE ) != tail + 1 )
+        {
+            __atomic_store_n( uring->sqTail, tail, __ATOMIC_RELEASE );
+            return error != 0 ? error : EAGAIN;
+        }
+        return 0;
+    }
+
+    static int SubmitIOUringRead( IOUring* uring, FileReadRequest* request, uint64 userData )
+    {
+        io_uring_sqe sqe{};
+        sqe.opcode = IORING_OP_READV;
+        sqe.fd = request->file;
+        sqe.addr = (uint64)(uintptr_t)&request->vector;
+        sqe.len = 1;
+        sqe.off = request->offset;
+        sqe.user_data = userData;
+        return SubmitIOUring( uring, sqe );
+    }
+
+    //* Asks the kernel to finish a read early, its completion still has to be reaped
+    static void CancelIOUringRead( IOUring* uring, uint64 userData )
+    {
+        io_uring_sqe sqe{};
+        sqe.opcode = IORING_OP_ASYNC_CANCEL;
+        sqe.fd = -1;
+        sqe.addr = userData;
+        sqe.user_data = IOUringCancelUserData;
+        SubmitIOUring( uring, sqe );
+    }
+
+    //* Moves finished completions into their requests, blocks for one if wait is set and none is ready
+    static int ReapIOUring( IOUring* uring, FileReadRequest* requests, bool wait )
+    {
+        while ( true )
+        {
+            uint32 head = *uring->cqHead;
+            const uint32 tail = __atomic_load_n( uring->cqTail, __ATOMIC_ACQUIRE );
+            if ( head != tail )
+            {
+                for ( ; head != tail; ++head )
+                {
+                    const io_uring_cqe& cqe = uring->cqes[ head & *uring->cqMask ];
+                    if ( cqe.user_data == IOUringCancelUserData )
+                        continue;
+                    FileReadRequest& request = requests[ cqe.user_data ];
+                    request.error = cqe.res < 0 ? -cqe.res : 0;
+                    request.bytesRead = cqe.res < 0 ? 0 : (uint64)cqe.res;
+                    request.state.store( FileReadState_Done, std::memory_order_release );
+                }
+                __atomic_store_n( uring->cqHead, head, __ATOMIC_RELEASE );
+                return 0;
+            }
+
+            if ( wait == false )
+                return 0;
+
+            if ( syscall( __NR_io_uring_enter, uring->ring, 0, 1, IORING_ENTER_GETEVENTS, NULL, 0 ) < 0 && errno != EINTR )
+                return errno;
+        }
+    }
+#endif
+
+#if defined(__APPLE__) || defined(__linux__)
+    // Fallback when the kernel has no asynchronous file reads, blocking preads run on a few workers
+    class FileReadThreadPool
+    {
+    public:
+        FileReadThreadPool()
+        {
+            const uint32 threadCount = std::clamp( std::thread::hardware_concurrency() / 2, 1u, 4u );
+            for ( uint32 i = 0; i < threadCount; i++ )
+                _threads.emplace_back( &FileReadThreadPool::WorkerLoop, this );
+        }
+
+        ~FileReadThreadPool()
+        {
+            {
+                std::unique_lock<std::mutex> lock( _lock );
+                _stop = true;
+            }
+            _condition.notify_all();
+            for ( std::thread& thread : _threads )
+                thread.join();
+        }
+
+        void Push( FileReadRequest* request )
+        {
+            {
+                std::unique_lock<std::mutex> lock( _lock );
+                _queue.push( request );
+            }
+            _condition.notify_one();
+        }
+
+        void Wait( FileReadRequest* request )
+        {
+            std::unique_lock<std::mutex> lock( _doneLock );
+            _doneCondition.wait( lock, [ request ] { return request->state.load( std::memory_order_acquire ) != FileReadState_Pending; } );
+        }
+
+        static FileReadThreadPool& Get()
+        {
+            static FileReadThreadPool pool;
+            return pool;
+        }
+
+    private:
+        void WorkerLoop()
+        {
+            while ( true )
+            {
+                FileReadRequest* request;
+                {
+                    std::unique_lock<std::mutex> lock( _lock );
+                    _condition.wait( lock, [ this ] { return _stop || _queue.empty() == false; } );
+                    if ( _queue.empty() )
+                        return;
+                    request = _queue.front();
+                    _queue.pop();
+                }
+
+                auto result = pread( request->file, request->buffer, request->size, (off_t)request->offset );
+                request->error = result < 0 ? errno : 0;
+                request->bytesRead = result < 0 ? 0 : (uint64)result;
+                {
+                    // The request may be released as soon as the waiter sees it done, so it's not touched after this
+                    std::unique_lock<std::mutex> lock( _doneLock );
+                    request->state.store( FileReadState_Done, std::memory_order_release );
+                }
+                _doneCondition.notify_all();
+            }
+        }
+
+        TArray<std::thread> _threads;
+        TQueue<FileReadRequest*> _queue;
+        std::mutex _lock;
+        std::condition_variable _condition;
+        std::mutex _doneLock;
+        std::condition_variable _doneCondition;
+        bool _stop = false;
+    };
+#endif
+
     struct FileHandle
     {
+#ifdef _WIN32
         HANDLE file;
-        HANDLE readEvent;
-        OVERLAPPED overlapped;
-    };
+#elif defined(__APPLE__) || defined(__linux__)
+        int file;
 #endif
+#if defined(__linux__)
+        IOUring* uring;
+#endif
+        FileReadRequest requests[ FileMap::MaxRequests ];
+    };
 
     FORCEINLINE void CloseFileMap( void** handle )
     {
-#ifdef _WIN32
         FileHandle* fileHandle = static_cast<FileHandle*>( *handle );
+        if ( fileHandle == NULL )
+            return;
+
+#ifdef _WIN32
         if ( fileHandle->file != INVALID_HANDLE_VALUE )
         {
             CloseHandle( fileHandle->file );
-            CloseHandle( fileHandle->readEvent );
-            delete fileHandle;
+        }
+        for ( FileReadRequest& request : fileHandle->requests )
+        {
+            if ( request.readEvent != NULL )
+                CloseHandle( request.readEvent );
         }
 #elif defined(__APPLE__) || defined(__linux__)
-        int handlePtr = (int)(uintptr_t)(*handle);
-        if ( handlePtr != -1 )
+        if ( fileHandle->file != -1 )
+        {
+            close( fileHandle->file );
+        }
+#endif
+#if defined(__linux__)
+        if ( fileHandle->uring != NULL )
         {
-            close( handlePtr );
+            DestroyIOUring( fileHandle->uring );
         }
 #endif
+        delete fileHandle;
+        *handle = NULL;
     }
 
-    FORCEINLINE int OpenFileMap( const File& filePath, void** handle, uint64* outSize )
+    FORCEINLINE int OpenFileMap( const File& filePath, bool* directIO, void** handle, uint64* outSize )
     {
+        FileHandle* fileHandle = new FileHandle{};
+        *handle = fileHandle;
 #ifdef _WIN32
-        *handle = new FileHandle();
-        FileHandle* fileHandle = static_cast<FileHandle*>( *handle );
         WString pathW = Text::UTF8ToWide( filePath.GetPath().c_str() );
         fileHandle->file = CreateFileW(
             pathW.c_str(),
@@ -60,21 +380,24 @@ namespace EE
         LARGE_INTEGER size{};
         if ( !GetFileSizeEx( fileHandle->file, &size ) )
         {
-            int error = static_cast<int>(GetLastError());
-            CloseFileMap( handle );
-            return error;
+            return static_cast<int>(GetLastError());
         }
 
-        fileHandle->readEvent = CreateEventA( nullptr, FALSE, FALSE, nullptr );
-
-        if ( fileHandle->readEvent == INVALID_HANDLE_VALUE )
+        for ( FileReadRequest& request : fileHandle->requests )
         {
-            return static_cast<int>(GetLastError());
+            request.readEvent = CreateEventA( nullptr, TRUE, FALSE, nullptr );
+            if ( request.readEvent == NULL )
+            {
+                return static_cast<int>(GetLastError());
+            }
         }
 
+        // Unbuffered reads are always used on Windows
+        *directIO = true;
         *outSize = size.QuadPart;
 #elif defined(__APPLE__) || defined(__linux__)
         const U8String& path = filePath.GetPath();
+        fileHandle->file = -1;
 
         struct stat info;
         if ( -1 == stat( path.c_str(), &info ) )
@@ -84,160 +407,251 @@ namespace EE
 
         *outSize = info.st_size;
 
-        int handlePtr = open( path.c_str(), O_RDONLY );
+        int flags = O_RDONLY;
+#if defined(__linux__)
+        if ( *directIO )
+            flags |= O_DIRECT;
+#endif
+        fileHandle->file = open( path.c_str(), flags );
+
+        // Some file systems (tmpfs, network mounts) reject O_DIRECT, read through the cache instead
+        if ( -1 == fileHandle->file && *directIO && errno == EINVAL )
+        {
+            *directIO = false;
+            fileHandle->file = open( path.c_str(), O_RDONLY );
+        }
 
-        if ( -1 == handlePtr )
+        if ( -1 == fileHandle->file )
         {
             return errno;
         }
 
-        *handle = (void*)(uintptr_t)(handlePtr);
+#if defined(__APPLE__)
+        if ( *directIO )
+            fcntl( fileHandle->file, F_NOCACHE, 1 );
+#endif
+#if defined(__linux__)
+        fileHandle->uring = CreateIOUring( FileMap::MaxRequests );
+#endif
 #endif
         return 0;
     }
 
     FORCEINLINE bool FileMapHandleValid( void* handle )
     {
-#ifdef _WIN32
         FileHandle* fileHandle = static_cast<FileHandle*>( handle );
-        return fileHandle->file != nullptr && fileHandle->file != INVALID_HANDLE_VALUE &&
-               fileHandle->readEvent != nullptr && fileHandle->readEvent != INVALID_HANDLE_VALUE;
+        if ( fileHandle == NULL )
+            return false;
+#ifdef _WIN32
+        return fileHandle->file != nullptr && fileHandle->file != INVALID_HANDLE_VALUE;
 #elif defined(__APPLE__) || defined(__linux__)
-        int handlePtr = (int)(uintptr_t)(handle);
-        return handlePtr != -1;
+        return fileHandle->file != -1;
 #endif
         return false;
     }
 
-    int FileMap::ReadBlock( uint64 offset, uint64 size, void* buffer )
+    int FileMap::SubmitRead( uint64 offset, uint64 size, void* buffer, uint32* outRequest )
     {
-#ifdef _WIN32
+        EE_ASSERT( buffer );
         EE_ASSERT( FileMapHandleValid( _handle ) );
+        EE_ASSERT( _directIO == false || (std::uintptr_t( buffer ) % 4096 == 0 && offset % 4096 == 0 && size % 4096 == 0) );
+
+        FileHandle* fileHandle = static_cast<FileHandle*>( _handle );
+
+        uint32 index = 0;
+        for ( ; index < MaxRequests; index++ )
+        {
+            if ( fileHandle->requests[ index ].state == FileReadState_Free )
+                break;
+        }
+
+        if ( index == MaxRequests )
+        {
+#ifdef _WIN32
+            return _error = ERROR_BUSY;
+#else
+            return _error = EBUSY;
+#endif
+        }
+
+        FileReadRequest& request = fileHandle->requests[ index ];
+        request.offset = offset;
+        request.size = size;
+        request.buffer = buffer;
+        request.bytesRead = 0;
+        request.error = 0;
+        request.state = FileReadState_Pending;
 
         ++_requestCount;
+        ++_pendingCount;
+        *outRequest = index;
 
-        FileHandle* fileHandle = static_cast<FileHandle*>(_handle);
-        fileHandle->overlapped.hEvent = fileHandle->readEvent;
-        fileHandle->overlapped.Offset = static_cast<DWORD>(offset);
-        fileHandle->overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+#ifdef _WIN32
+        ResetEvent( request.readEvent );
+        request.overlapped = OVERLAPPED{};
+        request.overlapped.hEvent = request.readEvent;
+        request.overlapped.Offset = static_cast<DWORD>(offset);
+        request.overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
 
-        _offset = static_cast<DWORD>(offset);
-        _size = static_cast<DWORD>(size);
-        _buffer = buffer;
-        bool success = ReadFile( fileHandle->file, _buffer, static_cast<DWORD>(size), nullptr, &fileHandle->overlapped );
+        bool success = ReadFile( fileHandle->file, buffer, static_cast<DWORD>(size), nullptr, &request.overlapped );
 
         if ( !success )
         {
             if ( DWORD ec = GetLastError(); ec != ERROR_IO_PENDING )
             {
-                return _error = static_cast<int>(ec);
+                request.error = static_cast<int>(ec);
+                request.state = FileReadState_Done;
+                return _error = request.error;
             }
         }
-#elif defined( __linux__ )
-        EE_ASSERT( _buffer );
-        EE_ASSERT( FileMapHandleValid( _handle ) );
-        EE_ASSERT( std::uintptr_t( _buffer ) % 4096 == 0 );
-
-        ++_requestCount;
-
-        _offset = offset;
-        _size = size;
-        _buffer = buffer;
-
-        auto result = readahead( (int)(uintptr_t)_handle, _offset, _size );
-        if ( result == -1 )
+#elif defined(__APPLE__) || defined(__linux__)
+        request.file = fileHandle->file;
+#if defined(__linux__)
+        request.inRing = false;
+        if ( fileHandle->uring != NULL )
         {
-            return _error = errno;
+            EE_ASSERT( size <= UINT32_MAX );
+            request.vector.iov_base = buffer;
+            request.vector.iov_len = size;
+            // A read the ring didn't take goes to the blocking readers below
+            request.inRing = SubmitIOUringRead( fileHandle->uring, &request, index ) == 0;
+            if ( request.inRing )
+                return 0;
         }
-#elif defined( __APPLE__ )
-        EE_ASSERT( _buffer );
-        EE_ASSERT( FileMapHandleValid( _handle ) );
-        EE_ASSERT( std::uintptr_t( _buffer ) % 4096 == 0 );
-
-        ++m_num_requests;
+#endif
+        FileReadThreadPool::Get().Push( &request );
+#endif
 
-        _offset = offset;
-        _size = size;
-        _buffer = buffer;
+        return 0;
+    }
 
-        radvisory args{};
-        args.ra_offset = static_cast<off_t>(_offset);
-        args.ra_count = static_cast<int>(_size);
+    bool FileMap::PollRead( uint32 requestIndex )
+    {
+        EE_ASSERT( requestIndex < MaxRequests );
+        FileHandle* fileHandle = static_cast<FileHandle*>( _handle );
+        FileReadRequest& request = fileHandle->requests[ requestIndex ];
+        EE_ASSERT( request.state != FileReadState_Free, "Polling a request that was not submitted" );
 
-        auto result = fcntl( (int)(uintptr_t)_handle, F_RDADVISE, &args );
-        if ( result == -1 )
+#ifdef _WIN32
+        if ( request.state == FileReadState_Pending )
         {
-            return _error = errno;
+            DWORD bytesRead = DWORD{};
+            if ( GetOverlappedResult( fileHandle->file, &request.overlapped, &bytesRead, FALSE ) )
+            {
+                request.bytesRead = bytesRead;
+                request.state = FileReadState_Done;
+            }
+            else if ( DWORD ec = GetLastError(); ec != ERROR_IO_INCOMPLETE )
+            {
+                request.error = ec == ERROR_HANDLE_EOF ? 0 : static_cast<int>(ec);
+                request.state = FileReadState_Done;
+            }
         }
+        return request.state == FileReadState_Done;
+#elif defined(__APPLE__) || defined(__linux__)
+#if defined(__linux__)
+        if ( request.inRing && request.state.load( std::memory_order_acquire ) == FileReadState_Pending )
+            ReapIOUring( fileHandle->uring, fileHandle->requests, false );
+#endif
+        return request.state.load( std::memory_order_acquire ) == FileReadState_Done;
 #endif
-
-        return 0;
     }
 
-    int FileMap::WaitForResult( uint64* outBytesRead )
+    int FileMap::WaitForRead( uint32 requestIndex, uint64* outBytesRead )
     {
-#ifdef _WIN32
-        EE_ASSERT( FileMapHandleValid( _handle ) );
-
-        FileHandle* fileHandle = static_cast<FileHandle*>(_handle);
+        EE_ASSERT( requestIndex < MaxRequests );
+        FileHandle* fileHandle = static_cast<FileHandle*>( _handle );
+        FileReadRequest& request = fileHandle->requests[ requestIndex ];
+        EE_ASSERT( request.state != FileReadState_Free, "Waiting a request that was not submitted" );
 
-        DWORD bytesRead = DWORD{};
-        bool success = GetOverlappedResult( _handle, &fileHandle->overlapped, &bytesRead, TRUE );
-
-        if ( !success )
+#ifdef _WIN32
+        if ( request.state == FileReadState_Pending )
         {
-            if ( DWORD ec = GetLastError(); ec != ERROR_HANDLE_EOF )
+            DWORD bytesRead = DWORD{};
+            if ( GetOverlappedResult( fileHandle->file, &request.overlapped, &bytesRead, TRUE ) )
             {
-                *outBytesRead = 0;
-                return _error = static_cast<int>(ec);
+                request.bytesRead = bytesRead;
+            }
+            else if ( DWORD ec = GetLastError(); ec != ERROR_HANDLE_EOF )
+            {
+                request.error = static_cast<int>(ec);
             }
         }
-
-        _bytesRead += bytesRead;
-        *outBytesRead = bytesRead;
-#elif defined( __linux__ )
-        auto result = pread64( (int)(uintptr_t)_handle, _buffer, _size, _offset );
-
-        if ( result < 0 )
+#elif defined(__APPLE__) || defined(__linux__)
+#if defined(__linux__)
+        if ( request.inRing )
         {
-            *outBytesRead = 0;
-            return _error = errno;
+            bool canBlock = true;
+            while ( request.state.load( std::memory_order_acquire ) == FileReadState_Pending )
+            {
+                // The kernel may still be writing into the buffer, so the slot stays busy until its own completion
+                // shows up. The read is cancelled to make that quick and the queue is polled without blocking
+                if ( canBlock && ReapIOUring( fileHandle->uring, fileHandle->requests, true ) != 0 )
+                {
+                    CancelIOUringRead( fileHandle->uring, requestIndex );
+                    canBlock = false;
+                }
+                else if ( canBlock == false )
+                {
+                    std::this_thread::yield();
+                    ReapIOUring( fileHandle->uring, fileHandle->requests, false );
+                }
+            }
         }
+#endif
+        if ( request.state.load( std::memory_order_acquire ) == FileReadState_Pending )
+            FileReadThreadPool::Get().Wait( &request );
+#endif
 
-        auto bytesRead = static_cast<size_t>(result);
-
-        _bytesRead += bytesRead;
-        *outBytesRead = bytesRead;
-#elif defined( __APPLE__ )
-        auto result = pread( (int)(uintptr_t)_handle, _buffer, _size, _offset );
+        const uint64 bytesRead = request.bytesRead;
+        const int error = request.error;
+        request.state = FileReadState_Free;
+        --_pendingCount;
 
-        if ( result < 0 )
+        if ( error != 0 )
         {
             *outBytesRead = 0;
-            return _error = errno;
+            return _error = error;
         }
 
-        const size_t& bytesRead = static_cast<size_t>(result);
-
         _bytesRead += bytesRead;
         *outBytesRead = bytesRead;
-#endif
-
         return 0;
     }
 
-    FileMap::FileMap( const File& filePath ) : File( filePath ),
-        _handle{}, _size{}, _error{}
+    int FileMap::ReadBlock( uint64 offset, uint64 size, void* buffer )
+    {
+        return SubmitRead( offset, size, buffer, &_lastRequest );
+    }
+
+    int FileMap::WaitForResult( uint64* outBytesRead )
+    {
+        return WaitForRead( _lastRequest, outBytesRead );
+    }
+
+    FileMap::FileMap( const File& filePath, bool directIO ) : File( filePath ),
+        _handle{}, _size{}, _error{}, _directIO{ directIO }
     {
-        _error = OpenFileMap( filePath, &_handle, &_size );
+        _error = OpenFileMap( filePath, &_directIO, &_handle, &_size );
     }
 
     FileMap::~FileMap() noexcept
     {
+        // Buffers belong to the caller, every read must land before the handle goes away
+        if ( FileMapHandleValid( _handle ) )
+        {
+            FileHandle* fileHandle = static_cast<FileHandle*>( _handle );
+            for ( uint32 i = 0; i < MaxRequests; i++ )
+            {
+                uint64 bytesRead;
+                if ( fileHandle->requests[ i ].state != FileReadState_Free )
+                    WaitForRead( i, &bytesRead );
+            }
+        }
         CloseFileMap( &_handle );
     }
 
     FileMap::operator bool() const { return FileMapHandleValid( _handle ); }
 }
 
-#include "Platform/PostPlatform.h"
\ No newline at end of file
+#include "Platform/PostPlatform.h"
@@ -0,0 +1,175 @@
+#include "CoreMinimal.h"
+
+#include "Utils/TextFormatting.h"
+#include "Files/FileManager.h"
+#include "Files/MappedFileView.h"
+
+#include "Platform/PrePlatform.h"
+#include "Platform/Platform.h"
+
+#if defined(__APPLE__) || defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace EE
+{
+    // Below this size transparent huge pages are not worth asking for
+    constexpr uint64 kMappedFileHugePageSize = 2u << 20u;
+
+    MappedFileView::MappedFileView() : _data( NULL ), _size( 0 ), _error( 0 )
+    {
+    }
+
+    MappedFileView::MappedFileView( const File& file, EMappedFileHint hint ) : _data( NULL ), _size( 0 ), _error( 0 )
+    {
+#ifdef _WIN32
+        WString pathW = Text::UTF8ToWide( file.GetPath().c_str() );
+        HANDLE fileHandle = CreateFileW(
+            pathW.c_str(),
+            GENERIC_READ,
+            FILE_SHARE_READ,
+            nullptr,
+            OPEN_EXISTING,
+            FILE_ATTRIBUTE_READONLY | (hint == MappedFileHint_Sequential ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_FLAG_RANDOM_ACCESS),
+            nullptr );
+
+        if ( fileHandle == INVALID_HANDLE_VALUE )
+        {
+            _error = static_cast<int>(GetLastError());
+            return;
+        }
+
+        LARGE_INTEGER size{};
+        if ( !GetFileSizeEx( fileHandle, &size ) )
+        {
+            _error = static_cast<int>(GetLastError());
+            CloseHandle( fileHandle );
+            return;
+        }
+
+        _size = size.QuadPart;
+        if ( _size == 0 )
+        {
+            CloseHandle( fileHandle );
+            return;
+        }
+
+        HANDLE mapping = CreateFileMappingW( fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr );
+        if ( mapping == NULL )
+        {
+            _error = static_cast<int>(GetLastError());
+            _size = 0;
+            CloseHandle( fileHandle );
+            return;
+        }
+
+        // The view keeps the mapping and the file alive
+        _data = static_cast<const uint8*>( MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 ) );
+        if ( _data == NULL )
+        {
+            _error = static_cast<int>(GetLastError());
+            _size = 0;
+        }
+        CloseHandle( mapping );
+        CloseHandle( fileHandle );
+
+        if ( _data != NULL && hint == MappedFileHint_Sequential )
+        {
+            WIN32_MEMORY_RANGE_ENTRY range{ const_cast<uint8*>( _data ), (SIZE_T)_size };
+            PrefetchVirtualMemory( GetCurrentProcess(), 1, &range, 0 );
+        }
+#elif defined(__APPLE__) || defined(__linux__)
+        int fileHandle = open( file.GetPath().c_str(), O_RDONLY );
+        if ( fileHandle == -1 )
+        {
+            _error = errno;
+            return;
+        }
+
+        struct stat info;
+        if ( fstat( fileHandle, &info ) == -1 )
+        {
+            _error = errno;
+            close( fileHandle );
+            return;
+        }
+
+        _size = (uint64)info.st_size;
+        if ( _size == 0 )
+        {
+            close( fileHandle );
+            return;
+        }
+
+        void* data = mmap( NULL, (size_t)_size, PROT_READ, MAP_PRIVATE, fileHandle, 0 );
+        close( fileHandle );
+        if ( data == MAP_FAILED )
+        {
+            _error = errno;
+            _size = 0;
+            return;
+        }
+        _data = static_cast<const uint8*>( data );
+
+        if ( hint == MappedFileHint_Sequential )
+        {
+            madvise( data, (size_t)_size, MADV_SEQUENTIAL );
+            madvise( data, (size_t)_size, MADV_WILLNEED );
+        }
+        else
+        {
+            madvise( data, (size_t)_size, MADV_RANDOM );
+        }
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+        // Only honored by file systems with read only THP support, ignored otherwise
+        if ( _size >= kMappedFileHugePageSize )
+            madvise( data, (size_t)_size, MADV_HUGEPAGE );
+#endif
+#endif
+    }
+
+    MappedFileView::MappedFileView( MappedFileView&& other ) noexcept : _data( other._data ), _size( other._size ), _error( other._error )
+    {
+        other._data = NULL;
+        other._size = 0;
+    }
+
+    MappedFileView& MappedFileView::operator=( MappedFileView&& other ) noexcept
+    {
+        if ( this != &other )
+        {
+            Unmap();
+            _data = other._data;
+            _size = other._size;
+            _error = other._error;
+            other._data = NULL;
+            other._size = 0;
+        }
+        return *this;
+    }
+
+    MappedFileView::~MappedFileView()
+    {
+        Unmap();
+    }
+
+    void MappedFileView::Unmap()
+    {
+        if ( _data != NULL )
+        {
+#ifdef _WIN32
+            UnmapViewOfFile( _data );
+#elif defined(__APPLE__) || defined(__linux__)
+            munmap( const_cast<uint8*>( _data ), (size_t)_size );
+#endif
+        }
+        _data = NULL;
+        _size = 0;
+    }
+}
+
+#include "Platform/PostPlatform.h"
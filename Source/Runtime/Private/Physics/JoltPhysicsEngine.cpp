@@ -4,6 +4,8 @@
 #include <Core/Log.h>
 #include <Math/CoreMath.h>
 #include <Utils/TextFormatting.h>
+#include <Utils/Memory.h>
+#include <Core/JobSystem.h>
 
 #include <Physics/PhysicsEngine.h>
 #include <Physics/JoltPhysics.h>
@@ -26,6 +28,56 @@ namespace EE
         }
     }
 
+    // Runs the physics jobs on the engine job system instead of a thread pool of its own,
+    // barriers come from Jolt and execute the jobs of the step while the simulation waits on them
+    class JoltJobSystem final : public JPH::JobSystemWithBarrier
+    {
+    public:
+        JoltJobSystem( uint32 maxBarriers ) : JPH::JobSystemWithBarrier( maxBarriers ), _jobPool( Memory::MemoryTag_Physics )
+        {
+        }
+
+        int GetMaxConcurrency() const override
+        {
+            return (int)EE::JobSystem::GetWorkerCount() + 1;
+        }
+
+        JobHandle CreateJob( const char* name, JPH::ColorArg color, const JobFunction& function, JPH::uint32 dependencyCount ) override
+        {
+            Job* job = _jobPool.Acquire( name, color, this, function, dependencyCount );
+            JobHandle handle( job );
+            if ( dependencyCount == 0 )
+                QueueJob( job );
+            return handle;
+        }
+
+    protected:
+        void QueueJob( Job* job ) override
+        {
+            // Held until it ran, the last reference frees it through FreeJob
+            job->AddRef();
+            EE::JobSystem::Run( [ job ]
+            {
+                job->Execute();
+                job->Release();
+            } );
+        }
+
+        void QueueJobs( Job** jobs, JPH::uint jobCount ) override
+        {
+            for ( JPH::uint i = 0; i < jobCount; i++ )
+                QueueJob( jobs[ i ] );
+        }
+
+        void FreeJob( Job* job ) override
+        {
+            _jobPool.Release( job );
+        }
+
+    private:
+        Memory::TPool<Job, true> _jobPool;
+    };
+
     // Callback for traces, connect this to your own trace function if you have one
     static void CallbackTrace( const char* inFMT, ... )
     {
@@ -200,28 +252,21 @@ namespace EE
     };
 
     JoltPhysicsShapeSphere::JoltPhysicsShapeSphere( const PhysicsShapeSphereCreateInfo& createInfo ) : PhysicsShapeSphere( createInfo )
-        , _shape( NULL )
-    {
-        _shape = new JPH::SphereShape( _radius );
-    }
-
-    JoltPhysicsShapeSphere::~JoltPhysicsShapeSphere()
+        , _shape( _radius )
     {
-        delete _shape;
+        _shape.SetEmbedded();
     }
 
     JoltPhysicsShapeBox::JoltPhysicsShapeBox( const PhysicsShapeBoxCreateInfo& createInfo ) : PhysicsShapeBox( createInfo )
-        , _shape( NULL )
-    {
-        _shape = new JPH::BoxShape( JPH::Vec3( extents_.x, extents_.y, extents_.z ) );
-    }
-
-    JoltPhysicsShapeBox::~JoltPhysicsShapeBox()
+        , _shape( JPH::Vec3( extents_.x, extents_.y, extents_.z ) )
     {
-        delete _shape;
+        _shape.SetEmbedded();
     }
 
     JoltPhysicsEngine::JoltPhysicsEngine()
+        : _boxShapePool( Memory::MemoryTag_Physics )
+        , _sphereShapePool( Memory::MemoryTag_Physics )
+        , _bodyPool( Memory::MemoryTag_Physics )
     {
         // Register allocation hook. In this example we'll just let Jolt use malloc / free but you can override these if you want (see Memory.h).
         // This needs to be done before any other Jolt function is called.
@@ -289,6 +334,11 @@ namespace EE
 
     JoltPhysicsEngine::~JoltPhysicsEngine()
     {
+        // Bodies leave the physics system and drop their shape references before anything is destroyed
+        _bodyPool.Clear();
+        _boxShapePool.Clear();
+        _sphereShapePool.Clear();
+
         // Unregisters all types with the factory and cleans up the default material
         JPH::UnregisterTypes();
 
@@ -326,10 +376,8 @@ namespace EE
         // malloc / free.
         static JPH::TempAllocatorImpl tempAllocator( 10 * 1024 * 1024 );
 
-        // We need a job system that will execute physics jobs on multiple threads. Typically
-        // you would implement the JobSystem interface yourself and let Jolt Physics run on top
-        // of your own job scheduler. JobSystemThreadPool is an example implementation.
-        static JPH::JobSystemThreadPool jobSystem( JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers, std::thread::hardware_concurrency() - 1 );
+        // Physics jobs share the engine workers with everything else
+        static JoltJobSystem jobSystem( JPH::cMaxPhysicsBarriers );
 
         // We simulate the physics world in discrete time steps. 60 Hz is a good rate to update the physics system.
         const float cDeltaTime = 1.0F / 60.0F;
@@ -350,17 +398,41 @@ namespace EE
 
     PhysicsShapeBox* JoltPhysicsEngine::CreateBoxShape( const PhysicsShapeBoxCreateInfo& createInfo )
     {
-        return new JoltPhysicsShapeBox( createInfo );
+        return _boxShapePool.Acquire( createInfo );
     }
 
     PhysicsShapeSphere* JoltPhysicsEngine::CreateSphereShape( const PhysicsShapeSphereCreateInfo& createInfo )
     {
-        return new JoltPhysicsShapeSphere( createInfo );
+        return _sphereShapePool.Acquire( createInfo );
     }
 
     PhysicsBody* JoltPhysicsEngine::CreateBody( const PhysicsBodyCreateInfo& createInfo )
     {
-        return new JoltPhysicsBody( createInfo, this );
+        return _bodyPool.Acquire( createInfo, this );
+    }
+
+    void JoltPhysicsEngine::DestroyShape( PhysicsShape* shape )
+    {
+        if ( shape == NULL )
+            return;
+
+        switch ( shape->shape )
+        {
+        case PhysicsShape_Box:
+            _boxShapePool.Release( static_cast<JoltPhysicsShapeBox*>(shape) );
+            break;
+        case PhysicsShape_Sphere:
+            _sphereShapePool.Release( static_cast<JoltPhysicsShapeSphere*>(shape) );
+            break;
+        default:
+            EE_LOG_ERROR( "[Jolt] Trying to destroy an unknown physics shape" );
+            break;
+        }
+    }
+
+    void JoltPhysicsEngine::DestroyBody( PhysicsBody* body )
+    {
+        _bodyPool.Release( static_cast<JoltPhysicsBody*>(body) );
     }
 
     JoltPhysicsBody::JoltPhysicsBody( const PhysicsBodyCreateInfo& createInfo, JoltPhysicsEngine* physicsEngine )
@@ -4,6 +4,7 @@
 #include <Core/Log.h>
 #include <Math/CoreMath.h>
 #include <Utils/TextFormatting.h>
+#include <Utils/Memory.h>
 #include <Utils/VariableWatcher.h>
 
 #include <Physics/PhysicsEngine.h>
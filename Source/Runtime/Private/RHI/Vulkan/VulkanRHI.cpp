@@ -4,6 +4,7 @@
 
 #include "Engine/Engine.h"
 #include "Utils/Hasher.h"
+#include "Utils/Memory.h"
 
 #include "RHI/Vulkan/VulkanRHI.h"
 #include "RHI/Vulkan/Vulkan.h"
@@ -1737,8 +1738,9 @@ namespace EE
         auto vulkanFence = static_cast<const VulkanRHIFence*>( info.signalFence );
 
         uint32 waitSemaphoreCount = (uint32)info.waitSemaphores.size();
-        TArray<VkSemaphore> waitSemaphores;
-        TArray<VkPipelineStageFlags> waitStageFlags;
+        // Submit scratch only lives until vkQueueSubmit returns, take it from the frame arena
+        TArray<VkSemaphore, Memory::TFrameAllocator<VkSemaphore>> waitSemaphores;
+        TArray<VkPipelineStageFlags, Memory::TFrameAllocator<VkPipelineStageFlags>> waitStageFlags;
         waitSemaphores.resize( waitSemaphoreCount );
         waitStageFlags.resize( waitSemaphoreCount );
         for ( uint32 i = 0; i < waitSemaphoreCount; i++ )
@@ -1749,7 +1751,7 @@ namespace EE
         }
 
         uint32 signalSemaphoreCount = (uint32)info.signalSemaphores.size();
-        TArray<VkSemaphore> signalSemaphores;
+        TArray<VkSemaphore, Memory::TFrameAllocator<VkSemaphore>> signalSemaphores;
         signalSemaphores.resize( signalSemaphoreCount );
         for ( uint32 i = 0; i < signalSemaphoreCount; i++ )
         {
@@ -2988,7 +2990,7 @@ namespace EE
     {
         const uint32 bindingCount = (uint32)info.bindings.size();
 
-        TArray<VkDescriptorPoolSize> poolSizes( bindingCount );
+        TInlineArray<VkDescriptorPoolSize, 8> poolSizes( bindingCount );
         for ( uint32 i = 0; i < bindingCount; i++ )
         {
             const RHIResourceBinding& binding = info.bindings[ i ];
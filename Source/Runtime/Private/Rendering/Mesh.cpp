@@ -42,6 +42,161 @@ namespace EE
         color = other.color;
     }
 
+    void MeshVertexStreams::Resize( size_t count, bool withBones )
+    {
+        positions.resize( count );
+        normals.resize( count );
+        tangents.resize( count );
+        uv0.resize( count );
+        uv1.resize( count );
+        colors.resize( count );
+        boneIndices.resize( withBones ? count * 4 : 0 );
+        boneWeights.resize( withBones ? count * 4 : 0 );
+    }
+
+    void MeshVertexStreams::Clear()
+    {
+        *this = MeshVertexStreams();
+    }
+
+    StaticVertex MeshVertexStreams::GetVertex( size_t index ) const
+    {
+        return StaticVertex( positions[ index ], normals[ index ], tangents[ index ], uv0[ index ], uv1[ index ], colors[ index ] );
+    }
+
+    void MeshVertexStreams::SetVertex( size_t index, const StaticVertex& vertex )
+    {
+        positions[ index ] = vertex.position;
+        normals[ index ] = vertex.normal;
+        tangents[ index ] = vertex.tangent;
+        uv0[ index ] = vertex.uv0;
+        uv1[ index ] = vertex.uv1;
+        colors[ index ] = vertex.color;
+    }
+
+    SkinVertex MeshVertexStreams::GetSkinVertex( size_t index ) const
+    {
+        SkinVertex vertex( GetVertex( index ) );
+        if ( HasBones() )
+        {
+            std::copy_n( &boneIndices[ index * 4 ], 4, vertex.influenceBones );
+            std::copy_n( &boneWeights[ index * 4 ], 4, vertex.weights );
+        }
+        return vertex;
+    }
+
+    void MeshVertexStreams::SetSkinVertex( size_t index, const SkinVertex& vertex )
+    {
+        positions[ index ] = vertex.position;
+        normals[ index ] = vertex.normal;
+        tangents[ index ] = vertex.tangent;
+        uv0[ index ] = vertex.uv0;
+        uv1[ index ] = vertex.uv1;
+        colors[ index ] = vertex.color;
+        if ( HasBones() )
+        {
+            std::copy_n( vertex.influenceBones, 4, &boneIndices[ index * 4 ] );
+            std::copy_n( vertex.weights, 4, &boneWeights[ index * 4 ] );
+        }
+    }
+
+    void MeshVertexStreams::Assign( const MeshVertices& vertices )
+    {
+        Resize( vertices.size(), false );
+        for ( size_t i = 0; i < vertices.size(); i++ )
+            SetVertex( i, vertices[ i ] );
+    }
+
+    void MeshVertexStreams::Assign( const MeshSkinVertices& vertices )
+    {
+        Resize( vertices.size(), true );
+        for ( size_t i = 0; i < vertices.size(); i++ )
+            SetSkinVertex( i, vertices[ i ] );
+    }
+
+    void MeshVertexStreams::CopyTo( MeshVertices& outVertices ) const
+    {
+        outVertices.resize( size() );
+        for ( size_t i = 0; i < outVertices.size(); i++ )
+            outVertices[ i ] = GetVertex( i );
+    }
+
+    void MeshVertexStreams::CopyTo( MeshSkinVertices& outVertices ) const
+    {
+        outVertices.resize( size() );
+        for ( size_t i = 0; i < outVertices.size(); i++ )
+            outVertices[ i ] = GetSkinVertex( i );
+    }
+
+    // Passes are written once over indexable positions, normals and uvs. The streams layout calls them with
+    // plain pointers so the loops run over contiguous arrays, the interleaved layout with strided views
+    template<typename TPositions>
+    static void AddToBounding( Box3f& bounding, const TPositions& positions, size_t count )
+    {
+        for ( size_t i = 0; i < count; i++ )
+            bounding.Add( positions[ i ] );
+    }
+
+    //* Flat normals, a vertex shared by several faces keeps the one of the last face
+    template<typename TPositions, typename TNormals>
+    static void ComputeFaceNormals( const MeshFaces& faces, size_t faceCount, const TPositions& positions, const TNormals& normals )
+    {
+        for ( size_t i = 0; i < faceCount; i++ )
+        {
+            const MeshFace& triangle = faces[ i ];
+            const Vector3f& vertexA = positions[ triangle.indx0 ];
+            const Vector3f& vertexB = positions[ triangle.indx1 ];
+            const Vector3f& vertexC = positions[ triangle.indx2 ];
+
+            const Vector3f edge1 = vertexB - vertexA;
+            const Vector3f edge2 = vertexC - vertexA;
+
+            const Vector3f normal = Vector3f::Cross( edge1, edge2 ).Normalized();
+
+            normals[ triangle.indx0 ] = normal;
+            normals[ triangle.indx1 ] = normal;
+            normals[ triangle.indx2 ] = normal;
+        }
+    }
+
+    template<typename TPositions, typename TUVs, typename TTangents>
+    static void ComputeFaceTangents( const MeshFaces& faces, size_t faceCount, const TPositions& positions, const TUVs& uvs, const TTangents& tangents )
+    {
+        // --- For each triangle, compute the edge (DeltaPos) and the DeltaUV
+        for ( size_t i = 0; i < faceCount; i++ )
+        {
+            const MeshFace& triangle = faces[ i ];
+            const Vector3f& vertexA = positions[ triangle.indx0 ];
+            const Vector3f& vertexB = positions[ triangle.indx1 ];
+            const Vector3f& vertexC = positions[ triangle.indx2 ];
+
+            const Vector2f& uvA = uvs[ triangle.indx0 ];
+            const Vector2f& uvB = uvs[ triangle.indx1 ];
+            const Vector2f& uvC = uvs[ triangle.indx2 ];
+
+            // --- Edges of the triangle : position delta
+            const Vector3f edge1 = vertexB - vertexA;
+            const Vector3f edge2 = vertexC - vertexA;
+
+            // --- UV delta
+            const Vector2f deltaUV1 = uvB - uvA;
+            const Vector2f deltaUV2 = uvC - uvA;
+
+            float r = 1.F / (deltaUV1.x * deltaUV2.y - deltaUV1.y * deltaUV2.x);
+            r = std::isfinite( r ) ? r : 0;
+
+            Vector3f tangent;
+            tangent.x = r * (deltaUV2.y * edge1.x - deltaUV1.y * edge2.x);
+            tangent.y = r * (deltaUV2.y * edge1.y - deltaUV1.y * edge2.y);
+            tangent.z = r * (deltaUV2.y * edge1.z - deltaUV1.y * edge2.z);
+            tangent.Normalize();
+
+            tangents[ triangle.indx0 ] = tangent;
+            tangents[ triangle.indx1 ] = tangent;
+            tangents[ triangle.indx2 ] = tangent;
+        }
+    }
+
     Mesh::Mesh()
     {
         // vertexArrayPointer = NULL;
@@ -116,7 +271,13 @@ namespace EE
         faces.swap( other.faces );
         staticVertices.swap( other.staticVertices );
         skinVertices.swap( other.skinVertices );
+        std::swap( vertexStreams, other.vertexStreams );
+        vertexLayout = other.vertexLayout;
         subdivisionsMap.swap( other.subdivisionsMap );
+        lods.swap( other.lods );
+        meshlets.swap( other.meshlets );
+        meshletVertices.swap( other.meshletVertices );
+        meshletIndices.swap( other.meshletIndices );
         materialsMap.swap( other.materialsMap );
         bounding = other.bounding;
 
@@ -133,10 +294,10 @@ namespace EE
         if ( !hasBoundingBox )
         {
             bounding = Box3f();
-            for ( MeshVertices::const_iterator Vertex = staticVertices.begin(); Vertex != staticVertices.end(); ++Vertex )
-            {
-                bounding.Add( Vertex->position );
-            }
+            if ( vertexLayout == MeshVertexLayout_Streams )
+                AddToBounding( bounding, vertexStreams.positions.data(), vertexStreams.size() );
+            else
+                AddToBounding( bounding, GetPositions(), GetVertexCount() );
             hasBoundingBox = true;
         }
     }
@@ -146,62 +307,23 @@ namespace EE
         if ( uvChannels <= 0 || hasTangents )
             return;
 
-        // --- For each triangle, compute the edge (DeltaPos) and the DeltaUV
-        for ( MeshFaces::const_iterator triangle = faces.begin(); triangle != faces.end(); ++triangle )
-        {
-            const Vector3f& vertexA = staticVertices[ (*triangle).indx0 ].position;
-            const Vector3f& vertexB = staticVertices[ (*triangle).indx1 ].position;
-            const Vector3f& vertexC = staticVertices[ (*triangle).indx2 ].position;
-
-            const Vector2f& uvA = staticVertices[ (*triangle).indx0 ].uv0;
-            const Vector2f& uvB = staticVertices[ (*triangle).indx1 ].uv0;
-            const Vector2f& uvC = staticVertices[ (*triangle).indx2 ].uv0;
-
-            // --- Edges of the triangle : position delta
-            const Vector3f edge1 = vertexB - vertexA;
-            const Vector3f edge2 = vertexC - vertexA;
-
-            // --- UV delta
-            const Vector2f deltaUV1 = uvB - uvA;
-            const Vector2f deltaUV2 = uvC - uvA;
-
-            float r = 1.F / (deltaUV1.x * deltaUV2.y - deltaUV1.y * deltaUV2.x);
-            r = std::isfinite( r ) ? r : 0;
-
-            Vector3f tangent;
-            tangent.x = r * (deltaUV2.y * edge1.x - deltaUV1.y * edge2.x);
-            tangent.y = r * (deltaUV2.y * edge1.y - deltaUV1.y * edge2.y);
-            tangent.z = r * (deltaUV2.y * edge1.z - deltaUV1.y * edge2.z);
-            tangent.Normalize();
-
-            staticVertices[ (*triangle).indx0 ].tangent = tangent;
-            staticVertices[ (*triangle).indx1 ].tangent = tangent;
-            staticVertices[ (*triangle).indx2 ].tangent = tangent;
-        }
+        if ( vertexLayout == MeshVertexLayout_Streams )
+            ComputeFaceTangents( faces, GetBaseFaceCount(), vertexStreams.positions.data(), vertexStreams.uv0.data(), vertexStreams.tangents.data() );
+        else
+            ComputeFaceTangents( faces, GetBaseFaceCount(), GetPositions(), GetUV0(), GetTangents() );
 
         hasTangents = true;
     }
 
     void MeshData::ComputeNormals()
     {
-        if ( staticVertices.size() <= 0 || hasNormals )
+        if ( GetVertexCount() <= 0 || hasNormals )
             return;
 
-        for ( MeshFaces::const_iterator Triangle = faces.begin(); Triangle != faces.end(); ++Triangle )
-        {
-            const Vector3f& vertexA = staticVertices[ (*Triangle).indx0 ].position;
-            const Vector3f& vertexB = staticVertices[ (*Triangle).indx1 ].position;
-            const Vector3f& vertexC = staticVertices[ (*Triangle).indx2 ].position;
-
-            const Vector3f edge1 = vertexB - vertexA;
-            const Vector3f edge2 = vertexC - vertexA;
-
-            const Vector3f normal = Vector3f::Cross( edge1, edge2 ).Normalized();
-
-            staticVertices[ (*Triangle).indx0 ].normal = normal;
-            staticVertices[ (*Triangle).indx1 ].normal = normal;
-            staticVertices[ (*Triangle).indx2 ].normal = normal;
-        }
+        if ( vertexLayout == MeshVertexLayout_Streams )
+            ComputeFaceNormals( faces, GetBaseFaceCount(), vertexStreams.positions.data(), vertexStreams.normals.data() );
+        else
+            ComputeFaceNormals( faces, GetBaseFaceCount(), GetPositions(), GetNormals() );
 
         hasNormals = true;
     }
@@ -210,7 +332,16 @@ namespace EE
     {
         name.clear();
         faces.clear();
+        lods.clear();
+        meshlets.clear();
+        meshletVertices.clear();
+        meshletIndices.clear();
+        subdivisionsMap.clear();
+        materialsMap.clear();
         staticVertices.clear();
+        skinVertices.clear();
+        vertexStreams.Clear();
+        vertexLayout = MeshVertexLayout_Interleaved;
         bounding = Box3f();
         hasNormals = false;
         hasTangents = false;
@@ -219,4 +350,36 @@ namespace EE
         hasBoundingBox = true;
         hasBones = false;
     }
-}
\ No newline at end of file
+
+    void MeshData::SetVertexLayout( EMeshVertexLayout layout )
+    {
+        if ( layout == vertexLayout )
+            return;
+
+        if ( layout == MeshVertexLayout_Streams )
+        {
+            if ( UsesSkinVertices() )
+                vertexStreams.Assign( skinVertices );
+            else
+                vertexStreams.Assign( staticVertices );
+            MeshVertices().swap( staticVertices );
+            MeshSkinVertices().swap( skinVertices );
+        }
+        else
+        {
+            if ( vertexStreams.HasBones() )
+                vertexStreams.CopyTo( skinVertices );
+            else
+                vertexStreams.CopyTo( staticVertices );
+            vertexStreams.Clear();
+        }
+        vertexLayout = layout;
+    }
+
+    size_t MeshData::GetVertexCount() const
+    {
+        if ( vertexLayout == MeshVertexLayout_Streams )
+            return vertexStreams.size();
+        return UsesSkinVertices() ? skinVertices.size() : staticVertices.size();
+    }
+}
@@ -0,0 +1,356 @@
+#include "CoreMinimal.h"
+
+#include "Rendering/MeshOptimizer.h"
+
+#include <algorithm>
+
+namespace EE
+{
+    static constexpr uint32 kInvalidIndex = UINT32_MAX;
+
+    //* Calls the function with the faces of every subdivision, or all of them when the mesh has none
+    template<typename Function>
+    static void ForEachSubdivisionFaces( MeshData& mesh, Function function )
+    {
+        if ( mesh.subdivisionsMap.empty() )
+        {
+            function( mesh.faces.data(), (uint32)mesh.GetBaseFaceCount() );
+            return;
+        }
+
+        for ( auto& [ materialIndex, subdivision ] : mesh.subdivisionsMap )
+        {
+            const uint32 firstFace = subdivision.baseIndex / 3;
+            const uint32 faceCount = std::min( subdivision.indexCount / 3, (uint32)mesh.faces.size() - std::min( firstFace, (uint32)mesh.faces.size() ) );
+            if ( faceCount > 0 )
+                function( mesh.faces.data() + firstFace, faceCount );
+        }
+    }
+
+    //* FIFO cache tracked with the miss count at which each vertex entered, flushing is moving the count past the cache size
+    class VertexCacheSimulation
+    {
+    public:
+        VertexCacheSimulation( uint32 vertexCount, uint32 cacheSize ) : _entryTimes( vertexCount, 0 ), _time( cacheSize + 1 ), _cacheSize( cacheSize ) {}
+
+        //* Returns true on a miss
+        FORCEINLINE bool Access( uint32 vertex )
+        {
+            if ( _time - _entryTimes[ vertex ] <= _cacheSize )
+                return false;
+            _entryTimes[ vertex ] = _time++;
+            return true;
+        }
+
+        FORCEINLINE uint32 Access( const MeshFace& face )
+        {
+            return (uint32)Access( face.indx0 ) + (uint32)Access( face.indx1 ) + (uint32)Access( face.indx2 );
+        }
+
+        FORCEINLINE void Flush() { _time += _cacheSize + 1; }
+
+        FORCEINLINE bool WasEverAccessed( uint32 vertex ) const { return _entryTimes[ vertex ] != 0; }
+
+    private:
+        TArray<uint32> _entryTimes;
+        uint32 _time;
+        uint32 _cacheSize;
+    };
+
+    //* Tipsify from Sander et al. 2007 over faces indexing [0, vertexCount) where every vertex is used
+    static void TipsifyFaces( MeshFace* faces, uint32 faceCount, uint32 vertexCount, uint32 cacheSize, TArray<uint32>& liveCounts, TArray<uint32>& adjacencyOffsets, TArray<uint32>& adjacency )
+    {
+        liveCounts.assign( vertexCount, 0 );
+        for ( uint32 face = 0; face < faceCount; face++ )
+            for ( uint32 corner = 0; corner < 3; corner++ )
+                liveCounts[ faces[ face ].indices[ corner ] ]++;
+
+        adjacencyOffsets.resize( vertexCount + 1 );
+        adjacencyOffsets[ 0 ] = 0;
+        for ( uint32 vertex = 0; vertex < vertexCount; vertex++ )
+            adjacencyOffsets[ vertex + 1 ] = adjacencyOffsets[ vertex ] + liveCounts[ vertex ];
+        adjacency.resize( (size_t)faceCount * 3 );
+        {
+            TArray<uint32> cursors( adjacencyOffsets.begin(), adjacencyOffsets.end() - 1 );
+            for ( uint32 face = 0; face < faceCount; face++ )
+                for ( uint32 corner = 0; corner < 3; corner++ )
+                    adjacency[ cursors[ faces[ face ].indices[ corner ] ]++ ] = face;
+        }
+
+        TArray<uint32> cacheTimes( vertexCount, 0 );
+        TArray<uint8> emitted( faceCount, 0 );
+        TArray<uint32> deadEnds;
+        deadEnds.reserve( (size_t)faceCount * 3 );
+        TArray<uint32> candidates;
+        TMeshArray<MeshFace> ordered;
+        ordered.reserve( faceCount );
+
+        uint32 time = cacheSize + 1;
+        uint32 cursor = 0;
+        uint32 fanningVertex = 0;
+        while ( fanningVertex != kInvalidIndex )
+        {
+            candidates.clear();
+            for ( uint32 i = adjacencyOffsets[ fanningVertex ]; i < adjacencyOffsets[ fanningVertex + 1 ]; i++ )
+            {
+                const uint32 face = adjacency[ i ];
+                if ( emitted[ face ] )
+                    continue;
+
+                emitted[ face ] = 1;
+                ordered.push_back( faces[ face ] );
+                for ( uint32 vertex : faces[ face ].indices )
+                {
+                    deadEnds.push_back( vertex );
+                    candidates.push_back( vertex );
+                    liveCounts[ vertex ]--;
+                    if ( time - cacheTimes[ vertex ] > cacheSize )
+                        cacheTimes[ vertex ] = time++;
+                }
+            }
+
+            // The oldest vertex that stays in the cache while all its faces are fanned
+            fanningVertex = kInvalidIndex;
+            int64 bestPriority = -1;
+            for ( uint32 vertex : candidates )
+            {
+                if ( liveCounts[ vertex ] == 0 )
+                    continue;
+
+                int64 priority = 0;
+                if ( time - cacheTimes[ vertex ] + 2 * liveCounts[ vertex ] <= cacheSize )
+                    priority = time - cacheTimes[ vertex ];
+                if ( priority > bestPriority )
+                {
+                    bestPriority = priority;
+                    fanningVertex = vertex;
+                }
+            }
+
+            if ( fanningVertex != kInvalidIndex )
+                continue;
+
+            // Dead end, back to the most recent vertex with faces left or else the next one in input order
+            while ( deadEnds.empty() == false && fanningVertex == kInvalidIndex )
+            {
+                const uint32 vertex = deadEnds.back();
+                deadEnds.pop_back();
+                if ( liveCounts[ vertex ] > 0 )
+                    fanningVertex = vertex;
+            }
+            while ( fanningVertex == kInvalidIndex && cursor < vertexCount )
+            {
+                if ( liveCounts[ cursor ] > 0 )
+                    fanningVertex = cursor;
+                cursor++;
+            }
+        }
+
+        std::copy( ordered.begin(), ordered.end(), faces );
+    }
+
+    void MeshOptimizer::OptimizeVertexCache( MeshData& mesh )
+    {
+        const uint32 vertexCount = (uint32)mesh.GetVertexCount();
+        TArray<uint32> localIndices( vertexCount, kInvalidIndex );
+        TArray<uint32> globalIndices;
+        TMeshArray<MeshFace> localFaces;
+        TArray<uint32> liveCounts, adjacencyOffsets, adjacency;
+
+        ForEachSubdivisionFaces( mesh, [ & ]( MeshFace* faces, uint32 faceCount )
+        {
+            // Subdivisions only use part of the vertices, numbered densely the work is per face instead of per mesh vertex
+            globalIndices.clear();
+            localFaces.resize( faceCount );
+            for ( uint32 face = 0; face < faceCount; face++ )
+            {
+                for ( uint32 corner = 0; corner < 3; corner++ )
+                {
+                    const uint32 vertex = faces[ face ].indices[ corner ];
+                    if ( localIndices[ vertex ] == kInvalidIndex )
+                    {
+                        localIndices[ vertex ] = (uint32)globalIndices.size();
+                        globalIndices.push_back( vertex );
+                    }
+                    localFaces[ face ].indices[ corner ] = localIndices[ vertex ];
+                }
+            }
+
+            TipsifyFaces( localFaces.data(), faceCount, (uint32)globalIndices.size(), VertexCacheSize, liveCounts, adjacencyOffsets, adjacency );
+
+            for ( uint32 face = 0; face < faceCount; face++ )
+                for ( uint32 corner = 0; corner < 3; corner++ )
+                    faces[ face ].indices[ corner ] = globalIndices[ localFaces[ face ].indices[ corner ] ];
+            for ( uint32 vertex : globalIndices )
+                localIndices[ vertex ] = kInvalidIndex;
+        } );
+    }
+
+    void MeshOptimizer::OptimizeOverdraw( MeshData& mesh, float threshold )
+    {
+        const TVertexAttributeView<const Vector3f> positions = std::as_const( mesh ).GetPositions();
+        VertexCacheSimulation cache( (uint32)mesh.GetVertexCount(), VertexCacheSize );
+        TArray<uint32> hardStarts;
+        TArray<uint32> clusterStarts;
+        TArray<float> clusterKeys;
+        TArray<uint32> clusterOrder;
+        TMeshArray<MeshFace> ordered;
+
+        ForEachSubdivisionFaces( mesh, [ & ]( MeshFace* faces, uint32 faceCount )
+        {
+            // Faces missing every vertex start over from a cold cache, the order can be cut there for free
+            hardStarts.assign( 1, 0 );
+            cache.Flush();
+            for ( uint32 face = 0; face < faceCount; face++ )
+                if ( cache.Access( faces[ face ] ) == 3 && face > 0 )
+                    hardStarts.push_back( face );
+            hardStarts.push_back( faceCount );
+
+            // Each hard cluster is cut again wherever the faces since the last cut already reach its miss ratio
+            clusterStarts.clear();
+            for ( size_t hard = 0; hard + 1 < hardStarts.size(); hard++ )
+            {
+                const uint32 begin = hardStarts[ hard ], end = hardStarts[ hard + 1 ];
+                cache.Flush();
+                uint32 clusterMisses = 0;
+                for ( uint32 face = begin; face < end; face++ )
+                    clusterMisses += cache.Access( faces[ face ] );
+                const float maxRatio = threshold * (float)clusterMisses / (float)(end - begin);
+
+                clusterStarts.push_back( begin );
+                cache.Flush();
+                uint32 misses = 0, count = 0;
+                for ( uint32 face = begin; face < end; face++ )
+                {
+                    misses += cache.Access( faces[ face ] );
+                    count++;
+                    if ( face + 1 < end && (float)misses <= maxRatio * (float)count )
+                    {
+                        clusterStarts.push_back( face + 1 );
+                        cache.Flush();
+                        misses = count = 0;
+                    }
+                }
+            }
+            const uint32 clusterCount = (uint32)clusterStarts.size();
+            clusterStarts.push_back( faceCount );
+            if ( clusterCount <= 1 )
+                return;
+
+            Vector3f meshCentroid( 0.F );
+            for ( uint32 face = 0; face < faceCount; face++ )
+                meshCentroid += positions[ faces[ face ].indx0 ] + positions[ faces[ face ].indx1 ] + positions[ faces[ face ].indx2 ];
+            meshCentroid /= (float)faceCount * 3.F;
+
+            // Clusters further out along their own facing are more likely to hide the others
+            clusterKeys.resize( clusterCount );
+            for ( uint32 cluster = 0; cluster < clusterCount; cluster++ )
+            {
+                Vector3f centroid( 0.F ), normal( 0.F );
+                float area = 0.F;
+                for ( uint32 face = clusterStarts[ cluster ]; face < clusterStarts[ cluster + 1 ]; face++ )
+                {
+                    const Vector3f& a = positions[ faces[ face ].indx0 ];
+                    const Vector3f& b = positions[ faces[ face ].indx1 ];
+                    const Vector3f& c = positions[ faces[ face ].indx2 ];
+                    const Vector3f faceNormal = Vector3f::Cross( b - a, c - a );
+                    const float faceArea = faceNormal.Magnitude();
+                    centroid += (a + b + c) * (faceArea / 3.F);
+                    normal += faceNormal;
+                    area += faceArea;
+                }
+
+                const float normalLength = normal.Magnitude();
+                clusterKeys[ cluster ] = area > 0.F && normalLength > 0.F ? Vector3f::Dot( centroid / area - meshCentroid, normal / normalLength ) : 0.F;
+            }
+
+            clusterOrder.resize( clusterCount );
+            for ( uint32 cluster = 0; cluster < clusterCount; cluster++ )
+                clusterOrder[ cluster ] = cluster;
+            std::stable_sort( clusterOrder.begin(), clusterOrder.end(), [ & ]( uint32 a, uint32 b ) { return clusterKeys[ a ] > clusterKeys[ b ]; } );
+
+            ordered.clear();
+            ordered.reserve( faceCount );
+            for ( uint32 cluster : clusterOrder )
+                ordered.insert( ordered.end(), faces + clusterStarts[ cluster ], faces + clusterStarts[ cluster + 1 ] );
+            std::copy( ordered.begin(), ordered.end(), faces );
+        } );
+    }
+
+    //* Moves the values of each vertex to its new index, perVertex values at a time
+    template<typename TValues>
+    static void RemapVertexValues( TValues& values, const TArray<uint32>& remap, uint32 newCount, size_t perVertex = 1 )
+    {
+        if ( values.empty() )
+            return;
+
+        TValues remapped( (size_t)newCount * perVertex );
+        for ( size_t vertex = 0; vertex < remap.size(); vertex++ )
+        {
+            if ( remap[ vertex ] != kInvalidIndex )
+                std::copy_n( values.begin() + vertex * perVertex, perVertex, remapped.begin() + (size_t)remap[ vertex ] * perVertex );
+        }
+        values.swap( remapped );
+    }
+
+    void MeshOptimizer::OptimizeVertexFetch( MeshData& mesh )
+    {
+        const uint32 vertexCount = (uint32)mesh.GetVertexCount();
+        TArray<uint32> remap( vertexCount, kInvalidIndex );
+        uint32 newCount = 0;
+        bool isIdentity = true;
+        for ( MeshFace& face : mesh.faces )
+        {
+            for ( uint32& index : face.indices )
+            {
+                if ( remap[ index ] == kInvalidIndex )
+                {
+                    isIdentity &= index == newCount;
+                    remap[ index ] = newCount++;
+                }
+                index = remap[ index ];
+            }
+        }
+        if ( isIdentity && newCount == vertexCount )
+            return;
+
+        for ( uint32& vertex : mesh.meshletVertices )
+            vertex = remap[ vertex ];
+
+        if ( mesh.vertexLayout == MeshVertexLayout_Streams )
+        {
+            MeshVertexStreams& streams = mesh.vertexStreams;
+            RemapVertexValues( streams.positions, remap, newCount );
+            RemapVertexValues( streams.normals, remap, newCount );
+            RemapVertexValues( streams.tangents, remap, newCount );
+            RemapVertexValues( streams.uv0, remap, newCount );
+            RemapVertexValues( streams.uv1, remap, newCount );
+            RemapVertexValues( streams.colors, remap, newCount );
+            RemapVertexValues( streams.boneIndices, remap, newCount, 4 );
+            RemapVertexValues( streams.boneWeights, remap, newCount, 4 );
+            return;
+        }
+        RemapVertexValues( mesh.staticVertices, remap, newCount );
+        RemapVertexValues( mesh.skinVertices, remap, newCount );
+    }
+
+    VertexCacheStatistics MeshOptimizer::AnalyzeVertexCache( const MeshData& mesh, uint32 cacheSize )
+    {
+        VertexCacheStatistics statistics;
+        statistics.triangleCount = (uint32)mesh.GetBaseFaceCount();
+        VertexCacheSimulation cache( (uint32)mesh.GetVertexCount(), cacheSize );
+        for ( uint32 face = 0; face < statistics.triangleCount; face++ )
+        {
+            for ( uint32 vertex : mesh.faces[ face ].indices )
+            {
+                const bool isFirstUse = cache.WasEverAccessed( vertex ) == false;
+                if ( cache.Access( vertex ) )
+                {
+                    statistics.transformedVertices++;
+                    statistics.referencedVertices += isFirstUse;
+                }
+            }
+        }
+        return statistics;
+    }
+}
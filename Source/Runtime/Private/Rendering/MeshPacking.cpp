@@ -0,0 +1,387 @@
+#include "CoreMinimal.h"
+
+#include "Rendering/MeshPacking.h"
+
+#include <cmath>
+
+namespace EE
+{
+    //* Rounds to nearest even, values past the half range clamp to the largest finite half
+    static uint16 FloatToHalf( float value )
+    {
+        uint32 bits;
+        memcpy( &bits, &value, sizeof( bits ) );
+        const uint16 sign = (uint16)((bits >> 16) & 0x8000);
+        bits &= 0x7FFFFFFF;
+
+        if ( bits > 0x7F800000 )
+            return sign | 0x7E00;
+        // 65520 and up round to infinity
+        if ( bits >= 0x477FF000 )
+            return sign | 0x7BFF;
+        // Under the smallest normal half, the mantissa is the value in units of 2^-24
+        if ( bits < 0x38800000 )
+            return sign | (uint16)std::nearbyint( std::abs( value ) * 16777216.F );
+
+        const uint32 rounded = bits + 0xFFF + ((bits >> 13) & 1);
+        return sign | (uint16)((rounded - 0x38000000) >> 13);
+    }
+
+    static float HalfToFloat( uint16 value )
+    {
+        const int32 exponent = (value >> 10) & 0x1F;
+        const int32 mantissa = value & 0x3FF;
+        const float magnitude = exponent == 0 ? std::ldexp( (float)mantissa, -24 )
+            : exponent == 0x1F ? (mantissa == 0 ? INFINITY : NAN)
+            : std::ldexp( (float)(mantissa | 0x400), exponent - 25 );
+        return (value & 0x8000) ? -magnitude : magnitude;
+    }
+
+    static FORCEINLINE uint16 QuantizeUNorm16( float value )
+    {
+        return (uint16)std::lround( Math::Clamp01( value ) * 65535.F );
+    }
+
+    //* Same as the GPU, -32768 and -32767 both decode to -1
+    static FORCEINLINE float DecodeSNorm16( int16 value )
+    {
+        return std::max( value / 32767.F, -1.F );
+    }
+
+    // Zero counts as positive so both octahedron halves fold the same way
+    static FORCEINLINE float OctahedralSign( float value )
+    {
+        return value >= 0.F ? 1.F : -1.F;
+    }
+
+    //* Projects a unit vector on the octahedron and unfolds the lower half over the corners of the square
+    static Vector2f OctahedralProject( const Vector3f& direction )
+    {
+        const float inverseNorm = 1.F / (std::abs( direction.x ) + std::abs( direction.y ) + std::abs( direction.z ));
+        const float x = direction.x * inverseNorm;
+        const float y = direction.y * inverseNorm;
+        if ( direction.z >= 0.F )
+            return Vector2f( x, y );
+        return Vector2f( (1.F - std::abs( y )) * OctahedralSign( x ), (1.F - std::abs( x )) * OctahedralSign( y ) );
+    }
+
+    static Vector3f OctahedralDecode( float x, float y )
+    {
+        Vector3f direction( x, y, 1.F - std::abs( x ) - std::abs( y ) );
+        if ( direction.z < 0.F )
+        {
+            direction.x = (1.F - std::abs( y )) * OctahedralSign( x );
+            direction.y = (1.F - std::abs( x )) * OctahedralSign( y );
+        }
+        return direction.Normalized();
+    }
+
+    static FORCEINLINE float AngleBetween( const Vector3f& a, const Vector3f& b )
+    {
+        // Keeps precision for small angles, unlike the arc cosine of the dot product
+        return std::atan2( Vector3f::Cross( a, b ).Magnitude(), Vector3f::Dot( a, b ) );
+    }
+
+    //* Keeps the closest of the four snorm16 neighbours of the projection, plain rounding can be off by twice as much.
+    //* Returns the angle error, zero length directions are packed as zero with no error
+    static float PackOctahedral( const Vector3f& direction, int16* outPacked )
+    {
+        const float length = direction.Magnitude();
+        if ( length <= 0.F )
+        {
+            outPacked[ 0 ] = outPacked[ 1 ] = 0;
+            return 0.F;
+        }
+
+        const Vector3f unit = direction / length;
+        const Vector2f projected = OctahedralProject( unit );
+        const float baseX = std::floor( projected.x * 32767.F );
+        const float baseY = std::floor( projected.y * 32767.F );
+
+        float bestError = MathConstants<float>::MaxValue;
+        for ( int32 corner = 0; corner < 4; corner++ )
+        {
+            const int16 x = (int16)Math::Clamp( baseX + (float)(corner & 1), -32767.F, 32767.F );
+            const int16 y = (int16)Math::Clamp( baseY + (float)(corner >> 1), -32767.F, 32767.F );
+            const float error = AngleBetween( OctahedralDecode( DecodeSNorm16( x ), DecodeSNorm16( y ) ), unit );
+            if ( error < bestError )
+            {
+                bestError = error;
+                outPacked[ 0 ] = x;
+                outPacked[ 1 ] = y;
+            }
+        }
+        return bestError;
+    }
+
+    static uint32 AddAttribute( RHIVertexBufferLayout& layout, EMeshVertexAttribute attribute, EVertexFormat format, uint32 size, Name semanticName )
+    {
+        const uint32 offset = layout.stride;
+        layout.attributes.push_back( RHIVertexAttribute{ format, offset, semanticName, (uint8)attribute } );
+        layout.stride += size;
+        return offset;
+    }
+
+    //* Calls the function with the index and the packed memory of the attribute of every vertex
+    template<typename Function>
+    static void ForEachPackedVertex( PackedMeshData& packed, uint32 offset, Function function )
+    {
+        uint8* vertex = packed.vertices.data() + offset;
+        const uint32 stride = packed.layout.stride;
+        for ( uint32 index = 0; index < packed.vertexCount; index++, vertex += stride )
+            function( index, vertex );
+    }
+
+    //* Both layouts keep four bones per vertex together
+    static void GetBoneData( const MeshData& mesh, uint32 vertex, const uint32*& outIndices, const float*& outWeights )
+    {
+        if ( mesh.vertexLayout == MeshVertexLayout_Streams )
+        {
+            outIndices = mesh.vertexStreams.boneIndices.data() + vertex * 4;
+            outWeights = mesh.vertexStreams.boneWeights.data() + vertex * 4;
+            return;
+        }
+        outIndices = mesh.skinVertices[ vertex ].influenceBones;
+        outWeights = mesh.skinVertices[ vertex ].weights;
+    }
+
+    static size_t GetSourceSize( const MeshData& mesh )
+    {
+        if ( mesh.vertexLayout == MeshVertexLayout_Interleaved )
+            return mesh.UsesSkinVertices() ? mesh.skinVertices.size() * sizeof( SkinVertex ) : mesh.staticVertices.size() * sizeof( StaticVertex );
+
+        const MeshVertexStreams& streams = mesh.vertexStreams;
+        return streams.positions.size() * sizeof( Vector3f ) + streams.normals.size() * sizeof( Vector3f ) + streams.tangents.size() * sizeof( Vector3f )
+            + streams.uv0.size() * sizeof( Vector2f ) + streams.uv1.size() * sizeof( Vector2f ) + streams.colors.size() * sizeof( Vector4f )
+            + streams.boneIndices.size() * sizeof( uint32 ) + streams.boneWeights.size() * sizeof( float );
+    }
+
+    static float PackPositions( const MeshData& mesh, const MeshPackingOptions& options, PackedMeshData& packed, uint32 offset )
+    {
+        const TVertexAttributeView<const Vector3f> positions = mesh.GetPositions();
+        if ( options.quantizePositions == false )
+        {
+            packed.positionOffset = Vector3f( 0.F );
+            packed.positionScale = Vector3f( 1.F );
+            ForEachPackedVertex( packed, offset, [ & ]( uint32 index, uint8* vertex )
+            {
+                memcpy( vertex, &positions[ index ], sizeof( Vector3f ) );
+            } );
+            return 0.F;
+        }
+
+        // Measured from the positions, the range must hold every vertex even when the stored bounding is stale
+        const Vector3f& first = positions[ 0 ];
+        Box3f bounding( first.x, first.y, first.z, first.x, first.y, first.z );
+        for ( uint32 index = 1; index < packed.vertexCount; index++ )
+            bounding.Add( positions[ index ] );
+
+        const Vector3f minPoint( bounding.minX, bounding.minY, bounding.minZ );
+        const Vector3f size( bounding.maxX - bounding.minX, bounding.maxY - bounding.minY, bounding.maxZ - bounding.minZ );
+        const Vector3f inverseSize( size.x > 0.F ? 1.F / size.x : 0.F, size.y > 0.F ? 1.F / size.y : 0.F, size.z > 0.F ? 1.F / size.z : 0.F );
+        packed.positionOffset = minPoint;
+        packed.positionScale = size;
+
+        float error = 0.F;
+        ForEachPackedVertex( packed, offset, [ & ]( uint32 index, uint8* vertex )
+        {
+            const Vector3f normalized = (positions[ index ] - minPoint) * inverseSize;
+            const uint16 quantized[ 4 ] = { QuantizeUNorm16( normalized.x ), QuantizeUNorm16( normalized.y ), QuantizeUNorm16( normalized.z ), 0 };
+            memcpy( vertex, quantized, sizeof( quantized ) );
+
+            const Vector3f decoded = minPoint + size * Vector3f( quantized[ 0 ] / 65535.F, quantized[ 1 ] / 65535.F, quantized[ 2 ] / 65535.F );
+            error = std::max( error, (decoded - positions[ index ]).Magnitude() );
+        } );
+        return error;
+    }
+
+    static float PackDirections( const TVertexAttributeView<const Vector3f>& directions, PackedMeshData& packed, uint32 offset )
+    {
+        float error = 0.F;
+        ForEachPackedVertex( packed, offset, [ & ]( uint32 index, uint8* vertex )
+        {
+            int16 encoded[ 2 ];
+            error = std::max( error, PackOctahedral( directions[ index ], encoded ) );
+            memcpy( vertex, encoded, sizeof( encoded ) );
+        } );
+        return error;
+    }
+
+    static float PackUVs( const TVertexAttributeView<const Vector2f>& uvs, const MeshPackingOptions& options, PackedMeshData& packed, uint32 offset, int32 channel )
+    {
+        float error = 0.F;
+        if ( options.uvFormat == MeshUVFormat_Half )
+        {
+            packed.uvOffsets[ channel ] = Vector2f( 0.F );
+            packed.uvScales[ channel ] = Vector2f( 1.F );
+            ForEachPackedVertex( packed, offset, [ & ]( uint32 index, uint8* vertex )
+            {
+                const Vector2f& uv = uvs[ index ];
+                const uint16 encoded[ 2 ] = { FloatToHalf( uv.x ), FloatToHalf( uv.y ) };
+                memcpy( vertex, encoded, sizeof( encoded ) );
+                error = std::max( error, std::max( std::abs( HalfToFloat( encoded[ 0 ] ) - uv.x ), std::abs( HalfToFloat( encoded[ 1 ] ) - uv.y ) ) );
+            } );
+            return error;
+        }
+
+        Vector2f minUV( MathConstants<float>::MaxValue ), maxUV( -MathConstants<float>::MaxValue );
+        for ( uint32 index = 0; index < packed.vertexCount; index++ )
+        {
+            minUV = Vector2f( std::min( minUV.x, uvs[ index ].x ), std::min( minUV.y, uvs[ index ].y ) );
+            maxUV = Vector2f( std::max( maxUV.x, uvs[ index ].x ), std::max( maxUV.y, uvs[ index ].y ) );
+        }
+        const Vector2f size = maxUV - minUV;
+        const Vector2f inverseSize( size.x > 0.F ? 1.F / size.x : 0.F, size.y > 0.F ? 1.F / size.y : 0.F );
+        packed.uvOffsets[ channel ] = minUV;
+        packed.uvScales[ channel ] = size;
+
+        ForEachPackedVertex( packed, offset, [ & ]( uint32 index, uint8* vertex )
+        {
+            const Vector2f& uv = uvs[ index ];
+            const uint16 encoded[ 2 ] = { QuantizeUNorm16( (uv.x - minUV.x) * inverseSize.x ), QuantizeUNorm16( (uv.y - minUV.y) * inverseSize.y ) };
+            memcpy( vertex, encoded, sizeof( encoded ) );
+            const float decodedX = minUV.x + size.x * (encoded[ 0 ] / 65535.F);
+            const float decodedY = minUV.y + size.y * (encoded[ 1 ] / 65535.F);
+            error = std::max( error, std::max( std::abs( decodedX - uv.x ), std::abs( decodedY - uv.y ) ) );
+        } );
+        return error;
+    }
+
+    //* Colors out of the [0, 1] range are clamped and show in the error
+    static float PackColors( const TVertexAttributeView<const Vector4f>& colors, PackedMeshData& packed, uint32 offset )
+    {
+        float error = 0.F;
+        ForEachPackedVertex( packed, offset, [ & ]( uint32 index, uint8* vertex )
+        {
+            const Vector4f& color = colors[ index ];
+            const float channels[ 4 ] = { color.x, color.y, color.z, color.w };
+            for ( int32 channel = 0; channel < 4; channel++ )
+            {
+                vertex[ channel ] = (uint8)std::lround( Math::Clamp01( channels[ channel ] ) * 255.F );
+                error = std::max( error, std::abs( vertex[ channel ] / 255.F - channels[ channel ] ) );
+            }
+        } );
+        return error;
+    }
+
+    static uint32 GetMaxBone( const MeshData& mesh, uint32 vertexCount )
+    {
+        uint32 maxBone = 0;
+        for ( uint32 index = 0; index < vertexCount; index++ )
+        {
+            const uint32* bones; const float* weights;
+            GetBoneData( mesh, index, bones, weights );
+            for ( int32 influence = 0; influence < 4; influence++ )
+                maxBone = std::max( maxBone, bones[ influence ] );
+        }
+        return maxBone;
+    }
+
+    //* Weights are normalized and rounded so they still add up to exactly one on the GPU
+    static float PackBones( const MeshData& mesh, PackedMeshData& packed, uint32 indicesOffset, uint32 weightsOffset, bool wideIndices )
+    {
+        float error = 0.F;
+        ForEachPackedVertex( packed, 0, [ & ]( uint32 index, uint8* vertex )
+        {
+            const uint32* bones; const float* weights;
+            GetBoneData( mesh, index, bones, weights );
+
+            for ( int32 influence = 0; influence < 4; influence++ )
+            {
+                if ( wideIndices )
+                {
+                    const uint16 bone = (uint16)std::min<uint32>( bones[ influence ], UINT16_MAX );
+                    memcpy( vertex + indicesOffset + influence * sizeof( uint16 ), &bone, sizeof( bone ) );
+                }
+                else
+                {
+                    vertex[ indicesOffset + influence ] = (uint8)bones[ influence ];
+                }
+            }
+
+            const float weightSum = weights[ 0 ] + weights[ 1 ] + weights[ 2 ] + weights[ 3 ];
+            const float inverseSum = weightSum > 0.F ? 1.F / weightSum : 0.F;
+            uint8* packedWeights = vertex + weightsOffset;
+            int32 packedSum = 0, largest = 0;
+            for ( int32 influence = 0; influence < 4; influence++ )
+            {
+                packedWeights[ influence ] = (uint8)std::lround( Math::Clamp01( weights[ influence ] * inverseSum ) * 255.F );
+                packedSum += packedWeights[ influence ];
+                if ( weights[ influence ] > weights[ largest ] )
+                    largest = influence;
+            }
+            // Rounding leaves at most two units over or under, the largest weight absorbs them
+            if ( weightSum > 0.F )
+                packedWeights[ largest ] = (uint8)Math::Clamp( packedWeights[ largest ] + 255 - packedSum, 0, 255 );
+
+            for ( int32 influence = 0; influence < 4; influence++ )
+                error = std::max( error, std::abs( packedWeights[ influence ] / 255.F - weights[ influence ] * inverseSum ) );
+        } );
+        return error;
+    }
+
+    bool MeshPacker::Pack( const MeshData& mesh, const MeshPackingOptions& options, PackedMeshData& outPacked )
+    {
+        outPacked.vertices.clear();
+        outPacked.layout = RHIVertexBufferLayout();
+        outPacked.error = MeshPackingError();
+        outPacked.vertexCount = (uint32)mesh.GetVertexCount();
+        outPacked.sourceSize = GetSourceSize( mesh );
+        if ( outPacked.vertexCount == 0 )
+            return false;
+
+        const bool hasNormals = mesh.hasNormals && mesh.GetNormals().size() > 0;
+        const bool hasTangents = mesh.hasTangents && mesh.GetTangents().size() > 0;
+        const int32 uvChannels = Math::Clamp( mesh.uvChannels, 0, 2 );
+        const bool hasColors = mesh.hasVertexColor && mesh.GetColors().size() > 0;
+        const bool hasBones = mesh.UsesSkinVertices();
+        const uint32 maxBone = hasBones ? GetMaxBone( mesh, outPacked.vertexCount ) : 0;
+        const bool wideBoneIndices = maxBone > UINT8_MAX;
+        if ( maxBone > UINT16_MAX )
+            EE_LOG_WARN( "Mesh '{}' uses bone {}, bone indices past {} are clamped", mesh.name, maxBone, UINT16_MAX );
+
+        // Every attribute takes a multiple of four bytes so offsets stay aligned without padding,
+        // the fourth component of quantized positions is padding
+        RHIVertexBufferLayout& layout = outPacked.layout;
+        const uint32 positionOffset = options.quantizePositions
+            ? AddAttribute( layout, MeshVertexAttribute_Position, VertexFormat_UNORM_16X4, sizeof( uint16 ) * 4, "POSITION"_name )
+            : AddAttribute( layout, MeshVertexAttribute_Position, VertexFormat_FLOAT_32X3, sizeof( float ) * 3, "POSITION"_name );
+        const uint32 normalOffset = hasNormals ? AddAttribute( layout, MeshVertexAttribute_Normal, VertexFormat_SNORM_16X2, sizeof( int16 ) * 2, "NORMAL"_name ) : 0;
+        const uint32 tangentOffset = hasTangents ? AddAttribute( layout, MeshVertexAttribute_Tangent, VertexFormat_SNORM_16X2, sizeof( int16 ) * 2, "TANGENT"_name ) : 0;
+        const EVertexFormat uvFormat = options.uvFormat == MeshUVFormat_Half ? VertexFormat_FLOAT_16X2 : VertexFormat_UNORM_16X2;
+        uint32 uvOffsets[ 2 ] = { 0, 0 };
+        for ( int32 channel = 0; channel < uvChannels; channel++ )
+        {
+            const EMeshVertexAttribute attribute = channel == 0 ? MeshVertexAttribute_UV0 : MeshVertexAttribute_UV1;
+            uvOffsets[ channel ] = AddAttribute( layout, attribute, uvFormat, sizeof( uint16 ) * 2, Name( "TEXCOORD"_name, (uint64)channel ) );
+        }
+        const uint32 colorOffset = hasColors ? AddAttribute( layout, MeshVertexAttribute_Color, VertexFormat_UNORM_8X4, sizeof( uint8 ) * 4, "COLOR"_name ) : 0;
+        uint32 boneIndicesOffset = 0, boneWeightsOffset = 0;
+        if ( hasBones )
+        {
+            boneIndicesOffset = wideBoneIndices
+                ? AddAttribute( layout, MeshVertexAttribute_BoneIndices, VertexFormat_UINT_16X4, sizeof( uint16 ) * 4, "BLENDINDICES"_name )
+                : AddAttribute( layout, MeshVertexAttribute_BoneIndices, VertexFormat_UINT_8X4, sizeof( uint8 ) * 4, "BLENDINDICES"_name );
+            boneWeightsOffset = AddAttribute( layout, MeshVertexAttribute_BoneWeights, VertexFormat_UNORM_8X4, sizeof( uint8 ) * 4, "BLENDWEIGHT"_name );
+        }
+
+        outPacked.vertices.resize( (size_t)outPacked.vertexCount * layout.stride );
+
+        MeshPackingError& error = outPacked.error;
+        error.position = PackPositions( mesh, options, outPacked, positionOffset );
+        if ( hasNormals )
+            error.normal = PackDirections( mesh.GetNormals(), outPacked, normalOffset );
+        if ( hasTangents )
+            error.tangent = PackDirections( mesh.GetTangents(), outPacked, tangentOffset );
+        if ( uvChannels > 0 )
+            error.uv = PackUVs( mesh.GetUV0(), options, outPacked, uvOffsets[ 0 ], 0 );
+        if ( uvChannels > 1 )
+            error.uv = std::max( error.uv, PackUVs( mesh.GetUV1(), options, outPacked, uvOffsets[ 1 ], 1 ) );
+        if ( hasColors )
+            error.color = PackColors( mesh.GetColors(), outPacked, colorOffset );
+        if ( hasBones )
+            error.boneWeight = PackBones( mesh, outPacked, boneIndicesOffset, boneWeightsOffset, wideBoneIndices );
+
+        return true;
+    }
+}
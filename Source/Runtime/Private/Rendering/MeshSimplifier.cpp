@@ -0,0 +1,599 @@
+#include "CoreMinimal.h"
+
+#include "Rendering/MeshSimplifier.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace EE
+{
+    static constexpr uint32 kInvalidIndex = UINT32_MAX;
+    // Open borders weigh more than faces so silhouettes of open meshes hold until the end
+    static constexpr double kBorderWeight = 10.0;
+    // Collapses that turn a face more than this cosine away from its normal are rejected
+    static constexpr float kMinFaceCosine = 0.25F;
+
+    enum ESimplifyVertexKind
+    {
+        //* Surrounded by faces, can collapse to any neighbour
+        SimplifyVertexKind_Manifold,
+        //* On an open edge, only slides along the border to another border vertex
+        SimplifyVertexKind_Border,
+        //* Split in two vertices by an attribute discontinuity, both slide together along the seam
+        SimplifyVertexKind_Seam,
+        //* Corners, vertices shared by several subdivisions or split in more than two, never move
+        SimplifyVertexKind_Locked,
+    };
+
+    //* Sum of weighted squared distances to planes, Q( p ) = p'Ap + 2b'p + c
+    struct Quadric
+    {
+        double a00 = 0.0, a11 = 0.0, a22 = 0.0, a01 = 0.0, a02 = 0.0, a12 = 0.0;
+        double b0 = 0.0, b1 = 0.0, b2 = 0.0;
+        double c = 0.0;
+        double weight = 0.0;
+
+        //* The plane dot( normal, p ) + distance = 0, normal must be unit length
+        static Quadric FromPlane( const Vector3f& normal, float distance, double weight )
+        {
+            Quadric quadric;
+            const double x = normal.x, y = normal.y, z = normal.z, d = distance;
+            quadric.a00 = weight * x * x;
+            quadric.a11 = weight * y * y;
+            quadric.a22 = weight * z * z;
+            quadric.a01 = weight * x * y;
+            quadric.a02 = weight * x * z;
+            quadric.a12 = weight * y * z;
+            quadric.b0 = weight * x * d;
+            quadric.b1 = weight * y * d;
+            quadric.b2 = weight * z * d;
+            quadric.c = weight * d * d;
+            quadric.weight = weight;
+            return quadric;
+        }
+
+        void operator+=( const Quadric& other )
+        {
+            a00 += other.a00; a11 += other.a11; a22 += other.a22;
+            a01 += other.a01; a02 += other.a02; a12 += other.a12;
+            b0 += other.b0; b1 += other.b1; b2 += other.b2;
+            c += other.c;
+            weight += other.weight;
+        }
+
+        //* Weighted sum of squared distances, divided by the weight it's the mean squared distance
+        double Evaluate( const Vector3f& point ) const
+        {
+            const double x = point.x, y = point.y, z = point.z;
+            const double rx = a00 * x + a01 * y + a02 * z;
+            const double ry = a01 * x + a11 * y + a12 * z;
+            const double rz = a02 * x + a12 * y + a22 * z;
+            return x * rx + y * ry + z * rz + 2.0 * (b0 * x + b1 * y + b2 * z) + c;
+        }
+    };
+
+    struct EdgeCollapse
+    {
+        uint32 vertex;
+        uint32 target;
+        float cost;
+    };
+
+    //* Simplification state kept between levels, so each level starts from the previous one with its quadrics
+    class MeshSimplification
+    {
+    public:
+        MeshSimplification( const MeshData& mesh );
+
+        //* Collapses edges in passes until the faces are at most targetFaceCount or nothing else can collapse
+        void Simplify( uint32 targetFaceCount );
+
+        FORCEINLINE uint32 GetFaceCount() const { return (uint32)_faces.size(); }
+        FORCEINLINE const TArray<MeshFace>& GetFaces() const { return _faces; }
+        FORCEINLINE const TArray<int32>& GetFaceSubdivisions() const { return _faceSubdivisions; }
+        //* Largest collapse error so far in mesh units
+        FORCEINLINE float GetError() const { return (float)std::sqrt( _maxCost ); }
+
+    private:
+        void BuildAdjacency();
+        bool HasEdge( uint32 from, uint32 to ) const;
+        //* Same as HasEdge between any vertices with the positions of from and to
+        bool HasPositionEdge( uint32 from, uint32 to ) const;
+        void ClassifyVertices();
+        void ComputeQuadrics();
+
+        //* Other vertex of the seam that moves with vertex when it collapses to target, kInvalidIndex if none
+        uint32 GetSeamTarget( uint32 vertex, uint32 target ) const;
+        bool CanCollapse( uint32 vertex, uint32 target ) const;
+        float GetCollapseCost( uint32 vertex, uint32 target ) const;
+        bool FlipsFaces( uint32 vertex, uint32 target ) const;
+        //* Faces around vertex that also touch the position of target, they are gone after the collapse
+        uint32 CountCollapsedFaces( uint32 vertex, uint32 target ) const;
+        void LockNeighbourhood( uint32 vertex );
+
+        void ApplyCollapses();
+
+        TArray<Vector3f> _positions;
+        TArray<MeshFace> _faces;
+        TArray<int32> _faceSubdivisions;
+
+        //* First vertex with the same position, quadrics are kept for it
+        TArray<uint32> _positionIds;
+        //* Circular list through the vertices of a position
+        TArray<uint32> _wedges;
+        TArray<uint8> _kinds;
+        //* Next and previous vertex along an open edge, kept up to date as the edges collapse
+        TArray<uint32> _openNext;
+        TArray<uint32> _openPrevious;
+        TArray<Quadric> _quadrics;
+
+        //* Faces around each vertex
+        TArray<uint32> _adjacencyOffsets;
+        TArray<uint32> _adjacency;
+
+        //* Per pass state, the vertex each one collapsed to and positions touched by a collapse
+        TArray<uint32> _remap;
+        TArray<uint8> _lockedPositions;
+        TArray<EdgeCollapse> _bestCollapses;
+        TArray<EdgeCollapse> _collapses;
+
+        double _maxCost;
+    };
+
+    MeshSimplification::MeshSimplification( const MeshData& mesh ) : _maxCost( 0.0 )
+    {
+        const TVertexAttributeView<const Vector3f> positions = mesh.GetPositions();
+        const uint32 vertexCount = (uint32)positions.size();
+        _positions.resize( vertexCount );
+        for ( uint32 vertex = 0; vertex < vertexCount; vertex++ )
+            _positions[ vertex ] = positions[ vertex ];
+
+        const uint32 faceCount = (uint32)mesh.GetBaseFaceCount();
+        _faces.assign( mesh.faces.begin(), mesh.faces.begin() + faceCount );
+        // Faces out of every subdivision keep the INT32_MIN key and are placed first in the levels
+        _faceSubdivisions.assign( faceCount, INT32_MIN );
+        for ( const auto& [ subdivisionKey, subdivision ] : mesh.subdivisionsMap )
+        {
+            const uint32 firstFace = std::min( subdivision.baseIndex / 3, faceCount );
+            const uint32 lastFace = std::min( firstFace + subdivision.indexCount / 3, faceCount );
+            std::fill( _faceSubdivisions.begin() + firstFace, _faceSubdivisions.begin() + lastFace, subdivisionKey );
+        }
+
+        // Vertices sorted by position give the runs that share one
+        TArray<uint32> sorted( vertexCount );
+        std::iota( sorted.begin(), sorted.end(), 0 );
+        std::sort( sorted.begin(), sorted.end(), [ this ]( uint32 a, uint32 b )
+        {
+            const Vector3f& positionA = _positions[ a ];
+            const Vector3f& positionB = _positions[ b ];
+            if ( positionA.x != positionB.x ) return positionA.x < positionB.x;
+            if ( positionA.y != positionB.y ) return positionA.y < positionB.y;
+            return positionA.z < positionB.z;
+        } );
+
+        _positionIds.resize( vertexCount );
+        _wedges.resize( vertexCount );
+        for ( uint32 runBegin = 0, runEnd = 0; runBegin < vertexCount; runBegin = runEnd )
+        {
+            runEnd = runBegin + 1;
+            while ( runEnd < vertexCount && _positions[ sorted[ runEnd ] ] == _positions[ sorted[ runBegin ] ] )
+                runEnd++;
+            for ( uint32 i = runBegin; i < runEnd; i++ )
+            {
+                _positionIds[ sorted[ i ] ] = sorted[ runBegin ];
+                _wedges[ sorted[ i ] ] = sorted[ i + 1 < runEnd ? i + 1 : runBegin ];
+            }
+        }
+
+        _remap.resize( vertexCount );
+        std::iota( _remap.begin(), _remap.end(), 0 );
+        _lockedPositions.resize( vertexCount );
+        _bestCollapses.resize( vertexCount );
+
+        BuildAdjacency();
+        ClassifyVertices();
+        ComputeQuadrics();
+    }
+
+    void MeshSimplification::BuildAdjacency()
+    {
+        const uint32 vertexCount = (uint32)_positions.size();
+        _adjacencyOffsets.assign( vertexCount + 1, 0 );
+        for ( const MeshFace& face : _faces )
+            for ( uint32 vertex : face.indices )
+                _adjacencyOffsets[ vertex + 1 ]++;
+        for ( uint32 vertex = 0; vertex < vertexCount; vertex++ )
+            _adjacencyOffsets[ vertex + 1 ] += _adjacencyOffsets[ vertex ];
+
+        _adjacency.resize( _faces.size() * 3 );
+        TArray<uint32> cursors( _adjacencyOffsets.begin(), _adjacencyOffsets.end() - 1 );
+        for ( uint32 face = 0; face < (uint32)_faces.size(); face++ )
+            for ( uint32 vertex : _faces[ face ].indices )
+                _adjacency[ cursors[ vertex ]++ ] = face;
+    }
+
+    bool MeshSimplification::HasEdge( uint32 from, uint32 to ) const
+    {
+        for ( uint32 i = _adjacencyOffsets[ from ]; i < _adjacencyOffsets[ from + 1 ]; i++ )
+        {
+            const MeshFace& face = _faces[ _adjacency[ i ] ];
+            for ( uint32 corner = 0; corner < 3; corner++ )
+                if ( face.indices[ corner ] == from && face.indices[ (corner + 1) % 3 ] == to )
+                    return true;
+        }
+        return false;
+    }
+
+    bool MeshSimplification::HasPositionEdge( uint32 from, uint32 to ) const
+    {
+        const uint32 toPosition = _positionIds[ to ];
+        uint32 wedge = from;
+        do
+        {
+            for ( uint32 i = _adjacencyOffsets[ wedge ]; i < _adjacencyOffsets[ wedge + 1 ]; i++ )
+            {
+                const MeshFace& face = _faces[ _adjacency[ i ] ];
+                for ( uint32 corner = 0; corner < 3; corner++ )
+                    if ( face.indices[ corner ] == wedge && _positionIds[ face.indices[ (corner + 1) % 3 ] ] == toPosition )
+                        return true;
+            }
+            wedge = _wedges[ wedge ];
+        }
+        while ( wedge != from );
+        return false;
+    }
+
+    void MeshSimplification::ClassifyVertices()
+    {
+        const uint32 vertexCount = (uint32)_positions.size();
+        _openNext.assign( vertexCount, kInvalidIndex );
+        _openPrevious.assign( vertexCount, kInvalidIndex );
+        TArray<uint8> openNextCounts( vertexCount, 0 );
+        TArray<uint8> openPreviousCounts( vertexCount, 0 );
+
+        // Edges without their opposite are open, a vertex on a single open edge loop has one in and one out
+        TArray<int32> positionSubdivisions( vertexCount, INT32_MIN );
+        TArray<uint8> seenPositions( vertexCount, 0 );
+        TArray<uint8> sharedPositions( vertexCount, 0 );
+        for ( uint32 face = 0; face < (uint32)_faces.size(); face++ )
+        {
+            for ( uint32 corner = 0; corner < 3; corner++ )
+            {
+                const uint32 from = _faces[ face ].indices[ corner ];
+                const uint32 to = _faces[ face ].indices[ (corner + 1) % 3 ];
+                if ( HasEdge( to, from ) == false )
+                {
+                    _openNext[ from ] = to;
+                    openNextCounts[ from ] = (uint8)std::min( openNextCounts[ from ] + 1, 2 );
+                    _openPrevious[ to ] = from;
+                    openPreviousCounts[ to ] = (uint8)std::min( openPreviousCounts[ to ] + 1, 2 );
+                }
+
+                const uint32 positionId = _positionIds[ from ];
+                if ( seenPositions[ positionId ] == 0 )
+                {
+                    seenPositions[ positionId ] = 1;
+                    positionSubdivisions[ positionId ] = _faceSubdivisions[ face ];
+                }
+                else if ( positionSubdivisions[ positionId ] != _faceSubdivisions[ face ] )
+                    sharedPositions[ positionId ] = 1;
+            }
+        }
+
+        _kinds.resize( vertexCount );
+        for ( uint32 vertex = 0; vertex < vertexCount; vertex++ )
+        {
+            const uint32 wedge = _wedges[ vertex ];
+            const bool isOnOpenLoop = openNextCounts[ vertex ] == 1 && openPreviousCounts[ vertex ] == 1;
+            ESimplifyVertexKind kind = SimplifyVertexKind_Locked;
+            if ( sharedPositions[ _positionIds[ vertex ] ] )
+            {
+                kind = SimplifyVertexKind_Locked;
+            }
+            else if ( wedge == vertex )
+            {
+                if ( openNextCounts[ vertex ] == 0 && openPreviousCounts[ vertex ] == 0 )
+                    kind = SimplifyVertexKind_Manifold;
+                else if ( isOnOpenLoop )
+                    kind = SimplifyVertexKind_Border;
+            }
+            else if ( _wedges[ wedge ] == vertex && isOnOpenLoop && openNextCounts[ wedge ] == 1 && openPreviousCounts[ wedge ] == 1 )
+            {
+                // Both sides of a seam run opposite to each other, otherwise the open edges are real borders
+                const bool isSeam = _positionIds[ _openNext[ vertex ] ] == _positionIds[ _openPrevious[ wedge ] ]
+                    && _positionIds[ _openPrevious[ vertex ] ] == _positionIds[ _openNext[ wedge ] ];
+                kind = isSeam ? SimplifyVertexKind_Seam : SimplifyVertexKind_Locked;
+            }
+            _kinds[ vertex ] = (uint8)kind;
+        }
+    }
+
+    void MeshSimplification::ComputeQuadrics()
+    {
+        _quadrics.assign( _positions.size(), Quadric() );
+        for ( const MeshFace& face : _faces )
+        {
+            const Vector3f& positionA = _positions[ face.indx0 ];
+            const Vector3f cross = Vector3f::Cross( _positions[ face.indx1 ] - positionA, _positions[ face.indx2 ] - positionA );
+            const float doubleArea = cross.Magnitude();
+            if ( doubleArea <= 0.F )
+                continue;
+
+            const Vector3f normal = cross / doubleArea;
+            const Quadric quadric = Quadric::FromPlane( normal, -normal.Dot( positionA ), doubleArea * 0.5 );
+            for ( uint32 vertex : face.indices )
+                _quadrics[ _positionIds[ vertex ] ] += quadric;
+
+            // Borders get a plane through the edge perpendicular to the face, so they don't slide inwards
+            for ( uint32 corner = 0; corner < 3; corner++ )
+            {
+                const uint32 from = face.indices[ corner ];
+                const uint32 to = face.indices[ (corner + 1) % 3 ];
+                if ( HasEdge( to, from ) || HasPositionEdge( to, from ) )
+                    continue;
+
+                const Vector3f edge = _positions[ to ] - _positions[ from ];
+                const Vector3f edgeNormal = Vector3f::Cross( edge, normal ).Normalized();
+                const Quadric borderQuadric = Quadric::FromPlane( edgeNormal, -edgeNormal.Dot( _positions[ from ] ), edge.MagnitudeSquared() * kBorderWeight );
+                _quadrics[ _positionIds[ from ] ] += borderQuadric;
+                _quadrics[ _positionIds[ to ] ] += borderQuadric;
+            }
+        }
+    }
+
+    uint32 MeshSimplification::GetSeamTarget( uint32 vertex, uint32 target ) const
+    {
+        const uint32 wedge = _wedges[ vertex ];
+        const uint32 targetPosition = _positionIds[ target ];
+        if ( _openNext[ wedge ] != kInvalidIndex && _positionIds[ _openNext[ wedge ] ] == targetPosition )
+            return _openNext[ wedge ];
+        if ( _openPrevious[ wedge ] != kInvalidIndex && _positionIds[ _openPrevious[ wedge ] ] == targetPosition )
+            return _openPrevious[ wedge ];
+        return kInvalidIndex;
+    }
+
+    bool MeshSimplification::CanCollapse( uint32 vertex, uint32 target ) const
+    {
+        if ( _positionIds[ vertex ] == _positionIds[ target ] )
+            return false;
+
+        const bool isAlongOpenEdge = _openNext[ vertex ] == target || _openPrevious[ vertex ] == target;
+        switch ( _kinds[ vertex ] )
+        {
+        case SimplifyVertexKind_Manifold:
+            return true;
+        case SimplifyVertexKind_Border:
+            return isAlongOpenEdge && _kinds[ target ] == SimplifyVertexKind_Border;
+        case SimplifyVertexKind_Seam:
+            return isAlongOpenEdge && _kinds[ target ] == SimplifyVertexKind_Seam && GetSeamTarget( vertex, target ) != kInvalidIndex;
+        default:
+            return false;
+        }
+    }
+
+    float MeshSimplification::GetCollapseCost( uint32 vertex, uint32 target ) const
+    {
+        // Quadrics add up as vertices merge, so the cost includes the error of earlier collapses into either one
+        const Quadric& vertexQuadric = _quadrics[ _positionIds[ vertex ] ];
+        const Quadric& targetQuadric = _quadrics[ _positionIds[ target ] ];
+        const double weight = vertexQuadric.weight + targetQuadric.weight;
+        if ( weight <= 0.0 )
+            return 0.F;
+        const Vector3f& position = _positions[ target ];
+        return (float)(std::max( vertexQuadric.Evaluate( position ) + targetQuadric.Evaluate( position ), 0.0 ) / weight);
+    }
+
+    bool MeshSimplification::FlipsFaces( uint32 vertex, uint32 target ) const
+    {
+        const uint32 targetPosition = _positionIds[ target ];
+        for ( uint32 i = _adjacencyOffsets[ vertex ]; i < _adjacencyOffsets[ vertex + 1 ]; i++ )
+        {
+            const MeshFace& face = _faces[ _adjacency[ i ] ];
+            if ( _positionIds[ face.indx0 ] == targetPosition || _positionIds[ face.indx1 ] == targetPosition || _positionIds[ face.indx2 ] == targetPosition )
+                continue;
+
+            Vector3f corners[ 3 ] = { _positions[ face.indx0 ], _positions[ face.indx1 ], _positions[ face.indx2 ] };
+            const Vector3f normal = Vector3f::Cross( corners[ 1 ] - corners[ 0 ], corners[ 2 ] - corners[ 0 ] );
+            for ( uint32 corner = 0; corner < 3; corner++ )
+                if ( face.indices[ corner ] == vertex )
+                    corners[ corner ] = _positions[ target ];
+            const Vector3f collapsedNormal = Vector3f::Cross( corners[ 1 ] - corners[ 0 ], corners[ 2 ] - corners[ 0 ] );
+
+            if ( normal.Dot( collapsedNormal ) <= kMinFaceCosine * normal.Magnitude() * collapsedNormal.Magnitude() )
+                return true;
+        }
+        return false;
+    }
+
+    uint32 MeshSimplification::CountCollapsedFaces( uint32 vertex, uint32 target ) const
+    {
+        const uint32 targetPosition = _positionIds[ target ];
+        uint32 count = 0;
+        for ( uint32 i = _adjacencyOffsets[ vertex ]; i < _adjacencyOffsets[ vertex + 1 ]; i++ )
+        {
+            const MeshFace& face = _faces[ _adjacency[ i ] ];
+            count += _positionIds[ face.indx0 ] == targetPosition || _positionIds[ face.indx1 ] == targetPosition || _positionIds[ face.indx2 ] == targetPosition;
+        }
+        return count;
+    }
+
+    void MeshSimplification::LockNeighbourhood( uint32 vertex )
+    {
+        // Later collapses in the pass can't move a corner of a face this one changed, that keeps the flip tests valid
+        for ( uint32 i = _adjacencyOffsets[ vertex ]; i < _adjacencyOffsets[ vertex + 1 ]; i++ )
+            for ( uint32 corner : _faces[ _adjacency[ i ] ].indices )
+                _lockedPositions[ _positionIds[ corner ] ] = 1;
+    }
+
+    void MeshSimplification::Simplify( uint32 targetFaceCount )
+    {
+        while ( _faces.size() > targetFaceCount )
+        {
+            // Only the cheapest collapse of each vertex is a candidate, open edges are only seen from one side so both
+            // directions are tried from every edge
+            std::fill( _bestCollapses.begin(), _bestCollapses.end(), EdgeCollapse{ kInvalidIndex, kInvalidIndex, FLT_MAX } );
+            for ( const MeshFace& face : _faces )
+            {
+                for ( uint32 corner = 0; corner < 3; corner++ )
+                {
+                    const uint32 a = face.indices[ corner ];
+                    const uint32 b = face.indices[ (corner + 1) % 3 ];
+                    if ( CanCollapse( a, b ) )
+                    {
+                        const float cost = GetCollapseCost( a, b );
+                        if ( cost < _bestCollapses[ a ].cost )
+                            _bestCollapses[ a ] = { a, b, cost };
+                    }
+                    if ( CanCollapse( b, a ) )
+                    {
+                        const float cost = GetCollapseCost( b, a );
+                        if ( cost < _bestCollapses[ b ].cost )
+                            _bestCollapses[ b ] = { b, a, cost };
+                    }
+                }
+            }
+
+            _collapses.clear();
+            for ( const EdgeCollapse& collapse : _bestCollapses )
+                if ( collapse.vertex != kInvalidIndex )
+                    _collapses.push_back( collapse );
+            if ( _collapses.empty() )
+                return;
+
+            std::sort( _collapses.begin(), _collapses.end(), []( const EdgeCollapse& a, const EdgeCollapse& b ) { return a.cost < b.cost; } );
+
+            // Each collapse removes about two faces, going a bit past the needed ones leaves room for the locked ones
+            // without taking collapses much worse than the ones a later pass would find. Near the goal most of the
+            // cheapest ones are locked, so a pass always gets a fair share of the candidates
+            const uint32 faceGoal = (uint32)_faces.size() - targetFaceCount;
+            const size_t collapseGoal = std::min( std::max( (size_t)faceGoal * 3 / 4, _collapses.size() / 8 ), _collapses.size() - 1 );
+            const float costLimit = _collapses[ collapseGoal ].cost;
+
+            std::fill( _lockedPositions.begin(), _lockedPositions.end(), 0 );
+            uint32 removedFaces = 0;
+            uint32 collapseCount = 0;
+            for ( const EdgeCollapse& collapse : _collapses )
+            {
+                if ( collapse.cost > costLimit || removedFaces >= faceGoal )
+                    break;
+                if ( _lockedPositions[ _positionIds[ collapse.vertex ] ] || _lockedPositions[ _positionIds[ collapse.target ] ] )
+                    continue;
+
+                const bool isSeam = _kinds[ collapse.vertex ] == SimplifyVertexKind_Seam;
+                const uint32 wedge = isSeam ? _wedges[ collapse.vertex ] : kInvalidIndex;
+                const uint32 wedgeTarget = isSeam ? GetSeamTarget( collapse.vertex, collapse.target ) : kInvalidIndex;
+                if ( FlipsFaces( collapse.vertex, collapse.target ) || (isSeam && FlipsFaces( wedge, wedgeTarget )) )
+                    continue;
+
+                removedFaces += CountCollapsedFaces( collapse.vertex, collapse.target );
+                _remap[ collapse.vertex ] = collapse.target;
+                LockNeighbourhood( collapse.vertex );
+                if ( isSeam )
+                {
+                    removedFaces += CountCollapsedFaces( wedge, wedgeTarget );
+                    _remap[ wedge ] = wedgeTarget;
+                    LockNeighbourhood( wedge );
+                }
+                _quadrics[ _positionIds[ collapse.target ] ] += _quadrics[ _positionIds[ collapse.vertex ] ];
+                _maxCost = std::max( _maxCost, (double)collapse.cost );
+                collapseCount++;
+            }
+            if ( collapseCount == 0 )
+                return;
+
+            ApplyCollapses();
+        }
+    }
+
+    void MeshSimplification::ApplyCollapses()
+    {
+        // Faces with two corners on the same position have no area left
+        uint32 keptCount = 0;
+        for ( uint32 face = 0; face < (uint32)_faces.size(); face++ )
+        {
+            MeshFace collapsed = _faces[ face ];
+            for ( uint32& vertex : collapsed.indices )
+                vertex = _remap[ vertex ];
+
+            const uint32 positionA = _positionIds[ collapsed.indx0 ];
+            const uint32 positionB = _positionIds[ collapsed.indx1 ];
+            const uint32 positionC = _positionIds[ collapsed.indx2 ];
+            if ( positionA == positionB || positionB == positionC || positionC == positionA )
+                continue;
+
+            _faceSubdivisions[ keptCount ] = _faceSubdivisions[ face ];
+            _faces[ keptCount++ ] = collapsed;
+        }
+        _faces.resize( keptCount );
+        _faceSubdivisions.resize( keptCount );
+
+        // A collapse along an open edge shortens the loop, collapsing against its direction points the target at itself
+        const uint32 vertexCount = (uint32)_positions.size();
+        for ( uint32 vertex = 0; vertex < vertexCount; vertex++ )
+        {
+            if ( _openNext[ vertex ] != kInvalidIndex )
+            {
+                const uint32 next = _openNext[ vertex ];
+                _openNext[ vertex ] = _remap[ next ] == vertex ? _openNext[ next ] : _remap[ next ];
+            }
+            if ( _openPrevious[ vertex ] != kInvalidIndex )
+            {
+                const uint32 previous = _openPrevious[ vertex ];
+                _openPrevious[ vertex ] = _remap[ previous ] == vertex ? _openPrevious[ previous ] : _remap[ previous ];
+            }
+        }
+        std::iota( _remap.begin(), _remap.end(), 0 );
+
+        BuildAdjacency();
+    }
+
+    uint32 MeshSimplifier::GenerateLODs( MeshData& mesh, uint32 levelCount, float reduction )
+    {
+        mesh.faces.resize( mesh.GetBaseFaceCount() );
+        mesh.lods.clear();
+        if ( levelCount == 0 || mesh.faces.empty() || mesh.GetVertexCount() == 0 )
+            return 0;
+
+        MeshSimplification simplification( mesh );
+        TArray<uint32> order;
+        for ( uint32 level = 0; level < levelCount; level++ )
+        {
+            const uint32 sourceCount = simplification.GetFaceCount();
+            const uint32 targetCount = (uint32)((float)sourceCount * reduction);
+            if ( targetCount == 0 )
+                break;
+
+            simplification.Simplify( targetCount );
+            // Less than half of the asked reduction means the mesh is mostly locked, the level wouldn't pay for itself
+            if ( simplification.GetFaceCount() * 2 > sourceCount + targetCount )
+                break;
+
+            // Faces of each subdivision together, in the order they had so the cache optimization mostly holds
+            const TArray<MeshFace>& faces = simplification.GetFaces();
+            const TArray<int32>& faceSubdivisions = simplification.GetFaceSubdivisions();
+            order.resize( faces.size() );
+            std::iota( order.begin(), order.end(), 0 );
+            std::stable_sort( order.begin(), order.end(), [ &faceSubdivisions ]( uint32 a, uint32 b ) { return faceSubdivisions[ a ] < faceSubdivisions[ b ]; } );
+
+            MeshLOD& lod = mesh.lods.emplace_back();
+            lod.baseIndex = (uint32)mesh.faces.size() * 3;
+            lod.indexCount = (uint32)faces.size() * 3;
+            lod.error = simplification.GetError();
+            for ( uint32 i = 0; i < (uint32)order.size(); i++ )
+            {
+                const int32 subdivisionKey = faceSubdivisions[ order[ i ] ];
+                if ( subdivisionKey != INT32_MIN && (i == 0 || faceSubdivisions[ order[ i - 1 ] ] != subdivisionKey) )
+                {
+                    Subdivision subdivision = mesh.subdivisionsMap.at( subdivisionKey );
+                    subdivision.baseIndex = (uint32)mesh.faces.size() * 3;
+                    subdivision.indexCount = 0;
+                    lod.subdivisionsMap.try_emplace( subdivisionKey, subdivision );
+                }
+                if ( subdivisionKey != INT32_MIN )
+                    lod.subdivisionsMap.at( subdivisionKey ).indexCount += 3;
+                mesh.faces.push_back( faces[ order[ i ] ] );
+            }
+        }
+        return (uint32)mesh.lods.size();
+    }
+}
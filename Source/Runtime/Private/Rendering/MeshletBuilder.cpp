@@ -0,0 +1,232 @@
+#include "CoreMinimal.h"
+
+#include "Rendering/MeshletBuilder.h"
+
+#include <algorithm>
+
+namespace EE
+{
+    static constexpr uint32 kInvalidIndex = UINT32_MAX;
+    static constexpr uint8 kNotInMeshlet = UINT8_MAX;
+    // Faces spread this close to a half sphere around the axis make a cone that would never cull
+    static constexpr float kMinConeDot = 0.1F;
+
+    static_assert( MeshletBuilder::MaxVertices < kNotInMeshlet, "Meshlet local indices must fit in uint8" );
+
+    //* Bounding sphere around the box center and the normal cone of the faces of a finished meshlet
+    static void ComputeMeshletBounds( Meshlet& meshlet, const MeshData& mesh, const TVertexAttributeView<const Vector3f>& positions )
+    {
+        const uint32* vertices = mesh.meshletVertices.data() + meshlet.vertexOffset;
+        const uint8* indices = mesh.meshletIndices.data() + meshlet.indexOffset;
+
+        Box3f box;
+        for ( uint32 vertex = 0; vertex < meshlet.vertexCount; vertex++ )
+            box.Add( positions[ vertices[ vertex ] ] );
+        meshlet.center = box.GetCenter();
+        float radiusSquared = 0.F;
+        for ( uint32 vertex = 0; vertex < meshlet.vertexCount; vertex++ )
+            radiusSquared = std::max( radiusSquared, (positions[ vertices[ vertex ] ] - meshlet.center).MagnitudeSquared() );
+        meshlet.radius = std::sqrt( radiusSquared );
+
+        Vector3f normals[ MeshletBuilder::MaxTriangles ];
+        Vector3f axis;
+        for ( uint32 triangle = 0; triangle < meshlet.triangleCount; triangle++ )
+        {
+            const Vector3f& a = positions[ vertices[ indices[ triangle * 3 ] ] ];
+            const Vector3f& b = positions[ vertices[ indices[ triangle * 3 + 1 ] ] ];
+            const Vector3f& c = positions[ vertices[ indices[ triangle * 3 + 2 ] ] ];
+            const Vector3f normal = Vector3f::Cross( b - a, c - a );
+            const float length = normal.Magnitude();
+            normals[ triangle ] = length > 0.F ? normal / length : Vector3f( 0.F );
+            axis += normals[ triangle ];
+        }
+
+        meshlet.coneApex = meshlet.center;
+        meshlet.coneCutoff = 1.F;
+        const float axisLength = axis.Magnitude();
+        if ( axisLength <= 0.F )
+            return;
+        meshlet.coneAxis = axis / axisLength;
+
+        float minDot = 1.F;
+        for ( uint32 triangle = 0; triangle < meshlet.triangleCount; triangle++ )
+            if ( normals[ triangle ].MagnitudeSquared() > 0.F )
+                minDot = std::min( minDot, normals[ triangle ].Dot( meshlet.coneAxis ) );
+        if ( minDot <= kMinConeDot )
+            return;
+
+        // The apex goes back along the axis until it's behind the plane of every face, from there the cone
+        // test holds for the whole meshlet and not only its center
+        float apexDistance = 0.F;
+        for ( uint32 triangle = 0; triangle < meshlet.triangleCount; triangle++ )
+        {
+            if ( normals[ triangle ].MagnitudeSquared() <= 0.F )
+                continue;
+            const Vector3f& corner = positions[ vertices[ indices[ triangle * 3 ] ] ];
+            const float distance = (meshlet.center - corner).Dot( normals[ triangle ] ) / meshlet.coneAxis.Dot( normals[ triangle ] );
+            apexDistance = std::max( apexDistance, distance );
+        }
+        meshlet.coneApex = meshlet.center - meshlet.coneAxis * apexDistance;
+        // Normals within acos( minDot ) of the axis all face away once the view is within its complement
+        meshlet.coneCutoff = std::sqrt( 1.F - minDot * minDot );
+    }
+
+    uint32 MeshletBuilder::Build( MeshData& mesh )
+    {
+        mesh.meshlets.clear();
+        mesh.meshletVertices.clear();
+        mesh.meshletIndices.clear();
+
+        const uint32 faceCount = (uint32)mesh.GetBaseFaceCount();
+        const uint32 vertexCount = (uint32)mesh.GetVertexCount();
+        if ( faceCount == 0 || vertexCount == 0 )
+            return 0;
+
+        const TVertexAttributeView<const Vector3f> positions = std::as_const( mesh ).GetPositions();
+        const MeshFace* faces = mesh.faces.data();
+
+        // Faces around each vertex not in a meshlet yet, the first liveCounts of each list
+        TArray<uint32> adjacencyOffsets( vertexCount + 1, 0 );
+        TArray<uint32> liveCounts( vertexCount, 0 );
+        for ( uint32 face = 0; face < faceCount; face++ )
+            for ( uint32 vertex : faces[ face ].indices )
+                liveCounts[ vertex ]++;
+        for ( uint32 vertex = 0; vertex < vertexCount; vertex++ )
+            adjacencyOffsets[ vertex + 1 ] = adjacencyOffsets[ vertex ] + liveCounts[ vertex ];
+        TArray<uint32> adjacency( adjacencyOffsets.back() );
+        std::fill( liveCounts.begin(), liveCounts.end(), 0 );
+        for ( uint32 face = 0; face < faceCount; face++ )
+            for ( uint32 vertex : faces[ face ].indices )
+                adjacency[ adjacencyOffsets[ vertex ] + liveCounts[ vertex ]++ ] = face;
+
+        TArray<uint8> isUsed( faceCount, 0 );
+        TArray<uint8> meshletSlots( vertexCount, kNotInMeshlet );
+
+        auto RemoveFace = [ & ]( uint32 face )
+        {
+            isUsed[ face ] = 1;
+            for ( uint32 vertex : faces[ face ].indices )
+            {
+                uint32* live = adjacency.data() + adjacencyOffsets[ vertex ];
+                uint32* liveEnd = live + liveCounts[ vertex ];
+                uint32* found = std::find( live, liveEnd, face );
+                if ( found != liveEnd )
+                {
+                    *found = *(liveEnd - 1);
+                    liveCounts[ vertex ]--;
+                }
+            }
+        };
+
+        TArray<std::pair<int32, Subdivision>> ranges;
+        if ( mesh.subdivisionsMap.empty() )
+            ranges.emplace_back( 0, Subdivision{ 0, 0, 0, faceCount * 3 } );
+        for ( const auto& [ subdivisionKey, subdivision ] : mesh.subdivisionsMap )
+            ranges.emplace_back( subdivisionKey, subdivision );
+
+        for ( const auto& [ subdivisionKey, subdivision ] : ranges )
+        {
+            const uint32 firstFace = std::min( subdivision.baseIndex / 3, faceCount );
+            const uint32 endFace = std::min( firstFace + subdivision.indexCount / 3, faceCount );
+            uint32 seedFace = firstFace;
+
+            Meshlet meshlet;
+            Vector3f positionSum;
+            auto StartMeshlet = [ & ]()
+            {
+                meshlet = Meshlet();
+                meshlet.vertexOffset = (uint32)mesh.meshletVertices.size();
+                meshlet.indexOffset = (uint32)mesh.meshletIndices.size();
+                meshlet.subdivisionKey = subdivisionKey;
+                positionSum = Vector3f( 0.F );
+            };
+            auto FinishMeshlet = [ & ]()
+            {
+                if ( meshlet.triangleCount == 0 )
+                    return;
+                for ( uint32 vertex = 0; vertex < meshlet.vertexCount; vertex++ )
+                    meshletSlots[ mesh.meshletVertices[ meshlet.vertexOffset + vertex ] ] = kNotInMeshlet;
+                ComputeMeshletBounds( meshlet, mesh, positions );
+                mesh.meshlets.push_back( meshlet );
+                StartMeshlet();
+            };
+
+            StartMeshlet();
+            while ( true )
+            {
+                // Faces around the meshlet that add the fewest vertices, then the closest to its center. Faces that are
+                // the last one left around a vertex go first, later they would start meshlets of their own
+                uint32 bestFace = kInvalidIndex;
+                uint32 bestPriority = UINT32_MAX;
+                float bestDistance = FLT_MAX;
+                const Vector3f center = meshlet.vertexCount > 0 ? positionSum / (float)meshlet.vertexCount : positionSum;
+                for ( uint32 vertex = 0; vertex < meshlet.vertexCount; vertex++ )
+                {
+                    const uint32 meshVertex = mesh.meshletVertices[ meshlet.vertexOffset + vertex ];
+                    const uint32* live = adjacency.data() + adjacencyOffsets[ meshVertex ];
+                    for ( uint32 i = 0; i < liveCounts[ meshVertex ]; i++ )
+                    {
+                        const uint32 face = live[ i ];
+                        if ( face < firstFace || face >= endFace )
+                            continue;
+
+                        const MeshFace& candidate = faces[ face ];
+                        const uint32 newVertices =
+                            (meshletSlots[ candidate.indx0 ] == kNotInMeshlet) +
+                            (meshletSlots[ candidate.indx1 ] == kNotInMeshlet) +
+                            (meshletSlots[ candidate.indx2 ] == kNotInMeshlet);
+                        if ( meshlet.vertexCount + newVertices > MaxVertices )
+                            continue;
+
+                        const bool isDangling = liveCounts[ candidate.indx0 ] == 1 || liveCounts[ candidate.indx1 ] == 1 || liveCounts[ candidate.indx2 ] == 1;
+                        const uint32 priority = newVertices == 0 ? 0 : isDangling ? 1 : newVertices + 1;
+                        if ( priority > bestPriority )
+                            continue;
+
+                        const Vector3f centroid = (positions[ candidate.indx0 ] + positions[ candidate.indx1 ] + positions[ candidate.indx2 ]) / 3.F;
+                        const float distance = (centroid - center).MagnitudeSquared();
+                        if ( priority < bestPriority || distance < bestDistance )
+                        {
+                            bestFace = face;
+                            bestPriority = priority;
+                            bestDistance = distance;
+                        }
+                    }
+                }
+
+                // A meshlet with nothing around that fits is done, a new one starts at the next free face
+                if ( bestFace == kInvalidIndex )
+                {
+                    if ( meshlet.triangleCount > 0 )
+                    {
+                        FinishMeshlet();
+                        continue;
+                    }
+                    while ( seedFace < endFace && isUsed[ seedFace ] )
+                        seedFace++;
+                    if ( seedFace == endFace )
+                        break;
+                    bestFace = seedFace;
+                }
+
+                for ( uint32 vertex : faces[ bestFace ].indices )
+                {
+                    if ( meshletSlots[ vertex ] == kNotInMeshlet )
+                    {
+                        meshletSlots[ vertex ] = (uint8)meshlet.vertexCount++;
+                        mesh.meshletVertices.push_back( vertex );
+                        positionSum += positions[ vertex ];
+                    }
+                    mesh.meshletIndices.push_back( meshletSlots[ vertex ] );
+                }
+                meshlet.triangleCount++;
+                RemoveFace( bestFace );
+
+                if ( meshlet.triangleCount == MaxTriangles )
+                    FinishMeshlet();
+            }
+            FinishMeshlet();
+        }
+        return (uint32)mesh.meshlets.size();
+    }
+}
@@ -4,6 +4,7 @@
 #include "Math/CoreMath.h"
 #include "Rendering/Common.h"
 #include "Rendering/PixelMap.h"
+#include "Utils/Memory.h"
 
 namespace EE
 {
@@ -155,7 +156,7 @@ namespace EE
     {
         if ( _data )
         {
-            free( _data );
+            Memory::TaggedFree( _data );
             _data = NULL;
         }
     }
@@ -207,7 +208,7 @@ namespace EE
             return;
         }
 
-        *data = malloc( size );
+        *data = Memory::TaggedAlloc( size, 16, Memory::MemoryTag_PixelMap );
     }
 
     void PixelMapUtility::CreateData( int32 width, int32 height, int32 depth, EPixelFormat pixelFormat, void** target, const void* data )
@@ -3,15 +3,13 @@
 
 #include <Resources/ImageImporter.h>
 #include "Resources/PNGImporter.h"
+#include "Resources/ResourceLoader.h"
 
 #include "Utils/TextFormatting.h"
 
 namespace EE
 {
-    bool ImageImporter::sTaskRunning;
-    std::queue<ImageImporter::Task*> ImageImporter::sPendingTasks = std::queue<Task*>();
-    std::future<bool> ImageImporter::sCurrentFutureTask;
-    std::mutex sImageImporterQueueLock;
+    TArray<LoadHandle> ImageImporter::sAsyncTasks;
 
     bool ImageImporter::RecognizeFileExtensionAndLoad( ImageResult& info, const Options& options )
     {
@@ -25,84 +23,61 @@ namespace EE
 
     bool ImageImporter::Initialize()
     {
-        if ( std::thread::hardware_concurrency() <= 1 )
-        {
-            EE_LOG_WARN( "The aviable cores ({:d}) are insuficient for asyncronus loaders", std::thread::hardware_concurrency() );
-            return false;
-        }
-
-        return true;
+        return ResourceLoader::Initialize();
     }
 
     void ImageImporter::UpdateStatus()
     {
-        if ( !sTaskRunning )
-        {
-            FinishCurrentAsyncTask();
-        }
-        if ( !sPendingTasks.empty() && !sCurrentFutureTask.valid() && !sTaskRunning )
-        {
-            sPendingTasks.front()->Start( sCurrentFutureTask );
-        }
+        ResourceLoader::UpdateStatus();
+        std::erase_if( sAsyncTasks, []( const LoadHandle& task ) { return task->HasCompleted(); } );
     }
 
     void ImageImporter::FinishAsyncTasks()
     {
-        do
-        {
-            FinishCurrentAsyncTask();
-            UpdateStatus();
-        } while ( !sPendingTasks.empty() );
-    }
-
-    void ImageImporter::FinishCurrentAsyncTask()
-    {
-        if ( !sPendingTasks.empty() && sCurrentFutureTask.valid() )
+        // Callbacks may queue more loads, those are waited too
+        while ( sAsyncTasks.empty() == false )
         {
-            sCurrentFutureTask.get();
-            sPendingTasks.front()->Finish();
-            delete sPendingTasks.front();
-            sPendingTasks.pop();
+            ResourceLoader::Wait( sAsyncTasks.front() );
+            std::erase_if( sAsyncTasks, []( const LoadHandle& task ) { return task->HasCompleted(); } );
         }
     }
 
     size_t ImageImporter::GetAsyncTaskCount()
     {
-        return sPendingTasks.size();
+        return sAsyncTasks.size();
     }
 
     void ImageImporter::Exit()
     {
-        if ( sCurrentFutureTask.valid() )
-            sCurrentFutureTask.get();
+        for ( LoadHandle& task : sAsyncTasks )
+        {
+            task->Cancel();
+        }
+        FinishAsyncTasks();
+        ResourceLoader::Exit();
     }
 
     bool ImageImporter::Load( ImageResult& info, const Options& options )
     {
         if ( options.file.IsValid() == false ) return false;
 
-        if ( sTaskRunning )
-        {
-            FinishCurrentAsyncTask();
-        }
-
-        sTaskRunning = true;
         EE_LOG_INFO( "Reading File Image '{}'", options.file.GetShortPath() );
         RecognizeFileExtensionAndLoad( info, options );
-        sTaskRunning = false;
         return info.IsValid();
     }
 
-    void ImageImporter::LoadAsync( const Options& options, FinishTaskFunction then )
+    LoadHandle ImageImporter::LoadAsync( const Options& options, FinishTaskFunction then, ELoadPriority priority )
     {
-        if ( options.file.IsValid() == false ) return;
+        if ( options.file.IsValid() == false ) return NULL;
 
-        sPendingTasks.push(
-            new Task{ options, then, []( ImageResult& data, const Options& options, std::future<bool>& futureTask )
-            {
-                futureTask = std::async( std::launch::async, Load, std::ref( data ),  std::ref( options ) );
-            } }
+        std::shared_ptr<Task> task = std::make_shared<Task>( options, then );
+        LoadHandle handle = ResourceLoader::Submit(
+            priority,
+            [ task ]() { return task->Run(); },
+            [ task ]( ELoadState state ) { task->Finish( state ); }
         );
+        sAsyncTasks.push_back( handle );
+        return handle;
     }
 
     ImageImporter::ImageResult::ImageResult()
@@ -136,18 +111,19 @@ namespace EE
         _isValid = true;
     }
 
-    ImageImporter::Task::Task( const Options& options, FinishTaskFunction finishTaskFunction, FutureTask futureTask ) :
-        _result(), _options( options ), _finishTaskFunction( finishTaskFunction ), _futureTask( futureTask )
+    ImageImporter::Task::Task( const Options& options, FinishTaskFunction finishTaskFunction ) :
+        _file( options.file ), _options{ _file, options.format }, _result(), _finishTaskFunction( finishTaskFunction )
     {
     }
 
-    void ImageImporter::Task::Start( std::future<bool>& task )
+    bool ImageImporter::Task::Run()
     {
-        _futureTask( _result, _options, task );
+        return Load( _result, _options );
     }
 
-    void ImageImporter::Task::Finish()
+    void ImageImporter::Task::Finish( ELoadState state )
     {
-        _finishTaskFunction( _result );
+        if ( state != LoadState_Canceled && _finishTaskFunction )
+            _finishTaskFunction( _result );
     }
 }
\ No newline at end of file
@@ -0,0 +1,710 @@
+#include "CoreMinimal.h"
+
+#include "Utils/Hasher.h"
+#include "Files/FileManager.h"
+#include "Files/MappedFileView.h"
+#include "Resources/MeshCache.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+namespace EE
+{
+    // "EEMC" in little endian, a cache from a machine with other endianness fails here
+    constexpr uint32 kMeshCacheMagic = 0x434D4545;
+    constexpr uint64 kMeshCacheAlignment = 16;
+
+    enum EMeshCacheFlags
+    {
+        MeshCacheFlag_Normals = 1 << 0,
+        MeshCacheFlag_Tangents = 1 << 1,
+        MeshCacheFlag_VertexColor = 1 << 2,
+        MeshCacheFlag_BoundingBox = 1 << 3,
+        MeshCacheFlag_Bones = 1 << 4,
+    };
+
+    enum EMeshCacheOptions
+    {
+        MeshCacheOption_Optimize = 1 << 0,
+        MeshCacheOption_Meshlets = 1 << 1,
+        //* The LOD count of the options is stored from this bit up
+        MeshCacheOption_LODCountShift = 8,
+    };
+
+    // Every offset is from the start of the file, string offsets are from the start of the strings section
+    struct MeshCacheString
+    {
+        uint32 offset;
+        uint32 length;
+    };
+
+    struct MeshCacheHeader
+    {
+        uint32 magic;
+        uint32 version;
+        MeshCache::SourceKey source;
+        uint32 meshCount;
+        uint32 nodeCount;
+        uint32 materialCount;
+        uint32 dependencyCount;
+        uint64 meshesOffset;
+        uint64 nodesOffset;
+        uint64 materialsOffset;
+        uint64 dependenciesOffset;
+        uint64 stringsOffset;
+        uint64 stringsSize;
+        uint64 fileSize;
+    };
+
+    struct MeshCacheMesh
+    {
+        MeshCacheString name;
+        uint64 staticVerticesOffset;
+        uint64 skinVerticesOffset;
+        uint64 facesOffset;
+        uint64 subdivisionsOffset;
+        uint64 materialsOffset;
+        uint64 lodsOffset;
+        uint64 meshletsOffset;
+        uint64 meshletVerticesOffset;
+        uint64 meshletIndicesOffset;
+        uint32 staticVertexCount;
+        uint32 skinVertexCount;
+        uint32 faceCount;
+        uint32 subdivisionCount;
+        uint32 materialCount;
+        uint32 lodCount;
+        uint32 meshletCount;
+        uint32 meshletVertexCount;
+        uint32 meshletIndexCount;
+        int32 uvChannels;
+        uint32 flags;
+        float bounding[ 6 ];
+    };
+
+    struct MeshCacheSubdivision
+    {
+        int32 key;
+        Subdivision subdivision;
+    };
+
+    // Subdivisions of a level are stored as the ones of the mesh
+    struct MeshCacheLOD
+    {
+        uint64 subdivisionsOffset;
+        uint32 subdivisionCount;
+        uint32 baseIndex;
+        uint32 indexCount;
+        float error;
+    };
+
+    struct MeshCacheMeshlet
+    {
+        uint32 vertexOffset;
+        uint32 vertexCount;
+        uint32 indexOffset;
+        uint32 triangleCount;
+        int32 subdivisionKey;
+        float center[ 3 ];
+        float radius;
+        float coneApex[ 3 ];
+        float coneAxis[ 3 ];
+        float coneCutoff;
+    };
+
+    struct MeshCacheMaterial
+    {
+        int32 key;
+        MeshCacheString name;
+    };
+
+    // Textures in the order of kMaterialTextures
+    struct MeshCacheMaterialData
+    {
+        MeshCacheString name;
+        float ambientColor[ 3 ];
+        float diffuseColor[ 3 ];
+        float specularColor[ 3 ];
+        float emissiveColor[ 3 ];
+        float specularExponent;
+        float opacity;
+        float refractionIndex;
+        int32 illuminationModel;
+        MeshCacheString textures[ 6 ];
+    };
+
+    // Other file read by the importer, the cache is stale once its size or write time changes
+    struct MeshCacheDependency
+    {
+        MeshCacheString path;
+        uint64 size;
+        int64 writeTime;
+    };
+
+    static U8String MaterialData::* const kMaterialTextures[] =
+    {
+        &MaterialData::ambientTexture, &MaterialData::diffuseTexture, &MaterialData::specularTexture,
+        &MaterialData::emissiveTexture, &MaterialData::alphaTexture, &MaterialData::normalTexture
+    };
+
+    // Nodes are stored depth first so a parent always comes before its children, the root has no parent
+    struct MeshCacheNode
+    {
+        MeshCacheString name;
+        int32 parent;
+        uint32 hasMesh;
+        uint64 meshKey;
+        double position[ 3 ];
+        double rotation[ 4 ];
+        double scale[ 3 ];
+    };
+
+    static_assert( std::is_trivially_copyable_v<MeshCacheHeader> && std::is_trivially_copyable_v<MeshCacheMesh> && std::is_trivially_copyable_v<MeshCacheNode> );
+    static_assert( std::size( kMaterialTextures ) == std::size( MeshCacheMaterialData{}.textures ) );
+    static_assert( sizeof( StaticVertex ) == sizeof( float ) * 17 && sizeof( MeshFace ) == sizeof( uint32 ) * 3, "Mesh layout changed, increase MeshCache::Version" );
+
+    struct MeshCacheWriter
+    {
+        TArray<uint8> data;
+        TArray<U8Char> strings;
+
+        uint64 Reserve( uint64 size )
+        {
+            const uint64 offset = (data.size() + kMeshCacheAlignment - 1) & ~(kMeshCacheAlignment - 1);
+            data.resize( offset + size );
+            return offset;
+        }
+
+        uint64 Append( const void* source, uint64 size )
+        {
+            const uint64 offset = Reserve( size );
+            if ( size > 0 )
+                memcpy( data.data() + offset, source, size );
+            return offset;
+        }
+
+        template<typename T>
+        T* At( uint64 offset ) { return reinterpret_cast<T*>( data.data() + offset ); }
+
+        MeshCacheString AddString( std::string_view text )
+        {
+            MeshCacheString string = { (uint32)strings.size(), (uint32)text.size() };
+            strings.insert( strings.end(), text.begin(), text.end() );
+            return string;
+        }
+    };
+
+    // A missing file has a zero stamp, so one that appears later also makes the cache stale
+    static void GetFileStamp( const U8String& path, uint64* outSize, int64* outWriteTime )
+    {
+        std::error_code error;
+        const uint64 size = std::filesystem::file_size( path, error );
+        *outSize = error ? 0 : size;
+        const std::filesystem::file_time_type writeTime = std::filesystem::last_write_time( path, error );
+        *outWriteTime = error ? 0 : (int64)writeTime.time_since_epoch().count();
+    }
+
+    static void CollectNodes( const ModelNode* node, int32 parent, TArray<std::pair<const ModelNode*, int32>>& outNodes )
+    {
+        const int32 index = (int32)outNodes.size();
+        outNodes.emplace_back( node, parent );
+        for ( const ModelNode* child : node->children )
+            CollectNodes( child, index, outNodes );
+    }
+
+    static bool IsRangeInside( uint64 begin, uint64 count, uint64 end )
+    {
+        return begin <= end && count <= end - begin;
+    }
+
+    static bool AreSubdivisionsInside( const TFlatMap<int32, Subdivision>& subdivisions, uint64 baseIndex, uint64 indexCount )
+    {
+        for ( const auto& [ key, subdivision ] : subdivisions )
+        {
+            if ( subdivision.baseIndex < baseIndex || IsRangeInside( subdivision.baseIndex, subdivision.indexCount, baseIndex + indexCount ) == false )
+                return false;
+        }
+        return true;
+    }
+
+    // Sections are only checked to be inside the file, a damaged cache can still have consistent sizes with
+    // indices that point anywhere. Everything later indexed without checks is validated here
+    static bool IsMeshInRange( const MeshData& mesh )
+    {
+        const uint64 vertexCount = mesh.GetVertexCount();
+        for ( const MeshFace& face : mesh.faces )
+        {
+            if ( face.indx0 >= vertexCount || face.indx1 >= vertexCount || face.indx2 >= vertexCount )
+                return false;
+        }
+
+        const uint64 indexCount = mesh.faces.size() * 3;
+        uint64 levelEnd = indexCount;
+        for ( size_t i = mesh.lods.size(); i-- > 0; )
+        {
+            const MeshLOD& lod = mesh.lods[ i ];
+            if ( lod.baseIndex % 3 != 0 || IsRangeInside( lod.baseIndex, lod.indexCount, levelEnd ) == false
+                || AreSubdivisionsInside( lod.subdivisionsMap, lod.baseIndex, lod.indexCount ) == false )
+                return false;
+            levelEnd = lod.baseIndex;
+        }
+        if ( AreSubdivisionsInside( mesh.subdivisionsMap, 0, mesh.GetBaseFaceCount() * 3 ) == false )
+            return false;
+
+        for ( const Meshlet& meshlet : mesh.meshlets )
+        {
+            if ( IsRangeInside( meshlet.vertexOffset, meshlet.vertexCount, mesh.meshletVertices.size() ) == false
+                || IsRangeInside( meshlet.indexOffset, (uint64)meshlet.triangleCount * 3, mesh.meshletIndices.size() ) == false )
+                return false;
+            for ( uint32 i = 0; i < meshlet.triangleCount * 3; i++ )
+            {
+                if ( mesh.meshletIndices[ meshlet.indexOffset + i ] >= meshlet.vertexCount )
+                    return false;
+            }
+        }
+        for ( uint32 vertex : mesh.meshletVertices )
+        {
+            if ( vertex >= vertexCount )
+                return false;
+        }
+        return true;
+    }
+
+    U8String MeshCache::GetCachePath( const File& source )
+    {
+        return source.GetPath() + ".eemesh";
+    }
+
+    bool MeshCache::ComputeSourceKey( const ModelImporter::Options& options, SourceKey& outKey )
+    {
+        std::error_code error;
+        const std::filesystem::file_time_type writeTime = std::filesystem::last_write_time( options.file.GetPath(), error );
+        if ( error )
+            return false;
+
+        MappedFileView view( options.file, MappedFileHint_Sequential );
+        if ( view.GetError() != 0 )
+            return false;
+
+        outKey = {};
+        outKey.size = view.GetSize();
+        outKey.writeTime = (int64)writeTime.time_since_epoch().count();
+        outKey.hash = HashBytes( view.GetData().data(), view.GetData().size() );
+        outKey.options =
+            (options.optimize ? MeshCacheOption_Optimize : 0) |
+            (options.buildMeshlets ? MeshCacheOption_Meshlets : 0) |
+            (options.lodCount << MeshCacheOption_LODCountShift);
+        return true;
+    }
+
+    bool MeshCache::Load( ModelImporter::ModelResult& result, const File& source, const SourceKey& key )
+    {
+        MappedFileView view( File( GetCachePath( source ) ), MappedFileHint_Sequential );
+        if ( view.GetError() != 0 || view.GetSize() < sizeof( MeshCacheHeader ) )
+            return false;
+
+        const uint8* base = view.GetData().data();
+        const uint64 fileSize = view.GetSize();
+        const MeshCacheHeader& header = *reinterpret_cast<const MeshCacheHeader*>( base );
+        if ( header.magic != kMeshCacheMagic || header.version != Version || header.fileSize != fileSize
+            || header.source.size != key.size || header.source.writeTime != key.writeTime
+            || header.source.hash != key.hash || header.source.options != key.options )
+        {
+            return false;
+        }
+
+        // Offsets are fixed up to pointers inside the mapping, anything out of bounds means the cache is damaged
+        auto GetSection = [ & ]<typename T>( uint64 offset, uint64 count, const T** outData ) -> bool
+        {
+            if ( offset > fileSize || count > (fileSize - offset) / sizeof( T ) || offset % alignof( T ) != 0 )
+                return false;
+            *outData = reinterpret_cast<const T*>( base + offset );
+            return true;
+        };
+
+        const MeshCacheMesh* meshes;
+        const MeshCacheNode* nodes;
+        const MeshCacheMaterialData* materials;
+        const MeshCacheDependency* dependencies;
+        const U8Char* strings;
+        if ( GetSection( header.meshesOffset, header.meshCount, &meshes ) == false
+            || GetSection( header.nodesOffset, header.nodeCount, &nodes ) == false
+            || GetSection( header.materialsOffset, header.materialCount, &materials ) == false
+            || GetSection( header.dependenciesOffset, header.dependencyCount, &dependencies ) == false
+            || GetSection( header.stringsOffset, header.stringsSize, &strings ) == false
+            || header.nodeCount == 0 )
+        {
+            EE_LOG_WARN( "Mesh cache '{}' is damaged, it will be imported again", GetCachePath( source ) );
+            return false;
+        }
+
+        auto GetString = [ & ]( const MeshCacheString& string ) -> std::string_view
+        {
+            if ( string.offset > header.stringsSize || string.length > header.stringsSize - string.offset )
+                return std::string_view();
+            return std::string_view( strings + string.offset, string.length );
+        };
+
+        ModelImporter::ModelResult loaded;
+        loaded.dependencies.reserve( header.dependencyCount );
+        for ( uint32 i = 0; i < header.dependencyCount; i++ )
+        {
+            U8String& path = loaded.dependencies.emplace_back( GetString( dependencies[ i ].path ) );
+            uint64 size;
+            int64 writeTime;
+            GetFileStamp( path, &size, &writeTime );
+            if ( size != dependencies[ i ].size || writeTime != dependencies[ i ].writeTime )
+                return false;
+        }
+
+        loaded.materials.reserve( header.materialCount );
+        for ( uint32 i = 0; i < header.materialCount; i++ )
+        {
+            const MeshCacheMaterialData& cachedMaterial = materials[ i ];
+            MaterialData& material = loaded.materials.emplace_back();
+            material.name = GetString( cachedMaterial.name );
+            material.ambientColor = Vector3f( cachedMaterial.ambientColor[ 0 ], cachedMaterial.ambientColor[ 1 ], cachedMaterial.ambientColor[ 2 ] );
+            material.diffuseColor = Vector3f( cachedMaterial.diffuseColor[ 0 ], cachedMaterial.diffuseColor[ 1 ], cachedMaterial.diffuseColor[ 2 ] );
+            material.specularColor = Vector3f( cachedMaterial.specularColor[ 0 ], cachedMaterial.specularColor[ 1 ], cachedMaterial.specularColor[ 2 ] );
+            material.emissiveColor = Vector3f( cachedMaterial.emissiveColor[ 0 ], cachedMaterial.emissiveColor[ 1 ], cachedMaterial.emissiveColor[ 2 ] );
+            material.specularExponent = cachedMaterial.specularExponent;
+            material.opacity = cachedMaterial.opacity;
+            material.refractionIndex = cachedMaterial.refractionIndex;
+            material.illuminationModel = cachedMaterial.illuminationModel;
+            for ( size_t texture = 0; texture < std::size( kMaterialTextures ); texture++ )
+                material.*kMaterialTextures[ texture ] = GetString( cachedMaterial.textures[ texture ] );
+        }
+
+        loaded.meshes.reserve( header.meshCount );
+        for ( uint32 meshIndex = 0; meshIndex < header.meshCount; meshIndex++ )
+        {
+            const MeshCacheMesh& cachedMesh = meshes[ meshIndex ];
+            const StaticVertex* staticVertices;
+            const SkinVertex* skinVertices;
+            const MeshFace* faces;
+            const MeshCacheSubdivision* subdivisions;
+            const MeshCacheMaterial* meshMaterials;
+            const MeshCacheLOD* lods;
+            const MeshCacheMeshlet* meshlets;
+            const uint32* meshletVertices;
+            const uint8* meshletIndices;
+            if ( GetSection( cachedMesh.staticVerticesOffset, cachedMesh.staticVertexCount, &staticVertices ) == false
+                || GetSection( cachedMesh.skinVerticesOffset, cachedMesh.skinVertexCount, &skinVertices ) == false
+                || GetSection( cachedMesh.facesOffset, cachedMesh.faceCount, &faces ) == false
+                || GetSection( cachedMesh.subdivisionsOffset, cachedMesh.subdivisionCount, &subdivisions ) == false
+                || GetSection( cachedMesh.materialsOffset, cachedMesh.materialCount, &meshMaterials ) == false
+                || GetSection( cachedMesh.lodsOffset, cachedMesh.lodCount, &lods ) == false
+                || GetSection( cachedMesh.meshletsOffset, cachedMesh.meshletCount, &meshlets ) == false
+                || GetSection( cachedMesh.meshletVerticesOffset, cachedMesh.meshletVertexCount, &meshletVertices ) == false
+                || GetSection( cachedMesh.meshletIndicesOffset, cachedMesh.meshletIndexCount, &meshletIndices ) == false )
+            {
+                EE_LOG_WARN( "Mesh cache '{}' is damaged, it will be imported again", GetCachePath( source ) );
+                return false;
+            }
+
+            MeshData& mesh = loaded.meshes.emplace_back();
+            mesh.name = GetString( cachedMesh.name );
+            mesh.staticVertices.assign( staticVertices, staticVertices + cachedMesh.staticVertexCount );
+            mesh.skinVertices.assign( skinVertices, skinVertices + cachedMesh.skinVertexCount );
+            mesh.faces.assign( faces, faces + cachedMesh.faceCount );
+            mesh.subdivisionsMap.reserve( cachedMesh.subdivisionCount );
+            for ( uint32 i = 0; i < cachedMesh.subdivisionCount; i++ )
+                mesh.subdivisionsMap.emplace( subdivisions[ i ].key, subdivisions[ i ].subdivision );
+            for ( uint32 i = 0; i < cachedMesh.materialCount; i++ )
+                mesh.materialsMap.emplace( meshMaterials[ i ].key, GetString( meshMaterials[ i ].name ) );
+            mesh.lods.resize( cachedMesh.lodCount );
+            for ( uint32 i = 0; i < cachedMesh.lodCount; i++ )
+            {
+                const MeshCacheSubdivision* lodSubdivisions;
+                if ( GetSection( lods[ i ].subdivisionsOffset, lods[ i ].subdivisionCount, &lodSubdivisions ) == false )
+                {
+                    EE_LOG_WARN( "Mesh cache '{}' is damaged, it will be imported again", GetCachePath( source ) );
+                    return false;
+                }
+
+                MeshLOD& lod = mesh.lods[ i ];
+                lod.baseIndex = lods[ i ].baseIndex;
+                lod.indexCount = lods[ i ].indexCount;
+                lod.error = lods[ i ].error;
+                lod.subdivisionsMap.reserve( lods[ i ].subdivisionCount );
+                for ( uint32 subdivision = 0; subdivision < lods[ i ].subdivisionCount; subdivision++ )
+                    lod.subdivisionsMap.emplace( lodSubdivisions[ subdivision ].key, lodSubdivisions[ subdivision ].subdivision );
+            }
+            mesh.meshlets.resize( cachedMesh.meshletCount );
+            for ( uint32 i = 0; i < cachedMesh.meshletCount; i++ )
+            {
+                const MeshCacheMeshlet& cachedMeshlet = meshlets[ i ];
+                Meshlet& meshlet = mesh.meshlets[ i ];
+                meshlet.vertexOffset = cachedMeshlet.vertexOffset;
+                meshlet.vertexCount = cachedMeshlet.vertexCount;
+                meshlet.indexOffset = cachedMeshlet.indexOffset;
+                meshlet.triangleCount = cachedMeshlet.triangleCount;
+                meshlet.subdivisionKey = cachedMeshlet.subdivisionKey;
+                meshlet.center = Vector3f( cachedMeshlet.center[ 0 ], cachedMeshlet.center[ 1 ], cachedMeshlet.center[ 2 ] );
+                meshlet.radius = cachedMeshlet.radius;
+                meshlet.coneApex = Vector3f( cachedMeshlet.coneApex[ 0 ], cachedMeshlet.coneApex[ 1 ], cachedMeshlet.coneApex[ 2 ] );
+                meshlet.coneAxis = Vector3f( cachedMeshlet.coneAxis[ 0 ], cachedMeshlet.coneAxis[ 1 ], cachedMeshlet.coneAxis[ 2 ] );
+                meshlet.coneCutoff = cachedMeshlet.coneCutoff;
+            }
+            mesh.meshletVertices.assign( meshletVertices, meshletVertices + cachedMesh.meshletVertexCount );
+            mesh.meshletIndices.assign( meshletIndices, meshletIndices + cachedMesh.meshletIndexCount );
+
+            mesh.bounding = Box3f( cachedMesh.bounding[ 0 ], cachedMesh.bounding[ 1 ], cachedMesh.bounding[ 2 ],
+                cachedMesh.bounding[ 3 ], cachedMesh.bounding[ 4 ], cachedMesh.bounding[ 5 ] );
+            mesh.uvChannels = cachedMesh.uvChannels;
+            mesh.hasNormals = (cachedMesh.flags & MeshCacheFlag_Normals) != 0;
+            mesh.hasTangents = (cachedMesh.flags & MeshCacheFlag_Tangents) != 0;
+            mesh.hasVertexColor = (cachedMesh.flags & MeshCacheFlag_VertexColor) != 0;
+            mesh.hasBoundingBox = (cachedMesh.flags & MeshCacheFlag_BoundingBox) != 0;
+            mesh.hasBones = (cachedMesh.flags & MeshCacheFlag_Bones) != 0;
+
+            if ( IsMeshInRange( mesh ) == false )
+            {
+                EE_LOG_WARN( "Mesh cache '{}' is damaged, it will be imported again", GetCachePath( source ) );
+                return false;
+            }
+        }
+
+        TArray<ModelNode*> createdNodes( header.nodeCount );
+        for ( uint32 nodeIndex = 0; nodeIndex < header.nodeCount; nodeIndex++ )
+        {
+            const MeshCacheNode& cachedNode = nodes[ nodeIndex ];
+            ModelNode* node;
+            if ( nodeIndex == 0 )
+            {
+                node = &loaded.parentNode;
+                node->name = GetString( cachedNode.name );
+            }
+            else if ( cachedNode.parent >= 0 && (uint32)cachedNode.parent < nodeIndex )
+            {
+                node = createdNodes[ cachedNode.parent ]->AddChild( U8String( GetString( cachedNode.name ) ) );
+            }
+            else
+            {
+                EE_LOG_WARN( "Mesh cache '{}' is damaged, it will be imported again", GetCachePath( source ) );
+                return false;
+            }
+
+            // Users index the meshes with the key of every node that has one
+            if ( cachedNode.hasMesh != 0 && cachedNode.meshKey >= header.meshCount )
+            {
+                EE_LOG_WARN( "Mesh cache '{}' is damaged, it will be imported again", GetCachePath( source ) );
+                return false;
+            }
+
+            node->hasMesh = cachedNode.hasMesh != 0;
+            node->meshKey = (size_t)cachedNode.meshKey;
+            node->transform.position = Vector3( cachedNode.position[ 0 ], cachedNode.position[ 1 ], cachedNode.position[ 2 ] );
+            node->transform.rotation.w = cachedNode.rotation[ 0 ];
+            node->transform.rotation.x = cachedNode.rotation[ 1 ];
+            node->transform.rotation.y = cachedNode.rotation[ 2 ];
+            node->transform.rotation.z = cachedNode.rotation[ 3 ];
+            node->transform.scale = Vector3( cachedNode.scale[ 0 ], cachedNode.scale[ 1 ], cachedNode.scale[ 2 ] );
+            createdNodes[ nodeIndex ] = node;
+        }
+
+        loaded.isValid = true;
+        loaded.hasAnimations = false;
+        result.Transfer( loaded );
+        return true;
+    }
+
+    bool MeshCache::Save( const ModelImporter::ModelResult& result, const File& source, const SourceKey& key )
+    {
+        TArray<std::pair<const ModelNode*, int32>> sourceNodes;
+        CollectNodes( &result.parentNode, -1, sourceNodes );
+
+        MeshCacheWriter writer;
+        const uint64 headerOffset = writer.Reserve( sizeof( MeshCacheHeader ) );
+        const uint64 meshesOffset = writer.Reserve( sizeof( MeshCacheMesh ) * result.meshes.size() );
+        const uint64 nodesOffset = writer.Reserve( sizeof( MeshCacheNode ) * sourceNodes.size() );
+        const uint64 materialsOffset = writer.Reserve( sizeof( MeshCacheMaterialData ) * result.materials.size() );
+        const uint64 dependenciesOffset = writer.Reserve( sizeof( MeshCacheDependency ) * result.dependencies.size() );
+
+        for ( size_t materialIndex = 0; materialIndex < result.materials.size(); materialIndex++ )
+        {
+            const MaterialData& material = result.materials[ materialIndex ];
+            MeshCacheMaterialData cachedMaterial =
+            {
+                .name = writer.AddString( material.name ),
+                .ambientColor = { material.ambientColor.x, material.ambientColor.y, material.ambientColor.z },
+                .diffuseColor = { material.diffuseColor.x, material.diffuseColor.y, material.diffuseColor.z },
+                .specularColor = { material.specularColor.x, material.specularColor.y, material.specularColor.z },
+                .emissiveColor = { material.emissiveColor.x, material.emissiveColor.y, material.emissiveColor.z },
+                .specularExponent = material.specularExponent,
+                .opacity = material.opacity,
+                .refractionIndex = material.refractionIndex,
+                .illuminationModel = material.illuminationModel,
+                .textures = {},
+            };
+            for ( size_t texture = 0; texture < std::size( kMaterialTextures ); texture++ )
+                cachedMaterial.textures[ texture ] = writer.AddString( material.*kMaterialTextures[ texture ] );
+            writer.At<MeshCacheMaterialData>( materialsOffset )[ materialIndex ] = cachedMaterial;
+        }
+
+        for ( size_t dependencyIndex = 0; dependencyIndex < result.dependencies.size(); dependencyIndex++ )
+        {
+            MeshCacheDependency dependency = { .path = writer.AddString( result.dependencies[ dependencyIndex ] ), .size = 0, .writeTime = 0 };
+            GetFileStamp( result.dependencies[ dependencyIndex ], &dependency.size, &dependency.writeTime );
+            writer.At<MeshCacheDependency>( dependenciesOffset )[ dependencyIndex ] = dependency;
+        }
+
+        for ( size_t meshIndex = 0; meshIndex < result.meshes.size(); meshIndex++ )
+        {
+            const MeshData& mesh = result.meshes[ meshIndex ];
+
+            // Vertices are always stored interleaved, the importer moves them to the streams again after loading
+            MeshVertices streamedStaticVertices;
+            MeshSkinVertices streamedSkinVertices;
+            if ( mesh.vertexLayout == MeshVertexLayout_Streams && mesh.vertexStreams.HasBones() )
+                mesh.vertexStreams.CopyTo( streamedSkinVertices );
+            else if ( mesh.vertexLayout == MeshVertexLayout_Streams )
+                mesh.vertexStreams.CopyTo( streamedStaticVertices );
+            const MeshVertices& staticVertices = mesh.vertexLayout == MeshVertexLayout_Streams ? streamedStaticVertices : mesh.staticVertices;
+            const MeshSkinVertices& skinVertices = mesh.vertexLayout == MeshVertexLayout_Streams ? streamedSkinVertices : mesh.skinVertices;
+
+            MeshCacheMesh cachedMesh = {};
+            cachedMesh.name = writer.AddString( mesh.name );
+            cachedMesh.staticVertexCount = (uint32)staticVertices.size();
+            cachedMesh.staticVerticesOffset = writer.Append( staticVertices.data(), sizeof( StaticVertex ) * staticVertices.size() );
+            cachedMesh.skinVertexCount = (uint32)skinVertices.size();
+            cachedMesh.skinVerticesOffset = writer.Append( skinVertices.data(), sizeof( SkinVertex ) * skinVertices.size() );
+            cachedMesh.faceCount = (uint32)mesh.faces.size();
+            cachedMesh.facesOffset = writer.Append( mesh.faces.data(), sizeof( MeshFace ) * mesh.faces.size() );
+
+            cachedMesh.subdivisionCount = (uint32)mesh.subdivisionsMap.size();
+            cachedMesh.subdivisionsOffset = writer.Reserve( sizeof( MeshCacheSubdivision ) * mesh.subdivisionsMap.size() );
+            MeshCacheSubdivision* subdivisions = writer.At<MeshCacheSubdivision>( cachedMesh.subdivisionsOffset );
+            for ( const auto& [ subdivisionKey, subdivision ] : mesh.subdivisionsMap )
+                *subdivisions++ = { subdivisionKey, subdivision };
+
+            cachedMesh.materialCount = (uint32)mesh.materialsMap.size();
+            cachedMesh.materialsOffset = writer.Reserve( sizeof( MeshCacheMaterial ) * mesh.materialsMap.size() );
+            uint32 materialIndex = 0;
+            for ( const auto& [ materialKey, materialName ] : mesh.materialsMap )
+            {
+                const MeshCacheString name = writer.AddString( materialName );
+                writer.At<MeshCacheMaterial>( cachedMesh.materialsOffset )[ materialIndex++ ] = { materialKey, name };
+            }
+
+            cachedMesh.lodCount = (uint32)mesh.lods.size();
+            cachedMesh.lodsOffset = writer.Reserve( sizeof( MeshCacheLOD ) * mesh.lods.size() );
+            for ( size_t lodIndex = 0; lodIndex < mesh.lods.size(); lodIndex++ )
+            {
+                const MeshLOD& lod = mesh.lods[ lodIndex ];
+                MeshCacheLOD cachedLOD = {};
+                cachedLOD.subdivisionCount = (uint32)lod.subdivisionsMap.size();
+                cachedLOD.subdivisionsOffset = writer.Reserve( sizeof( MeshCacheSubdivision ) * lod.subdivisionsMap.size() );
+                cachedLOD.baseIndex = lod.baseIndex;
+                cachedLOD.indexCount = lod.indexCount;
+                cachedLOD.error = lod.error;
+                MeshCacheSubdivision* lodSubdivisions = writer.At<MeshCacheSubdivision>( cachedLOD.subdivisionsOffset );
+                for ( const auto& [ subdivisionKey, subdivision ] : lod.subdivisionsMap )
+                    *lodSubdivisions++ = { subdivisionKey, subdivision };
+                writer.At<MeshCacheLOD>( cachedMesh.lodsOffset )[ lodIndex ] = cachedLOD;
+            }
+
+            cachedMesh.meshletCount = (uint32)mesh.meshlets.size();
+            cachedMesh.meshletsOffset = writer.Reserve( sizeof( MeshCacheMeshlet ) * mesh.meshlets.size() );
+            for ( size_t meshletIndex = 0; meshletIndex < mesh.meshlets.size(); meshletIndex++ )
+            {
+                const Meshlet& meshlet = mesh.meshlets[ meshletIndex ];
+                const MeshCacheMeshlet cachedMeshlet =
+                {
+                    .vertexOffset = meshlet.vertexOffset,
+                    .vertexCount = meshlet.vertexCount,
+                    .indexOffset = meshlet.indexOffset,
+                    .triangleCount = meshlet.triangleCount,
+                    .subdivisionKey = meshlet.subdivisionKey,
+                    .center = { meshlet.center.x, meshlet.center.y, meshlet.center.z },
+                    .radius = meshlet.radius,
+                    .coneApex = { meshlet.coneApex.x, meshlet.coneApex.y, meshlet.coneApex.z },
+                    .coneAxis = { meshlet.coneAxis.x, meshlet.coneAxis.y, meshlet.coneAxis.z },
+                    .coneCutoff = meshlet.coneCutoff,
+                };
+                writer.At<MeshCacheMeshlet>( cachedMesh.meshletsOffset )[ meshletIndex ] = cachedMeshlet;
+            }
+            cachedMesh.meshletVertexCount = (uint32)mesh.meshletVertices.size();
+            cachedMesh.meshletVerticesOffset = writer.Append( mesh.meshletVertices.data(), sizeof( uint32 ) * mesh.meshletVertices.size() );
+            cachedMesh.meshletIndexCount = (uint32)mesh.meshletIndices.size();
+            cachedMesh.meshletIndicesOffset = writer.Append( mesh.meshletIndices.data(), mesh.meshletIndices.size() );
+
+            const Box3f& bounding = mesh.bounding;
+            const float boundingValues[ 6 ] = { bounding.minX, bounding.minY, bounding.minZ, bounding.maxX, bounding.maxY, bounding.maxZ };
+            memcpy( cachedMesh.bounding, boundingValues, sizeof( boundingValues ) );
+            cachedMesh.uvChannels = mesh.uvChannels;
+            cachedMesh.flags =
+                (mesh.hasNormals ? MeshCacheFlag_Normals : 0) |
+                (mesh.hasTangents ? MeshCacheFlag_Tangents : 0) |
+                (mesh.hasVertexColor ? MeshCacheFlag_VertexColor : 0) |
+                (mesh.hasBoundingBox ? MeshCacheFlag_BoundingBox : 0) |
+                (mesh.hasBones ? MeshCacheFlag_Bones : 0);
+            writer.At<MeshCacheMesh>( meshesOffset )[ meshIndex ] = cachedMesh;
+        }
+
+        for ( size_t nodeIndex = 0; nodeIndex < sourceNodes.size(); nodeIndex++ )
+        {
+            const ModelNode* node = sourceNodes[ nodeIndex ].first;
+            const Transform& transform = node->transform;
+            MeshCacheNode cachedNode =
+            {
+                .name = writer.AddString( node->name ),
+                .parent = sourceNodes[ nodeIndex ].second,
+                .hasMesh = node->hasMesh ? 1u : 0u,
+                .meshKey = (uint64)node->meshKey,
+                .position = { transform.position.x, transform.position.y, transform.position.z },
+                .rotation = { transform.rotation.w, transform.rotation.x, transform.rotation.y, transform.rotation.z },
+                .scale = { transform.scale.x, transform.scale.y, transform.scale.z },
+            };
+            writer.At<MeshCacheNode>( nodesOffset )[ nodeIndex ] = cachedNode;
+        }
+
+        const uint64 stringsOffset = writer.Append( writer.strings.data(), writer.strings.size() );
+
+        MeshCacheHeader header = {};
+        header.magic = kMeshCacheMagic;
+        header.version = Version;
+        header.source = key;
+        header.meshCount = (uint32)result.meshes.size();
+        header.nodeCount = (uint32)sourceNodes.size();
+        header.materialCount = (uint32)result.materials.size();
+        header.dependencyCount = (uint32)result.dependencies.size();
+        header.meshesOffset = meshesOffset;
+        header.nodesOffset = nodesOffset;
+        header.materialsOffset = materialsOffset;
+        header.dependenciesOffset = dependenciesOffset;
+        header.stringsOffset = stringsOffset;
+        header.stringsSize = writer.strings.size();
+        header.fileSize = writer.data.size();
+        *writer.At<MeshCacheHeader>( headerOffset ) = header;
+
+        // Written aside and renamed so a reader never maps a half written cache,
+        // the thread goes in the name since two loaders may import the same model at once
+        const U8String cachePath = GetCachePath( source );
+        const U8String temporaryPath = cachePath + "." + std::to_string( std::hash<std::thread::id>()( std::this_thread::get_id() ) ) + ".tmp";
+        {
+            std::ofstream stream( temporaryPath, std::ios::binary | std::ios::trunc );
+            stream.write( reinterpret_cast<const char*>( writer.data.data() ), (std::streamsize)writer.data.size() );
+            if ( !stream )
+            {
+                EE_LOG_WARN( "Error writing mesh cache '{}'", cachePath );
+                stream.close();
+                std::error_code error;
+                std::filesystem::remove( temporaryPath, error );
+                return false;
+            }
+        }
+
+        std::error_code error;
+        std::filesystem::rename( temporaryPath, cachePath, error );
+        if ( error )
+        {
+            EE_LOG_WARN( "Error writing mesh cache '{}', {}", cachePath, error.message() );
+            std::filesystem::remove( temporaryPath, error );
+            return false;
+        }
+        return true;
+    }
+}
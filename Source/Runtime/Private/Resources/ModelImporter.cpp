@@ -2,34 +2,54 @@
 #include "CoreMinimal.h"
 
 #include "Utils/Hasher.h"
+#include "Utils/Memory.h"
 #include "Rendering/Mesh.h"
 #include "Files/FileManager.h"
 #include "Resources/ModelImporter.h"
 #include "Resources/OBJImporter.h"
+#include "Resources/MeshCache.h"
+#include "Resources/ResourceLoader.h"
 
 #include "Utils/TextFormatting.h"
 
-#include <future>
 #include <thread>
 
 namespace EE
 {
-    bool ModelImporter::sTaskRunning;
-    std::queue<ModelImporter::Task*> ModelImporter::sPendingTasks = std::queue<Task*>();
-    std::future<bool> ModelImporter::sCurrentFutureTask;
-    std::mutex ModelImporterQueueLock;
+    TArray<LoadHandle> ModelImporter::sAsyncTasks;
+
+    // Nodes are created from the loader threads
+    static Memory::TPool<ModelNode, true> GModelNodePool( Memory::MemoryTag_Importer );
+
+    ModelNode* ModelNode::Create( const U8String& name )
+    {
+        return GModelNodePool.Acquire( name );
+    }
+
+    void ModelNode::Destroy( ModelNode* node )
+    {
+        GModelNodePool.Release( node );
+    }
 
     ModelNode& ModelNode::operator=( const ModelNode& other )
     {
+        // The children are destroyed before copying the ones of other
+        if ( this == &other )
+            return *this;
+
         name = other.name;
         transform = other.transform;
         hasMesh = other.hasMesh;
         meshKey = other.meshKey;
         parent = NULL;
+        for ( auto& child : children )
+        {
+            Destroy( child );
+        }
         children.clear();
         for ( auto& otherChild : other.children )
         {
-            ModelNode* child = new ModelNode( name );
+            ModelNode* child = Create( name );
             *child = *otherChild;
             child->parent = this;
             children.push_back( child );
@@ -65,113 +85,117 @@ namespace EE
 
     bool ModelImporter::Initialize()
     {
-        if ( std::thread::hardware_concurrency() <= 1 )
-        {
-            EE_LOG_WARN( "The aviable cores ({:d}) are insuficient for asyncronus loaders", std::thread::hardware_concurrency() );
-            return false;
-        }
-
-        return true;
+        return ResourceLoader::Initialize();
     }
 
     void ModelImporter::UpdateStatus()
     {
-        if ( !sTaskRunning )
-        {
-            FinishCurrentAsyncTask();
-        }
-        if ( !sPendingTasks.empty() && !sCurrentFutureTask.valid() && !sTaskRunning )
-        {
-            sPendingTasks.front()->Start( sCurrentFutureTask );
-        }
+        ResourceLoader::UpdateStatus();
+        std::erase_if( sAsyncTasks, []( const LoadHandle& task ) { return task->HasCompleted(); } );
     }
 
     void ModelImporter::FinishAsyncTasks()
     {
-        do
-        {
-            FinishCurrentAsyncTask();
-            UpdateStatus();
-        } while ( !sPendingTasks.empty() );
-    }
-
-    void ModelImporter::FinishCurrentAsyncTask()
-    {
-        if ( !sPendingTasks.empty() && sCurrentFutureTask.valid() )
+        // Callbacks may queue more loads, those are waited too
+        while ( sAsyncTasks.empty() == false )
         {
-            sCurrentFutureTask.get();
-            sPendingTasks.front()->Finish();
-            delete sPendingTasks.front();
-            sPendingTasks.pop();
+            ResourceLoader::Wait( sAsyncTasks.front() );
+            std::erase_if( sAsyncTasks, []( const LoadHandle& task ) { return task->HasCompleted(); } );
         }
     }
 
     size_t ModelImporter::GetAsyncTaskCount()
     {
-        return sPendingTasks.size();
+        return sAsyncTasks.size();
     }
 
     void ModelImporter::Exit()
     {
-        if ( sCurrentFutureTask.valid() )
-            sCurrentFutureTask.get();
+        for ( LoadHandle& task : sAsyncTasks )
+        {
+            task->Cancel();
+        }
+        FinishAsyncTasks();
+        ResourceLoader::Exit();
     }
 
     bool ModelImporter::Load( ModelResult& info, const Options& options )
     {
         if ( options.file.IsValid() == false ) return false;
 
-        if ( sTaskRunning )
+        EE_LOG_INFO( "Reading File Model '{}'", options.file.GetShortPath() );
+        MeshCache::SourceKey cacheKey;
+        const bool useCache = options.useCache && options.onMeshLoaded == nullptr && MeshCache::ComputeSourceKey( options, cacheKey );
+        if ( useCache && MeshCache::Load( info, options.file, cacheKey ) )
+        {
+            EE_LOG_INFO( "Loaded cached model '{}'", MeshCache::GetCachePath( options.file ) );
+            for ( MeshData& mesh : info.meshes )
+                mesh.SetVertexLayout( options.vertexLayout );
+        }
+        else if ( RecognizeFileExtensionAndLoad( info, options ) && useCache )
         {
-            FinishCurrentAsyncTask();
+            MeshCache::Save( info, options.file, cacheKey );
         }
 
-        sTaskRunning = true;
-        EE_LOG_INFO( "Reading File Model '{}'", options.file.GetShortPath() );
-        RecognizeFileExtensionAndLoad( info, options );
-        sTaskRunning = false;
+        info.packedMeshes.clear();
+        if ( info.isValid && options.packVertices )
+        {
+            info.packedMeshes.resize( info.meshes.size() );
+            for ( size_t i = 0; i < info.meshes.size(); i++ )
+                MeshPacker::Pack( info.meshes[ i ], options.packing, info.packedMeshes[ i ] );
+        }
         return info.isValid;
     }
 
-    void ModelImporter::LoadAsync( const Options& options, FinishTaskFunction then )
+    LoadHandle ModelImporter::LoadAsync( const Options& options, FinishTaskFunction then, ELoadPriority priority )
     {
-        if ( options.file.IsValid() == false ) return;
+        if ( options.file.IsValid() == false ) return NULL;
 
-        sPendingTasks.push(
-            new Task( options, then, []( ModelResult& data, const Options& options, std::future<bool>& futureTask )
-            {
-                futureTask = std::async( std::launch::async, Load, std::ref( data ),  std::ref( options ) );
-            })
+        std::shared_ptr<Task> task = std::make_shared<Task>( options, then );
+        LoadHandle handle = ResourceLoader::Submit(
+            priority,
+            [ task ]() { return task->Run(); },
+            [ task ]( ELoadState state ) { task->Finish( state ); }
         );
+        sAsyncTasks.push_back( handle );
+        return handle;
     }
 
     ModelImporter::ModelResult::ModelResult()
-        : meshes(), parentNode( "ParentNode" ), isValid( false ), hasAnimations( false )
+        : meshes(), packedMeshes(), materials(), dependencies(), parentNode( "ParentNode" ), isValid( false ), hasAnimations( false )
     {
     }
 
     void ModelImporter::ModelResult::Transfer( ModelResult& other )
     {
         meshes.clear();
+        packedMeshes.clear();
+        materials.clear();
+        dependencies.clear();
         parentNode = other.parentNode;
         meshes.swap( other.meshes );
+        packedMeshes.swap( other.packedMeshes );
+        materials.swap( other.materials );
+        dependencies.swap( other.dependencies );
         isValid = other.isValid;
         hasAnimations = other.hasAnimations;
         other.isValid = false;
     }
 
-    ModelImporter::Task::Task( const Options& options, FinishTaskFunction finishTaskFunction, FutureTask futureTask ) :
-        _result(), _options( options ), _finishTaskFunction( finishTaskFunction ), _futureTask( futureTask )
+    ModelImporter::Task::Task( const Options& options, FinishTaskFunction finishTaskFunction ) :
+        _file( options.file ), _options{ _file, options.optimize, options.parseThreadCount, options.useCache, options.onMeshLoaded, options.vertexLayout, options.lodCount, options.buildMeshlets, options.packVertices, options.packing },
+        _result(), _finishTaskFunction( finishTaskFunction )
     {
     }
 
-    void ModelImporter::Task::Start( std::future<bool>& task )
+    bool ModelImporter::Task::Run()
     {
-        _futureTask( _result, _options, task );
+        return Load( _result, _options );
     }
 
-    void ModelImporter::Task::Finish()
+    void ModelImporter::Task::Finish( ELoadState state )
     {
-        _finishTaskFunction( _result );
+        if ( state != LoadState_Canceled && _finishTaskFunction )
+            _finishTaskFunction( _result );
     }
 }
\ No newline at end of file
@@ -2,18 +2,26 @@
 #include "CoreMinimal.h"
 
 #include "Files/FileMap.h"
+#include "Files/MappedFileView.h"
 
 #include <Core/Name.h>
 #include "Engine/Ticker.h"
 #include "Utils/TextFormatting.h"
 #include "Utils/Memory.h"
-#include "Utils/Hasher.h"
 #include "Math/CoreMath.h"
 #include "Utils/TextFormattingMath.h"
+#include "Utils/TextScanner.h"
 
+#include "Core/JobSystem.h"
+#include "Rendering/MeshOptimizer.h"
+#include "Rendering/MeshSimplifier.h"
+#include "Rendering/MeshletBuilder.h"
 #include "Resources/OBJImporter.h"
+#include "Resources/ResourceLoader.h"
 
 #include <algorithm>
+#include <cctype>
+#include <numeric>
 #include <iostream>
 #include <cstring>
 #include <filesystem>
@@ -22,10 +30,13 @@
 
 constexpr size_t kBufferBlockSize = 1u << 18u;
 constexpr size_t kMaxLineSize = 1024u * 4u;
-
-#ifdef EE_MAKE_HASHABLE
-EE_MAKE_HASHABLE( EE::StaticVertex, t.position, t.normal, t.tangent, t.uv0, t.uv1, t.color )
-#endif // EE_MAKE_HASHABLE
+constexpr uint32 kReadBufferCount = 4u;
+constexpr size_t kLineScanWindowSize = 1024u * 8u;
+constexpr size_t kParallelChunkMinSize = 1u << 22u;
+// Corners handled by each welding job, and corners hashed by each welding partition
+constexpr uint32 kWeldRangeSize = 1u << 15u;
+constexpr uint32 kWeldPartitionSize = 1u << 14u;
+constexpr uint32 kWeldMaxPartitions = 256u;
 
 namespace EE
 {
@@ -36,6 +47,12 @@ namespace EE
             U8String name;
             size_t vertexIndicesPos = 0;
             size_t vertexIndicesCount = 0;
+            //* Set by the last usemtl line, empty when the file didn't name one
+            U8String material;
+            //* Made in a parallel chunk before its first usemtl, the material is left by the chunks before
+            bool inheritsMaterial = false;
+            //* Made in a parallel chunk before its first 'g' or 'o', the group name is left by the chunks before
+            bool inheritsGroup = false;
         };
 
         U8String name;
@@ -47,31 +64,260 @@ namespace EE
         size_t vertexIndicesCount = 0;
     };
 
+    // Parsing arrays are accounted to the importer memory tag
+    template<class T>
+    using TImporterArray = TArray<T, Memory::TTaggedAllocator<T, Memory::MemoryTag_Importer>>;
+
+    class MaterialLibraryLoader;
+
     struct ExtractedData
     {
         TArray<ObjectData> objects;
-        TArray<UIntVector3> vertexIndices;
-        MeshVector3D positions;
-        MeshVector3D normals;
-        MeshUVs uvs;
+        TImporterArray<UIntVector3> vertexIndices;
+        TImporterArray<Vector3f> positions;
+        TImporterArray<Vector3f> normals;
+        TImporterArray<Vector2f> uvs;
+
+        //* Paths of the mtllib lines in file order
+        TArray<U8String> materialLibraries;
+        //* Starts parsing the libraries as soon as their mtllib line is found
+        MaterialLibraryLoader* libraryLoader = NULL;
+        U8String material;
+        //* False in parallel chunks until their first usemtl
+        bool isMaterialKnown = true;
+
+        //* Set when streaming, called with the last object when the next one starts. Its corners are dropped
+        //* after it, the attributes are kept since faces of any object can index them. Returns false to stop
+        std::function<bool( ObjectData& )> onObjectEnd;
     };
 
-    inline constexpr void TrimLeft( std::string_view* text ) noexcept
+    std::string_view TrimBlanks( std::string_view text )
     {
-        size_t index = 0;
-        while ( index < text->size() && ((*text)[ index ] == ' ' || (*text)[ index ] == '\t') )
+        const size_t begin = text.find_first_not_of( " \t\r" );
+        if ( begin == std::string_view::npos )
+            return std::string_view();
+        return text.substr( begin, text.find_last_not_of( " \t\r" ) - begin + 1 );
+    }
+
+    //* Absolute paths are kept, relative ones start at the directory of basePath
+    U8String ResolveRelativePath( const U8String& basePath, std::string_view path )
+    {
+        if ( path.empty() || path.front() == '/' || path.front() == '\\' || (path.size() > 1 && path[ 1 ] == ':') )
+            return U8String( path );
+
+        const size_t directoryEnd = basePath.find_last_of( "/\\" );
+        if ( directoryEnd == U8String::npos )
+            return U8String( path );
+        return basePath.substr( 0, directoryEnd + 1 ) + U8String( path );
+    }
+
+    void ExtractColor( std::string_view text, Vector3f* color )
+    {
+        // Spectral and CIEXYZ colors are not supported, the default is kept
+        if ( text.empty() || std::isalpha( (unsigned char)text.front() ) )
+            return;
+
+        color->x = Text::ParseFloat( &text );
+        if ( TrimBlanks( text ).empty() )
         {
-            ++index;
+            color->y = color->z = color->x;
+            return;
+        }
+        color->y = Text::ParseFloat( &text );
+        color->z = Text::ParseFloat( &text );
+    }
+
+    //* Skips the options in front of the file name of a texture map. Each option has a fixed number of
+    //* values except -o, -s and -t, which take one to three numbers
+    U8String ExtractTexturePath( std::string_view text, const U8String& libraryPath )
+    {
+        auto NextToken = []( std::string_view text ) -> std::string_view
+        {
+            const size_t tokenEnd = text.find_first_of( " \t" );
+            return tokenEnd == std::string_view::npos ? std::string_view() : TrimBlanks( text.substr( tokenEnd ) );
+        };
+
+        while ( text.empty() == false && text.front() == '-' )
+        {
+            const std::string_view option = text.substr( 0, text.find_first_of( " \t" ) );
+            const bool isVector = option == "-o" || option == "-s" || option == "-t";
+            const uint32 valueCount = isVector ? 3 : option == "-mm" ? 2 : 1;
+            text = NextToken( text );
+            for ( uint32 i = 0; i < valueCount && text.empty() == false; i++ )
+            {
+                if ( isVector && i > 0 && std::isdigit( (unsigned char)text.front() ) == 0 && text.front() != '-' && text.front() != '.' )
+                    break;
+                text = NextToken( text );
+            }
         }
-        text->remove_prefix( index );
+
+        return text.empty() ? U8String() : ResolveRelativePath( libraryPath, text );
+    }
+
+    //* Reads the materials of a Wavefront material library, unknown statements are ignored
+    bool ParseMaterialLibrary( const File& file, TArray<MaterialData>& materials )
+    {
+        MappedFileView view( file, MappedFileHint_Sequential );
+        if ( view.GetError() != 0 )
+        {
+            EE_LOG_WARN( "Error reading material library '{}', returned code {}", file.GetPath(), view.GetError() );
+            return false;
+        }
+
+        std::string_view text = view.GetText();
+        MaterialData* material = NULL;
+        while ( text.empty() == false )
+        {
+            const size_t lineEnd = text.find( '\n' );
+            const std::string_view line = TrimBlanks( text.substr( 0, lineEnd ) );
+            text.remove_prefix( lineEnd == std::string_view::npos ? text.size() : lineEnd + 1 );
+            if ( line.empty() || line.front() == '#' )
+                continue;
+
+            const size_t keyEnd = line.find_first_of( " \t" );
+            const std::string_view key = line.substr( 0, keyEnd );
+            std::string_view value = keyEnd == std::string_view::npos ? std::string_view() : TrimBlanks( line.substr( keyEnd ) );
+
+            if ( key == "newmtl" )
+            {
+                material = &materials.emplace_back();
+                material->name = value;
+                continue;
+            }
+
+            // Statements before the first newmtl have no material to go to
+            if ( material == NULL )
+                continue;
+
+            if ( key == "Kd" )                                      ExtractColor( value, &material->diffuseColor );
+            else if ( key == "Ka" )                                 ExtractColor( value, &material->ambientColor );
+            else if ( key == "Ks" )                                 ExtractColor( value, &material->specularColor );
+            else if ( key == "Ke" )                                 ExtractColor( value, &material->emissiveColor );
+            else if ( key == "Ns" )                                 material->specularExponent = Text::ParseFloat( &value );
+            else if ( key == "Ni" )                                 material->refractionIndex = Text::ParseFloat( &value );
+            else if ( key == "d" )                                  material->opacity = Text::ParseFloat( &value );
+            else if ( key == "Tr" )                                 material->opacity = 1.F - Text::ParseFloat( &value );
+            else if ( key == "illum" )                              material->illuminationModel = Text::ParseInt( &value );
+            else if ( key == "map_Kd" )                             material->diffuseTexture = ExtractTexturePath( value, file.GetPath() );
+            else if ( key == "map_Ka" )                             material->ambientTexture = ExtractTexturePath( value, file.GetPath() );
+            else if ( key == "map_Ks" )                             material->specularTexture = ExtractTexturePath( value, file.GetPath() );
+            else if ( key == "map_Ke" )                             material->emissiveTexture = ExtractTexturePath( value, file.GetPath() );
+            else if ( key == "map_d" )                              material->alphaTexture = ExtractTexturePath( value, file.GetPath() );
+            else if ( key == "map_Bump" || key == "map_bump" || key == "bump" || key == "norm" )
+                material->normalTexture = ExtractTexturePath( value, file.GetPath() );
+        }
+        return true;
+    }
+
+    //* Parses the material libraries on the job system while the geometry is still being parsed.
+    //* Libraries are requested from any parsing thread, each one is read once
+    class MaterialLibraryLoader
+    {
+    public:
+        MaterialLibraryLoader( const File& modelFile ) : _modelPath( modelFile.GetPath() ), _libraries(), _lock(), _counter() {}
+
+        ~MaterialLibraryLoader()
+        {
+            // The jobs write to the libraries, a failed import still waits for them
+            JobSystem::Wait( _counter );
+        }
+
+        //* Starts the libraries of a mtllib line. Names are separated by blanks unless the whole line names a file
+        void Request( std::string_view names, TArray<U8String>& outPaths )
+        {
+            names = TrimBlanks( names );
+            if ( names.empty() )
+                return;
+
+            U8String path = ResolveRelativePath( _modelPath, names );
+            std::error_code error;
+            if ( names.find_first_of( " \t" ) == std::string_view::npos || std::filesystem::exists( path, error ) )
+            {
+                Start( path );
+                outPaths.emplace_back( std::move( path ) );
+                return;
+            }
+
+            while ( names.empty() == false )
+            {
+                const size_t nameEnd = names.find_first_of( " \t" );
+                path = ResolveRelativePath( _modelPath, names.substr( 0, nameEnd ) );
+                Start( path );
+                outPaths.emplace_back( std::move( path ) );
+                names = nameEnd == std::string_view::npos ? std::string_view() : TrimBlanks( names.substr( nameEnd ) );
+            }
+        }
+
+        //* Waits for the libraries and moves their materials in mtllib order, the first material of a name wins
+        void Collect( const TArray<U8String>& paths, TArray<MaterialData>& outMaterials, TArray<U8String>& outDependencies )
+        {
+            JobSystem::Wait( _counter );
+
+            TMap<U8String, size_t> materialIndices;
+            for ( const U8String& path : paths )
+            {
+                if ( std::find( outDependencies.begin(), outDependencies.end(), path ) != outDependencies.end() )
+                    continue;
+                outDependencies.push_back( path );
+
+                for ( MaterialData& material : _libraries[ path ].materials )
+                {
+                    if ( materialIndices.try_emplace( material.name, outMaterials.size() ).second )
+                        outMaterials.emplace_back( std::move( material ) );
+                }
+            }
+        }
+
+    private:
+        struct MaterialLibrary
+        {
+            TArray<MaterialData> materials;
+        };
+
+        void Start( const U8String& path )
+        {
+            MaterialLibrary* library;
+            {
+                std::unique_lock<std::mutex> lock( _lock );
+                auto [ found, inserted ] = _libraries.try_emplace( path );
+                if ( inserted == false )
+                    return;
+                // Map nodes don't move, the job can keep the library while others are added
+                library = &found->second;
+            }
+            JobSystem::Run( [ library, path ] { ParseMaterialLibrary( File( path ), library->materials ); }, &_counter );
+        }
+
+        U8String _modelPath;
+        TMap<U8String, MaterialLibrary> _libraries;
+        std::mutex _lock;
+        JobCounter _counter;
+    };
+
+    ObjectData& AddObject( ExtractedData& data, U8String name )
+    {
+        ObjectData oData
+        {
+            .name = std::move( name ),
+            .hasNormals = false,
+            .hasTextureCoords = false,
+            .vertexIndicesPos = data.vertexIndices.size(),
+            .vertexIndicesCount = 0
+        };
+
+        return data.objects.emplace_back( std::move( oData ) );
+    }
+
+    void AddSubdivision( ExtractedData& data, U8String name, size_t vertexIndicesPos )
+    {
+        ObjectData::Subdivision& subdivision = data.objects.back().subdivisions.emplace_back( std::move( name ), vertexIndicesPos, 0 );
+        subdivision.material = data.material;
+        subdivision.inheritsMaterial = data.isMaterialKnown == false;
     }
 
     void ExtractVector3( std::string_view* text, Vector3f* vector )
     {
-        TrimLeft( text );
-        vector->x = Text::ParseFloat( text );
-        vector->y = Text::ParseFloat( text );
-        vector->z = Text::ParseFloat( text );
+        Text::ParseFloat3( text, *vector );
     }
 
     void ExtractVector2( std::string_view* text, Vector2f* vector )
@@ -89,20 +335,6 @@ namespace EE
             text->remove_prefix( 1 );
     }
 
-    bool GetSimilarVertexIndex( const StaticVertex& vertex, TMap<StaticVertex, uint32>& vertexToIndex, uint32& result )
-    {
-        TMap<StaticVertex, uint32>::const_iterator it = vertexToIndex.find( vertex );
-        if ( it == vertexToIndex.end() )
-        {
-            return false;
-        }
-        else
-        {
-            result = it->second;
-            return true;
-        }
-    }
-
     bool ParseLine( std::string_view line, ExtractedData& data )
     {
         size_t index = 0;
@@ -120,18 +352,7 @@ namespace EE
         case 'v':
         {
             if ( data.objects.empty() )
-            {
-                ObjectData oData
-                {
-                    .name = "empty",
-                    .hasNormals = false,
-                    .hasTextureCoords = false,
-                    .vertexIndicesPos = data.vertexIndices.size(),
-                    .vertexIndicesCount = 0
-                };
-
-                data.objects.emplace_back( oData );
-            }
+                AddObject( data, "empty" );
 
             if ( line[ 1 ] == ' ' || line[ 1 ] == '\t' )
             {
@@ -162,7 +383,7 @@ namespace EE
             ++data.objects.back().vertexIndicesCount;
             if ( data.objects.back().subdivisions.size() == 0 )
             {
-                data.objects.back().subdivisions.emplace_back( data.objects.back().name, data.vertexIndices.size(), 0 );
+                AddSubdivision( data, data.objects.back().name, data.vertexIndices.size() );
             }
             ++data.objects.back().subdivisions.back().vertexIndicesCount;
             if ( line.empty() == false )
@@ -195,19 +416,8 @@ namespace EE
             // Trim( name );
             
             if ( data.objects.empty() )
-            {
-                ObjectData oData
-                {
-                    .name = name,
-                    .hasNormals = false,
-                    .hasTextureCoords = false,
-                    .vertexIndicesPos = data.vertexIndices.size(),
-                    .vertexIndicesCount = 0
-                };
-
-                data.objects.emplace_back( oData );
-            }
-            data.objects.back().subdivisions.emplace_back( std::move( name ), data.vertexIndices.size(), 0 );
+                AddObject( data, name );
+            AddSubdivision( data, std::move( name ), data.vertexIndices.size() );
             break;
         }
         case 'o':
@@ -216,24 +426,38 @@ namespace EE
             U8String name = U8String( line );
             // Trim( name );
 
-            ObjectData oData
+            if ( data.onObjectEnd && data.objects.empty() == false )
             {
-                .name = std::move( name ),
-                .hasNormals = false,
-                .hasTextureCoords = false,
-                .vertexIndicesPos = data.vertexIndices.size(),
-                .vertexIndicesCount = 0
-            };
+                if ( data.onObjectEnd( data.objects.back() ) == false )
+                    return false;
+                data.objects.clear();
+                data.vertexIndices.clear();
+            }
 
-            data.objects.emplace_back( oData );
+            AddObject( data, std::move( name ) );
             break;
         }
         case 'm':
         {
+            if ( line.starts_with( "mtllib" ) && data.libraryLoader != NULL )
+                data.libraryLoader->Request( line.substr( 6 ), data.materialLibraries );
             break;
         }
         case 'u':
         {
+            if ( line.starts_with( "usemtl" ) == false )
+                break;
+
+            data.material = TrimBlanks( line.substr( 6 ) );
+            data.isMaterialKnown = true;
+            if ( data.objects.empty() )
+                AddObject( data, "empty" );
+
+            // Faces from here on go to a new range, the group keeps its name
+            ObjectData& object = data.objects.back();
+            const bool inheritsGroup = object.subdivisions.empty() == false && object.subdivisions.back().inheritsGroup;
+            AddSubdivision( data, object.subdivisions.empty() ? object.name : object.subdivisions.back().name, data.vertexIndices.size() );
+            object.subdivisions.back().inheritsGroup = inheritsGroup;
             break;
         }
         case 's':
@@ -255,207 +479,818 @@ namespace EE
         return true;
     }
 
-    bool OBJImporter::LoadModel( ModelImporter::ModelResult& info, const ModelImporter::Options& options )
+    bool ParseTextLine( std::string_view line, ExtractedData& data, const File& file )
     {
-        ExtractedData parsedData;
-
+        if ( line.length() > 0 && line.back() == '\r' )
         {
-            Timestamp timer;
+            line.remove_suffix( 1 );
+        }
 
-            timer.Begin();
-            FileMap file( options.file );
-            if ( file.GetError() != 0 )
-            {
-                EE_LOG_ERROR( "Error reading file '{}', returned code {}", options.file.GetPath(), file.GetError() );
+        if ( ParseLine( line, data ) == false )
+        {
+            // A streamed object stopped the parse
+            if ( ResourceLoader::IsCancelRequested() )
                 return false;
-            }
 
-            uint64 fileSize = file.GetSize();
-            uint64 offset = 0;
-            uint64 bytesRead = kBufferBlockSize;
-            Memory::AlignedMemory<U8Char> frontBuffer = Memory::AlignedMemory<U8Char>( kBufferBlockSize + kMaxLineSize, kMaxLineSize );
-            // Memory::AlignedMemory<U8Char> backBuffer = Memory::AlignedMemory<U8Char>( kBufferBlockSize + kMaxLineSize, kMaxLineSize );
+            EE_LOG_ERROR( "Error reading file '{}', error in line: \n{}", file.GetPath(), U8String( line, 0, kMaxLineSize ) );
+            return false;
+        }
+        return true;
+    }
 
-            auto line = std::string_view();
-            auto text = std::string_view();
+    //* Parses every complete line of text and consumes it, a last line without newline is only parsed when isEndOfFile.
+    //* New lines are indexed a window at a time so the line loop doesn't search byte by byte
+    bool ParseLines( std::string_view* text, bool isEndOfFile, ExtractedData& data, const File& file )
+    {
+        uint32 lineEnds[ kLineScanWindowSize ];
 
-            uint32 lineCount = 0;
-            uint32 blockCount = 0;
+        while ( text->empty() == false )
+        {
+            const std::string_view window = text->substr( 0, kLineScanWindowSize );
+            const size_t lineCount = Text::FindLineEnds( window, lineEnds );
 
-            while ( bytesRead >= kBufferBlockSize )
+            if ( lineCount == 0 )
             {
-                if ( file.ReadBlock( offset, kBufferBlockSize + kMaxLineSize, frontBuffer.GetData() ) != 0 )
+                // Last line of the text, or a line longer than the window
+                std::string_view line;
+                if ( const U8Char* endLine = static_cast<const U8Char*>(memchr( text->data() + window.size(), '\n', text->size() - window.size() )) )
                 {
-                    EE_LOG_ERROR( "Error reading block of file '{}', returned code {}", options.file.GetPath(), file.GetError() );
-                    return false;
+                    line = text->substr( 0, static_cast<size_t>(endLine - text->data()) );
+                    text->remove_prefix( line.size() + 1 );
                 }
-
-                if ( file.WaitForResult( &bytesRead ) != 0 )
+                else if ( isEndOfFile )
                 {
-                    EE_LOG_ERROR( "Error reading result of block of file '{}', returned code {}", options.file.GetPath(), file.GetError() );
-                    return false;
-                }
-
-                text = std::string_view( frontBuffer.GetData(), bytesRead );
-                if ( const U8Char* endLine = static_cast<const U8Char*>(memchr( text.data(), '\n', kMaxLineSize )) )
-                {
-                    uint64 pos = static_cast<uint64>(endLine - text.data());
-                    text.remove_prefix( pos + 1 );
+                    line = *text;
+                    text->remove_prefix( text->size() );
                 }
                 else
                 {
-                    EE_LOG_ERROR( "Error reading file '{}', line is too log: \n{}", options.file.GetPath(), U8String( text, 0, kMaxLineSize ) );
-                    return false;
+                    break;
                 }
 
-                bool isEndOfFile = bytesRead < (kBufferBlockSize + kMaxLineSize);
-                while ( text.size() >= kMaxLineSize || (text.size() > 0 && isEndOfFile) )
-                {
-                    if ( const U8Char* endLine = static_cast<const U8Char*>(memchr( text.data(), '\n', text.size() )) )
-                    {
-                        uint64 pos = static_cast<uint64>(endLine - text.data());
-                        ++lineCount;
-
-                        if ( pos > kMaxLineSize )
-                        {
-                            EE_LOG_ERROR( "Error reading file '{}', line is too log: \n{}", options.file.GetPath(), U8String( text, 0, kMaxLineSize ) );
-                            return false;
-                        }
-                        line = text.substr( 0, pos );
-
-                        if ( line.length() > 0 && line.back() == '\r' )
-                        {
-                            line.remove_suffix( 1 );
-                        }
-                        text.remove_prefix( pos + 1 );
-                    }
-                    else
-                    {
-                        if ( text.size() > kMaxLineSize )
-                        {
-                            EE_LOG_ERROR( "Error reading file '{}', line is too log: \n{}", options.file.GetPath(), U8String( text, 0, kMaxLineSize ) );
-                            return false;
-                        }
-                        break;
-                    }
+                if ( ParseTextLine( line, data, file ) == false )
+                    return false;
+                continue;
+            }
 
-                    if ( ParseLine( line, parsedData ) == false )
-                    {
-                        EE_LOG_ERROR( "Error reading file '{}', error in line: \n{}", options.file.GetPath(), U8String( line, 0, kMaxLineSize ) );
-                        return false;
-                    }
-                }
+            size_t lineBegin = 0;
+            for ( size_t i = 0; i < lineCount; i++ )
+            {
+                if ( ParseTextLine( window.substr( lineBegin, lineEnds[ i ] - lineBegin ), data, file ) == false )
+                    return false;
+                lineBegin = lineEnds[ i ] + 1;
+            }
+            text->remove_prefix( lineBegin );
+        }
+        return true;
+    }
+
+    //* Fallback for files that can't be mapped. Reads are pipelined over rotating buffers so the next blocks
+    //* load while the current one is parsed, a line split between blocks is carried into the next buffer
+    bool ReadFileBlocks( const File& file, ExtractedData& data )
+    {
+        FileMap fileMap( file, true );
+        if ( fileMap.GetError() != 0 )
+        {
+            EE_LOG_ERROR( "Error reading file '{}', returned code {}", file.GetPath(), fileMap.GetError() );
+            return false;
+        }
+
+        const uint64 fileSize = fileMap.GetSize();
+        const uint64 blockCount = (fileSize + kBufferBlockSize - 1) / kBufferBlockSize;
+
+        // Each buffer keeps kMaxLineSize bytes in front of the block for the carried partial line
+        constexpr size_t kReadBufferSize = kMaxLineSize + kBufferBlockSize;
+        std::unique_ptr<U8Char, void(*)(void*)> buffers(
+            static_cast<U8Char*>( Memory::AlignedAlloc( kReadBufferSize * kReadBufferCount, kMaxLineSize ) ), Memory::AlignedFree );
+        uint32 requests[ kReadBufferCount ];
+
+        auto GetBlockData = [ & ]( uint64 block ) -> U8Char*
+        {
+            return buffers.get() + (block % kReadBufferCount) * kReadBufferSize + kMaxLineSize;
+        };
+
+        auto SubmitBlock = [ & ]( uint64 block ) -> bool
+        {
+            U8Char* blockData = GetBlockData( block );
+            if ( fileMap.SubmitRead( block * kBufferBlockSize, kBufferBlockSize, blockData, &requests[ block % kReadBufferCount ] ) != 0 )
+            {
+                EE_LOG_ERROR( "Error reading block of file '{}', returned code {}", file.GetPath(), fileMap.GetError() );
+                return false;
+            }
+            return true;
+        };
+
+        for ( uint64 block = 0; block < blockCount && block < kReadBufferCount; block++ )
+        {
+            if ( SubmitBlock( block ) == false )
+                return false;
+        }
+
+        uint64 carrySize = 0;
+        for ( uint64 block = 0; block < blockCount; block++ )
+        {
+            const uint32 bufferIndex = block % kReadBufferCount;
+            uint64 bytesRead = 0;
+            if ( fileMap.WaitForRead( requests[ bufferIndex ], &bytesRead ) != 0 )
+            {
+                EE_LOG_ERROR( "Error reading result of block of file '{}', returned code {}", file.GetPath(), fileMap.GetError() );
+                return false;
+            }
+
+            U8Char* blockData = GetBlockData( block );
+            const bool isEndOfFile = block + 1 == blockCount || bytesRead < kBufferBlockSize;
+            std::string_view text = std::string_view( blockData - carrySize, carrySize + bytesRead );
+            if ( ParseLines( &text, isEndOfFile, data, file ) == false )
+                return false;
+
+            if ( isEndOfFile )
+                break;
+
+            if ( text.size() > kMaxLineSize )
+            {
+                EE_LOG_ERROR( "Error reading file '{}', line is too long: \n{}", file.GetPath(), U8String( text, 0, kMaxLineSize ) );
+                return false;
+            }
+
+            // The next block may still be loading, only the space in front of it is written
+            U8Char* nextBlockData = GetBlockData( block + 1 );
+            memcpy( nextBlockData - text.size(), text.data(), text.size() );
+            carrySize = text.size();
+
+            if ( block + kReadBufferCount < blockCount && SubmitBlock( block + kReadBufferCount ) == false )
+                return false;
 
-                blockCount++;
 #ifdef EE_DEBUG
-                EE_LOG_DEBUG( "Block [{}], Line [{}] %{}", blockCount, lineCount, (float)(offset + bytesRead) / (float)fileSize * 100 );
+            EE_LOG_DEBUG( "Block [{}] %{}", block + 1, (float)((block + 1) * kBufferBlockSize) / (float)fileSize * 100 );
 #endif
-                offset += kBufferBlockSize;
+        }
+
+        return true;
+    }
+
+    struct ParseChunk
+    {
+        std::string_view text;
+        ExtractedData data;
+        bool isValid = false;
+    };
+
+    //* Moves the objects of a chunk after the merged ones. The first object of a chunk continues the
+    //* last merged object, its first subdivision holds the faces found before any 'g', 'o' or usemtl line
+    void MergeChunkObjects( ExtractedData& data, ExtractedData& chunkData, size_t indexOffset )
+    {
+        TArray<ObjectData>& objects = data.objects;
+        TArray<ObjectData>& chunkObjects = chunkData.objects;
+        for ( ObjectData& object : chunkObjects )
+        {
+            for ( ObjectData::Subdivision& subdivision : object.subdivisions )
+            {
+                if ( subdivision.inheritsMaterial )
+                    subdivision.material = data.material;
+                subdivision.inheritsMaterial = false;
             }
-            timer.Stop();
-            EE_LOG_INFO(
-                "\u250C> Parsed {0} vertices and {1} triangles in {2:.3f}ms",
-                Text::FormatUnit( parsedData.vertexIndices.size(), 2 ),
-                Text::FormatUnit( parsedData.vertexIndices.size() / 3, 2 ),
-                timer.GetDeltaTime<Ticker::Mili>()
-            );
         }
+        data.materialLibraries.insert( data.materialLibraries.end(), chunkData.materialLibraries.begin(), chunkData.materialLibraries.end() );
 
-        uint32* indices = new uint32[ parsedData.vertexIndices.size() ];
-        uint32 count = 0;
+        ObjectData& continuation = chunkObjects.front();
+        ObjectData& last = objects.back();
+        last.hasNormals |= continuation.hasNormals;
+        last.hasTextureCoords |= continuation.hasTextureCoords;
+        last.vertexIndicesCount += continuation.vertexIndicesCount;
 
-        uint64 totalAllocatedSize = 0;
-        uint32 totalUniqueVertices = 0;
+        ObjectData::Subdivision& continuationSubdivision = continuation.subdivisions.front();
+        if ( continuationSubdivision.vertexIndicesCount > 0 )
+        {
+            // Same subdivision a serial parse creates on the first face of an object
+            if ( last.subdivisions.empty() )
+                last.subdivisions.emplace_back( last.name, indexOffset + 1, 0, data.material );
+            last.subdivisions.back().vertexIndicesCount += continuationSubdivision.vertexIndicesCount;
+        }
 
-        info.parentNode = ModelNode( "ParentNode" );
-        Timestamp timer;
-        timer.Begin();
-        for ( int32 objectCount = 0; objectCount < parsedData.objects.size(); ++objectCount )
+        // A usemtl before any 'g' named its subdivision after the unnamed continuation, a serial parse keeps the open group
+        const U8String groupName = last.subdivisions.empty() ? last.name : last.subdivisions.back().name;
+        for ( size_t i = 1; i < continuation.subdivisions.size(); i++ )
         {
-            ObjectData& data = parsedData.objects[ objectCount ];
-            if ( data.vertexIndicesCount == 0 ) continue;
+            ObjectData::Subdivision& subdivision = last.subdivisions.emplace_back( std::move( continuation.subdivisions[ i ] ) );
+            subdivision.vertexIndicesPos += indexOffset;
+            if ( subdivision.inheritsGroup )
+                subdivision.name = groupName;
+            subdivision.inheritsGroup = false;
+        }
 
-            TMap<StaticVertex, unsigned> vertexToIndex;
-            vertexToIndex.reserve( data.vertexIndicesCount );
+        for ( size_t i = 1; i < chunkObjects.size(); i++ )
+        {
+            ObjectData& object = objects.emplace_back( std::move( chunkObjects[ i ] ) );
+            object.vertexIndicesPos += indexOffset;
+            for ( ObjectData::Subdivision& subdivision : object.subdivisions )
+                subdivision.vertexIndicesPos += indexOffset;
+        }
 
-            info.parentNode.children.push_back( new ModelNode( data.name ) );
-            info.parentNode.children.back()->parent = &info.parentNode;
-            info.parentNode.children.back()->hasMesh = true;
-            info.parentNode.children.back()->meshKey = info.meshes.size();
-            info.meshes.push_back( MeshData() );
-            MeshData* outMesh = &info.meshes.back();
-            outMesh->name = data.name;
+        if ( chunkData.isMaterialKnown )
+            data.material = std::move( chunkData.material );
+    }
+
+    template<class T>
+    void MoveChunkArray( T& destination, T& source, size_t offset )
+    {
+        std::copy( source.begin(), source.end(), destination.begin() + offset );
+        T().swap( source );
+    }
 
-            uint32 indexCount = 0;
-            for ( int32 materialCount = 0; materialCount < data.subdivisions.size(); ++materialCount )
+    //* Splits the text at line boundaries and parses the pieces concurrently. Face indices in OBJ are
+    //* absolute so only the object and subdivision ranges need fixing, the result matches a serial parse
+    bool ParseLinesParallel( std::string_view text, uint32 threadCount, ExtractedData& data, const File& file )
+    {
+        TArray<ParseChunk> chunks( threadCount );
+        size_t begin = 0;
+        for ( uint32 i = 0; i < threadCount; i++ )
+        {
+            size_t end = i + 1 == threadCount ? text.size() : std::max( begin, text.size() / threadCount * (i + 1) );
+            if ( end < text.size() )
             {
-                ObjectData::Subdivision& materialIndex = data.subdivisions[ materialCount ];
-                outMesh->materialsMap.emplace( (int32)outMesh->materialsMap.size(), materialIndex.name );
-                outMesh->subdivisionsMap.emplace( materialCount, Subdivision( { (uint32)materialCount, 0, indexCount, 0 } ) );
+                const void* endLine = memchr( text.data() + end, '\n', text.size() - end );
+                end = endLine ? static_cast<const U8Char*>(endLine) - text.data() + 1 : text.size();
+            }
+            chunks[ i ].text = text.substr( begin, end - begin );
+            begin = end;
+        }
 
-                uint32 initialCount = count;
-                for ( ; count < initialCount + materialIndex.vertexIndicesCount; ++count )
+        auto ParseChunkText = [ & ]( uint32 chunkIndex )
+        {
+            ParseChunk& chunk = chunks[ chunkIndex ];
+            ExtractedData& chunkData = chunkIndex == 0 ? data : chunk.data;
+            if ( chunkIndex > 0 )
+            {
+                // Stands for the object left open by the previous chunks
+                ObjectData& continuation = chunkData.objects.emplace_back();
+                continuation.hasNormals = false;
+                continuation.hasTextureCoords = false;
+                continuation.subdivisions.emplace_back().inheritsGroup = true;
+                chunkData.libraryLoader = data.libraryLoader;
+                chunkData.isMaterialKnown = false;
+            }
+            std::string_view chunkText = chunk.text;
+            chunk.isValid = ParseLines( &chunkText, true, chunkData, file );
+        };
+
+        JobSystem::ParallelFor( threadCount, 1, [ & ]( uint32 begin, uint32 end )
+        {
+            for ( uint32 i = begin; i < end; i++ )
+                ParseChunkText( i );
+        } );
+
+        for ( const ParseChunk& chunk : chunks )
+        {
+            if ( chunk.isValid == false )
+                return false;
+        }
+
+        // While only comments were found there is no object to continue. Data is still empty then, so
+        // those chunks are parsed again in place to get the serial result
+        uint32 firstChunk = 1;
+        for ( ; firstChunk < threadCount && data.objects.empty(); firstChunk++ )
+        {
+            chunks[ firstChunk ].data = ExtractedData();
+            std::string_view chunkText = chunks[ firstChunk ].text;
+            if ( ParseLines( &chunkText, true, data, file ) == false )
+                return false;
+        }
+
+        struct ChunkOffsets
+        {
+            size_t position, normal, uv, index;
+        };
+
+        TArray<ChunkOffsets> offsets( threadCount );
+        ChunkOffsets count = { data.positions.size(), data.normals.size(), data.uvs.size(), data.vertexIndices.size() };
+        for ( uint32 i = firstChunk; i < threadCount; i++ )
+        {
+            ExtractedData& chunkData = chunks[ i ].data;
+            offsets[ i ] = count;
+            count.position += chunkData.positions.size();
+            count.normal += chunkData.normals.size();
+            count.uv += chunkData.uvs.size();
+            count.index += chunkData.vertexIndices.size();
+            MergeChunkObjects( data, chunkData, offsets[ i ].index );
+        }
+
+        data.positions.resize( count.position );
+        data.normals.resize( count.normal );
+        data.uvs.resize( count.uv );
+        data.vertexIndices.resize( count.index );
+
+        auto MoveChunk = [ & ]( uint32 chunkIndex )
+        {
+            ExtractedData& chunkData = chunks[ chunkIndex ].data;
+            MoveChunkArray( data.positions, chunkData.positions, offsets[ chunkIndex ].position );
+            MoveChunkArray( data.normals, chunkData.normals, offsets[ chunkIndex ].normal );
+            MoveChunkArray( data.uvs, chunkData.uvs, offsets[ chunkIndex ].uv );
+            MoveChunkArray( data.vertexIndices, chunkData.vertexIndices, offsets[ chunkIndex ].index );
+        };
+
+        JobSystem::ParallelFor( threadCount - std::min( firstChunk, threadCount ), 1, [ & ]( uint32 begin, uint32 end )
+        {
+            for ( uint32 i = begin; i < end; i++ )
+                MoveChunk( firstChunk + i );
+        } );
+
+        return true;
+    }
+
+    //* Position, uv and normal indices of a face corner, corners with the same key become the same vertex
+    struct WeldKey
+    {
+        uint32 position;
+        uint32 uv;
+        uint32 normal;
+
+        FORCEINLINE bool operator==( const WeldKey& other ) const
+        {
+            return position == other.position && uv == other.uv && normal == other.normal;
+        }
+    };
+
+    struct WeldKeyHash
+    {
+        FORCEINLINE size_t operator()( const WeldKey& key ) const
+        {
+            uint64 hash = (((uint64)key.position << 32) | key.uv) * 0x9E3779B97F4A7C15ull;
+            hash ^= (uint64)key.normal * 0xC2B2AE3D27D4EB4Full;
+            return (size_t)(hash ^ (hash >> 29));
+        }
+    };
+
+    //* Scratch of the welding pass, reused by every object of a model
+    struct WeldBuffers
+    {
+        TImporterArray<WeldKey> keys;
+        TImporterArray<uint16> partitions;
+        TImporterArray<uint32> partitionCorners;
+        //* First corner with the same key
+        TImporterArray<uint32> firstCorners;
+        //* Final vertex of each corner
+        TImporterArray<uint32> vertexIndices;
+        TImporterArray<uint32> counts;
+        TImporterArray<Box3f> boundings;
+    };
+
+    FORCEINLINE StaticVertex MakeCornerVertex( const ExtractedData& data, const WeldKey& key )
+    {
+        // Indices are one based, absent ones are zero and wrap around the size checks
+        const Vector2f uv = key.uv - 1u < data.uvs.size() ? data.uvs[ key.uv - 1 ] : Vector2f( 0.F );
+        return StaticVertex(
+            key.position - 1u < data.positions.size() ? data.positions[ key.position - 1 ] : Vector3f( 0.F ),
+            key.normal - 1u < data.normals.size() ? data.normals[ key.normal - 1 ] : Vector3f( 0.F, 1.F, 0.F ),
+            Vector3f( 0.F ), uv, uv, Vector4f( 1.F )
+        );
+    }
+
+    //* Builds the vertices of an object and the vertex of each of its corners in buffers.vertexIndices.
+    //* Corners are hashed by their index triplet in partitions picked by the hash, each partition keeps
+    //* the first corner of every key. Vertices are then numbered with a prefix sum over the first corners,
+    //* so the result is the same as welding serially in corner order whatever the number of workers
+    uint32 WeldCorners( const ExtractedData& data, const ObjectData& object, size_t firstCorner, uint32 cornerCount, bool optimize, WeldBuffers& buffers, MeshVertices& vertices )
+    {
+        const uint32 rangeCount = (cornerCount + kWeldRangeSize - 1) / kWeldRangeSize;
+        uint32 partitionCount = 1;
+        while ( optimize && partitionCount < kWeldMaxPartitions && partitionCount * kWeldPartitionSize < cornerCount )
+            partitionCount <<= 1;
+
+        buffers.keys.resize( cornerCount );
+        buffers.vertexIndices.resize( cornerCount );
+        buffers.counts.assign( (size_t)rangeCount * partitionCount, 0 );
+        if ( partitionCount > 1 )
+        {
+            buffers.partitions.resize( cornerCount );
+            buffers.partitionCorners.resize( cornerCount );
+        }
+
+        const UIntVector3* corners = data.vertexIndices.data() + firstCorner;
+        WeldKey* keys = buffers.keys.data();
+        uint16* partitions = buffers.partitions.data();
+        uint32* counts = buffers.counts.data();
+        JobSystem::ParallelFor( rangeCount, 1, [ & ]( uint32 rangeBegin, uint32 rangeEnd )
+        {
+            for ( uint32 range = rangeBegin; range < rangeEnd; range++ )
+            {
+                const uint32 end = std::min( (range + 1) * kWeldRangeSize, cornerCount );
+                for ( uint32 corner = range * kWeldRangeSize; corner < end; corner++ )
                 {
-                    UIntVector3 vertexIndices = parsedData.vertexIndices[ count ];
-                    StaticVertex newVertex = {
-                        vertexIndices[ 0 ] >= 0 ? parsedData.positions[ vertexIndices[ 0 ] - 1 ] : 0,
-                        data.hasNormals && vertexIndices[ 2 ] >= 0 ? parsedData.normals[ vertexIndices[ 2 ] - 1 ] : Vector3f( 0.F, 1.F, 0.F ),
-                        0,
-                        data.hasTextureCoords && vertexIndices[ 1 ] >= 0 ? parsedData.uvs[ vertexIndices[ 1 ] - 1 ] : 0,
-                        data.hasTextureCoords && vertexIndices[ 1 ] >= 0 ? parsedData.uvs[ vertexIndices[ 1 ] - 1 ] : 0,
-                        Vector4f( 1 )
-                    };
-                    data.bounding.Add( newVertex.position );
-
-                    uint32 index = (uint32)count;
-                    bool bFoundIndex = false;
-                    if ( options.optimize )
+                    // Unused attributes don't split vertices
+                    const UIntVector3& indices = corners[ corner ];
+                    const WeldKey key = { indices.x, object.hasTextureCoords ? indices.y : 0u, object.hasNormals ? indices.z : 0u };
+                    keys[ corner ] = key;
+                    if ( partitionCount > 1 )
                     {
-                        bFoundIndex = GetSimilarVertexIndex( newVertex, vertexToIndex, index );
+                        const uint16 partition = (uint16)((WeldKeyHash()( key ) >> 24) & (partitionCount - 1));
+                        partitions[ corner ] = partition;
+                        counts[ (size_t)range * partitionCount + partition ]++;
                     }
+                }
+            }
+        } );
 
-                    if ( bFoundIndex )
-                    {
-                        // --- A similar vertex is already in the VBO, use it instead !
-                        indices[ count ] = index;
-                    }
-                    else
-                    {
-                        // --- If not, it needs to be added in the output data.
-                        outMesh->staticVertices.push_back( newVertex );
-                        uint32 newIndex = (uint32)outMesh->staticVertices.size() - 1;
-                        indices[ count ] = newIndex;
-                        if ( options.optimize ) vertexToIndex[ newVertex ] = newIndex;
-                        totalUniqueVertices++;
-                    }
+        if ( optimize == false )
+        {
+            vertices.resize( cornerCount );
+            StaticVertex* outVertices = vertices.data();
+            uint32* vertexIndices = buffers.vertexIndices.data();
+            JobSystem::ParallelFor( cornerCount, kWeldRangeSize, [ & ]( uint32 begin, uint32 end )
+            {
+                for ( uint32 corner = begin; corner < end; corner++ )
+                {
+                    outVertices[ corner ] = MakeCornerVertex( data, keys[ corner ] );
+                    vertexIndices[ corner ] = corner;
+                }
+            } );
+            return cornerCount;
+        }
 
-                    if ( (count - initialCount + 1) % 3 == 0 )
-                    {
-                        outMesh->faces.push_back( { indices[ count - 2 ], indices[ count - 1 ], indices[ count ] } );
-                        outMesh->subdivisionsMap[ materialCount ].indexCount += 3;
-                        indexCount += 3;
-                    }
+        // Corners of each partition in increasing order, ranges write after the ones before them
+        TInlineArray<uint32, kWeldMaxPartitions + 1> partitionStarts( partitionCount + 1 );
+        if ( partitionCount > 1 )
+        {
+            uint32 offset = 0;
+            for ( uint32 partition = 0; partition < partitionCount; partition++ )
+            {
+                partitionStarts[ partition ] = offset;
+                for ( uint32 range = 0; range < rangeCount; range++ )
+                {
+                    const uint32 count = counts[ (size_t)range * partitionCount + partition ];
+                    counts[ (size_t)range * partitionCount + partition ] = offset;
+                    offset += count;
+                }
+            }
+
+            uint32* partitionCorners = buffers.partitionCorners.data();
+            JobSystem::ParallelFor( rangeCount, 1, [ & ]( uint32 rangeBegin, uint32 rangeEnd )
+            {
+                for ( uint32 range = rangeBegin; range < rangeEnd; range++ )
+                {
+                    uint32* offsets = counts + (size_t)range * partitionCount;
+                    const uint32 end = std::min( (range + 1) * kWeldRangeSize, cornerCount );
+                    for ( uint32 corner = range * kWeldRangeSize; corner < end; corner++ )
+                        partitionCorners[ offsets[ partitions[ corner ] ]++ ] = corner;
+                }
+            } );
+        }
+        partitionStarts[ 0 ] = 0;
+        partitionStarts[ partitionCount ] = cornerCount;
+
+        buffers.firstCorners.resize( cornerCount );
+        uint32* firstCorners = buffers.firstCorners.data();
+        const uint32* partitionCorners = buffers.partitionCorners.data();
+        JobSystem::ParallelFor( partitionCount, 1, [ & ]( uint32 partitionBegin, uint32 partitionEnd )
+        {
+            TFlatMap<WeldKey, uint32, WeldKeyHash> firstCornerOfKey;
+            for ( uint32 partition = partitionBegin; partition < partitionEnd; partition++ )
+            {
+                const uint32 begin = partitionStarts[ partition ];
+                const uint32 end = partitionStarts[ partition + 1 ];
+                firstCornerOfKey.clear();
+                firstCornerOfKey.reserve( end - begin );
+                for ( uint32 i = begin; i < end; i++ )
+                {
+                    const uint32 corner = partitionCount > 1 ? partitionCorners[ i ] : i;
+                    firstCorners[ corner ] = firstCornerOfKey.try_emplace( keys[ corner ], corner ).first->second;
+                }
+            }
+        } );
+
+        // Prefix sum of the new vertices of each range
+        buffers.counts.assign( rangeCount, 0 );
+        JobSystem::ParallelFor( rangeCount, 1, [ & ]( uint32 rangeBegin, uint32 rangeEnd )
+        {
+            for ( uint32 range = rangeBegin; range < rangeEnd; range++ )
+            {
+                const uint32 end = std::min( (range + 1) * kWeldRangeSize, cornerCount );
+                uint32 count = 0;
+                for ( uint32 corner = range * kWeldRangeSize; corner < end; corner++ )
+                    count += firstCorners[ corner ] == corner;
+                counts[ range ] = count;
+            }
+        } );
+
+        uint32 vertexCount = 0;
+        for ( uint32 range = 0; range < rangeCount; range++ )
+        {
+            const uint32 count = counts[ range ];
+            counts[ range ] = vertexCount;
+            vertexCount += count;
+        }
+
+        vertices.resize( vertexCount );
+        StaticVertex* outVertices = vertices.data();
+        uint32* vertexIndices = buffers.vertexIndices.data();
+        JobSystem::ParallelFor( rangeCount, 1, [ & ]( uint32 rangeBegin, uint32 rangeEnd )
+        {
+            for ( uint32 range = rangeBegin; range < rangeEnd; range++ )
+            {
+                uint32 vertex = counts[ range ];
+                const uint32 end = std::min( (range + 1) * kWeldRangeSize, cornerCount );
+                for ( uint32 corner = range * kWeldRangeSize; corner < end; corner++ )
+                {
+                    if ( firstCorners[ corner ] != corner )
+                        continue;
+                    outVertices[ vertex ] = MakeCornerVertex( data, keys[ corner ] );
+                    vertexIndices[ corner ] = vertex++;
                 }
             }
+        } );
+
+        // First corners always come before, their vertex is known now
+        JobSystem::ParallelFor( cornerCount, kWeldRangeSize, [ & ]( uint32 begin, uint32 end )
+        {
+            for ( uint32 corner = begin; corner < end; corner++ )
+                vertexIndices[ corner ] = vertexIndices[ firstCorners[ corner ] ];
+        } );
+
+        return vertexCount;
+    }
+
+    Box3f ComputeVerticesBounding( const MeshVertices& vertices, WeldBuffers& buffers )
+    {
+        const uint32 vertexCount = (uint32)vertices.size();
+        const uint32 rangeCount = (vertexCount + kWeldRangeSize - 1) / kWeldRangeSize;
+        buffers.boundings.assign( rangeCount, Box3f() );
+        JobSystem::ParallelFor( rangeCount, 1, [ & ]( uint32 rangeBegin, uint32 rangeEnd )
+        {
+            for ( uint32 range = rangeBegin; range < rangeEnd; range++ )
+            {
+                Box3f& bounding = buffers.boundings[ range ];
+                const uint32 end = std::min( (range + 1) * kWeldRangeSize, vertexCount );
+                for ( uint32 vertex = range * kWeldRangeSize; vertex < end; vertex++ )
+                    bounding.Add( vertices[ vertex ].position );
+            }
+        } );
+
+        Box3f bounding;
+        for ( const Box3f& rangeBounding : buffers.boundings )
+        {
+            bounding.Add( Vector3f( rangeBounding.minX, rangeBounding.minY, rangeBounding.minZ ) );
+            bounding.Add( Vector3f( rangeBounding.maxX, rangeBounding.maxY, rangeBounding.maxZ ) );
+        }
+        return bounding;
+    }
+
+    //* Welds the corners of an object into a mesh with a subdivision per material, returns the vertex count
+    uint32 BuildObjectMesh( const ExtractedData& parsedData, ObjectData& data, const ModelImporter::Options& options, WeldBuffers& weldBuffers, MeshData& outMesh )
+    {
+        const uint32 cornerCount = (uint32)data.vertexIndicesCount;
+        const uint32 vertexCount = WeldCorners( parsedData, data, data.vertexIndicesPos, cornerCount, options.optimize, weldBuffers, outMesh.staticVertices );
+        const uint32* cornerVertices = weldBuffers.vertexIndices.data();
 
-            if ( parsedData.vertexIndices[ count - 1 ][ 1 ] >= 0 ) outMesh->uvChannels = 1;
-            outMesh->hasNormals = data.hasNormals;
-            outMesh->ComputeNormals();
-            outMesh->ComputeTangents();
-            outMesh->bounding = data.bounding;
-            outMesh->hasBoundingBox = true;
+        // Each subdivision makes triangles of its corners, a trailing corner or two is dropped. Subdivisions
+        // are grouped by material, or by group name when the file names none, in order of first use
+        size_t faceCount = 0;
+        TArray<uint32> subdivisionCorners( data.subdivisions.size() );
+        TArray<uint32> subdivisionMaterials( data.subdivisions.size() );
+        TArray<const U8String*> materialNames;
+        for ( size_t i = 0, corner = 0; i < data.subdivisions.size(); corner += data.subdivisions[ i++ ].vertexIndicesCount )
+        {
+            const ObjectData::Subdivision& subdivision = data.subdivisions[ i ];
+            const U8String& materialName = subdivision.material.empty() ? subdivision.name : subdivision.material;
+            auto found = std::find_if( materialNames.begin(), materialNames.end(), [ & ]( const U8String* name ) { return *name == materialName; } );
+            if ( found == materialNames.end() && subdivision.vertexIndicesCount >= 3 )
+                found = materialNames.insert( found, &materialName );
+
+            subdivisionCorners[ i ] = (uint32)corner;
+            subdivisionMaterials[ i ] = (uint32)(found - materialNames.begin());
+            faceCount += subdivision.vertexIndicesCount / 3;
+        }
+        outMesh.faces.resize( faceCount );
+
+        TArray<uint32> subdivisionOrder( data.subdivisions.size() );
+        std::iota( subdivisionOrder.begin(), subdivisionOrder.end(), 0u );
+        std::stable_sort( subdivisionOrder.begin(), subdivisionOrder.end(), [ & ]( uint32 a, uint32 b ) { return subdivisionMaterials[ a ] < subdivisionMaterials[ b ]; } );
+
+        uint32 indexCount = 0;
+        for ( uint32 subdivisionIndex : subdivisionOrder )
+        {
+            const uint32 materialIndex = subdivisionMaterials[ subdivisionIndex ];
+            const uint32 subdivisionFaces = (uint32)data.subdivisions[ subdivisionIndex ].vertexIndicesCount / 3;
+            if ( subdivisionFaces == 0 )
+                continue;
+
+            auto [ subdivision, inserted ] = outMesh.subdivisionsMap.try_emplace( (int32)materialIndex, Subdivision( { materialIndex, 0, indexCount, 0 } ) );
+            if ( inserted )
+                outMesh.materialsMap.emplace( (int32)materialIndex, *materialNames[ materialIndex ] );
+            subdivision->second.indexCount += subdivisionFaces * 3;
+
+            MeshFace* faces = outMesh.faces.data() + indexCount / 3;
+            const uint32* corners = cornerVertices + subdivisionCorners[ subdivisionIndex ];
+            JobSystem::ParallelFor( subdivisionFaces, kWeldRangeSize, [ faces, corners ]( uint32 begin, uint32 end )
+            {
+                for ( uint32 face = begin; face < end; face++ )
+                    faces[ face ] = { corners[ face * 3 ], corners[ face * 3 + 1 ], corners[ face * 3 + 2 ] };
+            } );
+
+            indexCount += subdivisionFaces * 3;
+        }
+        data.bounding = ComputeVerticesBounding( outMesh.staticVertices, weldBuffers );
+
+        if ( parsedData.vertexIndices[ data.vertexIndicesPos + cornerCount - 1 ][ 1 ] >= 0 ) outMesh.uvChannels = 1;
+        outMesh.hasNormals = data.hasNormals;
+        outMesh.SetVertexLayout( options.vertexLayout );
+        outMesh.ComputeNormals();
+        outMesh.ComputeTangents();
+        outMesh.bounding = data.bounding;
+        outMesh.hasBoundingBox = true;
+
+        return vertexCount;
+    }
+
+    bool OBJImporter::LoadModel( ModelImporter::ModelResult& info, const ModelImporter::Options& options )
+    {
+        ExtractedData parsedData;
+        MaterialLibraryLoader libraryLoader( options.file );
+        parsedData.libraryLoader = &libraryLoader;
+
+        WeldBuffers weldBuffers;
+        size_t meshCount = 0;
+        size_t builtCornerCount = 0;
+        uint64 totalAllocatedSize = 0;
+        uint32 totalUniqueVertices = 0;
+        double buildTime = 0.0;
+        VertexCacheStatistics sourceCacheStatistics;
+        VertexCacheStatistics optimizedCacheStatistics;
+        double optimizeTime = 0.0;
+        uint32 lodLevelCount = 0;
+        uint64 lodSourceFaceCount = 0;
+        uint64 lodLastFaceCount = 0;
+        float lodMaxError = 0.F;
+        double lodTime = 0.0;
+        uint64 meshletCount = 0;
+        uint64 meshletVertexCount = 0;
+        uint64 meshletTriangleCount = 0;
+        double meshletTime = 0.0;
+
+        auto AddLODStatistics = [ & ]( const MeshData& mesh )
+        {
+            const size_t baseFaceCount = mesh.GetBaseFaceCount();
+            lodLevelCount += (uint32)mesh.lods.size();
+            lodSourceFaceCount += baseFaceCount;
+            lodLastFaceCount += mesh.lods.empty() ? baseFaceCount : mesh.lods.back().indexCount / 3;
+            lodMaxError = std::max( lodMaxError, mesh.lods.empty() ? 0.F : mesh.lods.back().error );
+
+#ifdef EE_DEBUG
+            EE_LOG_DEBUG(
+                "\u251C> Simplified '{0}' to {1} levels, {2} to {3} triangles with error {4:.5f}",
+                mesh.name, mesh.lods.size(),
+                Text::FormatUnit( baseFaceCount, 2 ),
+                Text::FormatUnit( mesh.lods.empty() ? baseFaceCount : mesh.lods.back().indexCount / 3, 2 ),
+                mesh.lods.empty() ? 0.F : mesh.lods.back().error
+            );
+#endif // EE_DEBUG
+        };
+
+        auto AddMeshletStatistics = [ & ]( const MeshData& mesh )
+        {
+            meshletCount += mesh.meshlets.size();
+            meshletVertexCount += mesh.meshletVertices.size();
+            meshletTriangleCount += mesh.meshletIndices.size() / 3;
+        };
+
+        info.parentNode = ModelNode( "ParentNode" );
+        auto FinishObject = [ & ]( ObjectData& data ) -> bool
+        {
+            if ( data.vertexIndicesCount == 0 )
+                return true;
+            if ( ResourceLoader::IsCancelRequested() )
+                return false;
+
+            Timestamp timer;
+            timer.Begin();
+            ModelNode* node = info.parentNode.AddChild( data.name );
+            node->hasMesh = true;
+            node->meshKey = meshCount++;
+
+            MeshData streamedMesh;
+            MeshData& outMesh = options.onMeshLoaded ? streamedMesh : info.meshes.emplace_back();
+            outMesh.name = data.name;
+            totalUniqueVertices += BuildObjectMesh( parsedData, data, options, weldBuffers, outMesh );
+            builtCornerCount += data.vertexIndicesCount;
 
 #ifdef EE_DEBUG
             EE_LOG_DEBUG(
                 "\u251C> Parsed {0}	vertices in {1}	at [{2:d}]'{3}'",
                 Text::FormatUnit( data.vertexIndicesCount, 2 ),
-                Text::FormatData( sizeof( MeshFaces ) * outMesh->faces.size() + sizeof( StaticVertex ) * outMesh->staticVertices.size(), 2 ),
-                info.meshes.size(),
-                outMesh->name
+                Text::FormatData( sizeof( MeshFaces ) * outMesh.faces.size() + sizeof( StaticVertex ) * outMesh.GetVertexCount(), 2 ),
+                meshCount,
+                outMesh.name
             );
 #endif // EE_DEBUG
 
-            totalAllocatedSize += sizeof( MeshFaces ) * outMesh->faces.size() + sizeof( StaticVertex ) * outMesh->staticVertices.size();
+            if ( options.optimize )
+            {
+                Timestamp optimizeTimer;
+                optimizeTimer.Begin();
+                const VertexCacheStatistics sourceStatistics = MeshOptimizer::AnalyzeVertexCache( outMesh );
+                MeshOptimizer::OptimizeVertexCache( outMesh );
+                MeshOptimizer::OptimizeOverdraw( outMesh );
+                MeshOptimizer::OptimizeVertexFetch( outMesh );
+                const VertexCacheStatistics optimizedStatistics = MeshOptimizer::AnalyzeVertexCache( outMesh );
+                optimizeTimer.Stop();
+                optimizeTime += optimizeTimer.GetDeltaTime<Ticker::Mili>();
+
+                sourceCacheStatistics.transformedVertices += sourceStatistics.transformedVertices;
+                sourceCacheStatistics.referencedVertices += sourceStatistics.referencedVertices;
+                sourceCacheStatistics.triangleCount += sourceStatistics.triangleCount;
+                optimizedCacheStatistics.transformedVertices += optimizedStatistics.transformedVertices;
+                optimizedCacheStatistics.referencedVertices += optimizedStatistics.referencedVertices;
+                optimizedCacheStatistics.triangleCount += optimizedStatistics.triangleCount;
+
+#ifdef EE_DEBUG
+                EE_LOG_DEBUG(
+                    "\u251C> Optimized '{0}' ACMR {1:.3f} to {2:.3f}, ATVR {3:.3f} to {4:.3f} in {5:.2f}ms",
+                    outMesh.name,
+                    sourceStatistics.GetACMR(), optimizedStatistics.GetACMR(),
+                    sourceStatistics.GetATVR(), optimizedStatistics.GetATVR(),
+                    optimizeTimer.GetDeltaTime<Ticker::Mili>()
+                );
+#endif // EE_DEBUG
+            }
+
+            // Batch imports simplify all the meshes together once they are built
+            if ( options.onMeshLoaded && options.lodCount > 0 )
+            {
+                Timestamp lodTimer;
+                lodTimer.Begin();
+                MeshSimplifier::GenerateLODs( outMesh, options.lodCount );
+                lodTimer.Stop();
+                lodTime += lodTimer.GetDeltaTime<Ticker::Mili>();
+                AddLODStatistics( outMesh );
+            }
+            if ( options.onMeshLoaded && options.buildMeshlets )
+            {
+                Timestamp meshletTimer;
+                meshletTimer.Begin();
+                MeshletBuilder::Build( outMesh );
+                meshletTimer.Stop();
+                meshletTime += meshletTimer.GetDeltaTime<Ticker::Mili>();
+                AddMeshletStatistics( outMesh );
+            }
+
+            totalAllocatedSize += sizeof( MeshFaces ) * outMesh.faces.size() + sizeof( StaticVertex ) * outMesh.GetVertexCount();
+            if ( options.onMeshLoaded )
+                options.onMeshLoaded( streamedMesh );
+            timer.Stop();
+            buildTime += timer.GetDeltaTime<Ticker::Mili>();
+            return true;
+        };
+
+        if ( options.onMeshLoaded )
+            parsedData.onObjectEnd = FinishObject;
+
+        {
+            Timestamp timer;
+
+            timer.Begin();
+            // Parse in place from the mapped file, block reads are only needed when it can't be mapped
+            MappedFileView view( options.file, MappedFileHint_Sequential );
+            if ( view.GetError() == 0 )
+            {
+                std::string_view text = view.GetText();
+                // Streaming finishes each object as the parse goes past it, that needs a single pass in file order
+                uint32 threadCount = options.parseThreadCount == 0 ? JobSystem::GetWorkerCount() + 1 : options.parseThreadCount;
+                threadCount = options.onMeshLoaded ? 1 : (uint32)std::clamp<uint64>( text.size() / kParallelChunkMinSize, 1, std::max( threadCount, 1u ) );
+                if ( threadCount > 1 )
+                {
+                    if ( ParseLinesParallel( text, threadCount, parsedData, options.file ) == false )
+                        return false;
+                }
+                else if ( ParseLines( &text, true, parsedData, options.file ) == false )
+                {
+                    return false;
+                }
+            }
+            else if ( ReadFileBlocks( options.file, parsedData ) == false )
+            {
+                return false;
+            }
+            timer.Stop();
+            EE_LOG_INFO(
+                "\u250C> Parsed {0} vertices and {1} triangles in {2:.3f}ms",
+                Text::FormatUnit( builtCornerCount + parsedData.vertexIndices.size(), 2 ),
+                Text::FormatUnit( (builtCornerCount + parsedData.vertexIndices.size()) / 3, 2 ),
+                timer.GetDeltaTime<Ticker::Mili>()
+            );
+        }
+
+        // Started by the mtllib lines, usually done by the time the geometry is
+        libraryLoader.Collect( parsedData.materialLibraries, info.materials, info.dependencies );
+
+        ResourceLoader::SetProgress( 0.5F );
+        if ( ResourceLoader::IsCancelRequested() )
+            return false;
+
+        // When streaming only the last object is left
+        for ( int32 objectCount = 0; objectCount < parsedData.objects.size(); ++objectCount )
+        {
+            if ( FinishObject( parsedData.objects[ objectCount ] ) == false )
+                return false;
+            ResourceLoader::SetProgress( 0.5F + 0.5F * (float)(objectCount + 1) / (float)parsedData.objects.size() );
         }
 
         parsedData.normals.clear();
@@ -463,10 +1298,70 @@ namespace EE
         parsedData.uvs.clear();
         parsedData.vertexIndices.clear();
 
-        delete[] indices;
+        if ( options.onMeshLoaded == nullptr && options.lodCount > 0 )
+        {
+            Timestamp lodTimer;
+            lodTimer.Begin();
+            // Each mesh is simplified by a single worker, they share nothing
+            JobSystem::ParallelFor( (uint32)info.meshes.size(), 1, [ & ]( uint32 begin, uint32 end )
+            {
+                for ( uint32 meshIndex = begin; meshIndex < end; meshIndex++ )
+                    MeshSimplifier::GenerateLODs( info.meshes[ meshIndex ], options.lodCount );
+            } );
+            lodTimer.Stop();
+            lodTime = lodTimer.GetDeltaTime<Ticker::Mili>();
+
+            for ( const MeshData& mesh : info.meshes )
+                AddLODStatistics( mesh );
 
-        timer.Stop();
-        EE_LOG_INFO( "\u2514> Allocated {0} in {1:.2f}ms", totalAllocatedSize, timer.GetDeltaTime<Ticker::Mili>() );
+            if ( ResourceLoader::IsCancelRequested() )
+                return false;
+        }
+
+        if ( options.onMeshLoaded == nullptr && options.buildMeshlets )
+        {
+            Timestamp meshletTimer;
+            meshletTimer.Begin();
+            JobSystem::ParallelFor( (uint32)info.meshes.size(), 1, [ & ]( uint32 begin, uint32 end )
+            {
+                for ( uint32 meshIndex = begin; meshIndex < end; meshIndex++ )
+                    MeshletBuilder::Build( info.meshes[ meshIndex ] );
+            } );
+            meshletTimer.Stop();
+            meshletTime = meshletTimer.GetDeltaTime<Ticker::Mili>();
+
+            for ( const MeshData& mesh : info.meshes )
+                AddMeshletStatistics( mesh );
+        }
+
+        if ( options.optimize )
+        {
+            EE_LOG_INFO(
+                "\u251C> Optimized {0} meshes in {1:.2f}ms, ACMR {2:.3f} to {3:.3f}, ATVR {4:.3f} to {5:.3f}",
+                meshCount, optimizeTime,
+                sourceCacheStatistics.GetACMR(), optimizedCacheStatistics.GetACMR(),
+                sourceCacheStatistics.GetATVR(), optimizedCacheStatistics.GetATVR()
+            );
+        }
+        if ( options.lodCount > 0 )
+        {
+            EE_LOG_INFO(
+                "\u251C> Generated {0} LODs for {1} meshes in {2:.2f}ms, {3} to {4} triangles with error up to {5:.5f}",
+                lodLevelCount, meshCount, lodTime,
+                Text::FormatUnit( lodSourceFaceCount, 2 ), Text::FormatUnit( lodLastFaceCount, 2 ),
+                lodMaxError
+            );
+        }
+        if ( options.buildMeshlets )
+        {
+            EE_LOG_INFO(
+                "\u251C> Built {0} meshlets in {1:.2f}ms, {2:.1f} triangles and {3:.1f} vertices each",
+                meshletCount, meshletTime,
+                meshletCount > 0 ? (double)meshletTriangleCount / (double)meshletCount : 0.0,
+                meshletCount > 0 ? (double)meshletVertexCount / (double)meshletCount : 0.0
+            );
+        }
+        EE_LOG_INFO( "\u2514> Allocated {0} in {1:.2f}ms", totalAllocatedSize, buildTime );
 
         info.isValid = true;
         return true;
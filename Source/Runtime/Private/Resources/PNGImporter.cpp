@@ -1,7 +1,8 @@
 
 #include <CoreMinimal.h>
 
-#include "Files/FileMap.h"
+#include "Files/MappedFileView.h"
+#include "Files/FileManager.h"
 
 #include <Core/Name.h>
 #include "Engine/Ticker.h"
@@ -20,8 +21,6 @@
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
 
-constexpr size_t kBufferBlockSize = 1u << 16u;
-
 bool EE::PNGImporter::LoadImage( ImageImporter::ImageResult& result, const ImageImporter::Options& options )
 {
 	result.Clear();
@@ -35,7 +34,7 @@ bool EE::PNGImporter::LoadImage( ImageImporter::ImageResult& result, const Image
     Timestamp timer;
 
     timer.Begin();
-    FileMap file( options.file );
+    MappedFileView file( options.file, MappedFileHint_Sequential );
     if ( file.GetError() != 0 )
     {
         EE_LOG_ERROR( "Error reading file '{}', returned code {}", options.file.GetPath(), file.GetError() );
@@ -46,29 +45,16 @@ bool EE::PNGImporter::LoadImage( ImageImporter::ImageResult& result, const Image
 
 	int32 width, height, comp;
 
-	uint64 bytesRead = 0;
-	uint64 blockSize = ((file.GetSize() / kBufferBlockSize) + 1) * kBufferBlockSize;
-	void* fileData = malloc( blockSize );
-
-	if ( file.ReadBlock( 0, blockSize, fileData ) != 0 )
-	{
-		EE_LOG_ERROR( "Error reading block of file '{}', returned code {}", options.file.GetPath(), file.GetError() );
-		return false;
-	}
-
-	if ( file.WaitForResult( &bytesRead ) != 0 )
-	{
-		EE_LOG_ERROR( "Error reading result of block of file '{}', returned code {}", options.file.GetPath(), file.GetError() );
-		return false;
-	}
+	// Decoded straight from the mapped pages
+	std::span<const uint8> fileData = file.GetData();
 
 	void* data = NULL;
 	if ( GPixelFormatInfo[ options.format ].size <= 1 )
-		data = stbi_load_from_memory( static_cast<const stbi_uc*>( fileData ), (int)bytesRead, &width, &height, &comp, GPixelFormatInfo[options.format].channels );
+		data = stbi_load_from_memory( fileData.data(), (int)fileData.size(), &width, &height, &comp, GPixelFormatInfo[options.format].channels );
 	else
-		data = stbi_loadf_from_memory( static_cast<const stbi_uc*>( fileData ), (int)bytesRead, &width, &height, &comp, GPixelFormatInfo[options.format].channels );
+		data = stbi_loadf_from_memory( fileData.data(), (int)fileData.size(), &width, &height, &comp, GPixelFormatInfo[options.format].channels );
 
-	free( fileData );
+	file.Unmap();
 	if ( data == NULL )
 	{
 		EE_LOG_ERROR( "Image '{}' couldn't be loaded: {}", options.file.GetFileName().c_str(), stbi_failure_reason() );
@@ -0,0 +1,265 @@
+#include "CoreMinimal.h"
+
+#include "Core/Collections.h"
+#include "Core/JobSystem.h"
+#include "Resources/ResourceLoader.h"
+
+#include <condition_variable>
+#include <mutex>
+
+namespace EE
+{
+    // Load running on the current thread, NULL outside of the loader jobs
+    static thread_local LoadRequest* GCurrentLoadRequest = NULL;
+
+    class ResourceLoaderPool
+    {
+    public:
+        //* Takes a reference, the first one starts the loader. With ifStopped nothing is done when it's running
+        void Start( uint32 maxLoads, bool ifStopped )
+        {
+            std::unique_lock<std::mutex> lock( _lock );
+            if ( ifStopped && _references > 0 )
+                return;
+            if ( _references++ > 0 )
+                return;
+
+            JobSystem::Initialize();
+            // Loads are long jobs, half of the workers are left for the frame work queued meanwhile
+            _maxLoads = maxLoads > 0 ? maxLoads : std::max( JobSystem::GetWorkerCount() / 2, 1u );
+        }
+
+        //* Drops a reference, the last one cancels the queued loads and waits for the running ones
+        void Stop()
+        {
+            std::unique_lock<std::mutex> lock( _lock );
+            if ( _references == 0 || --_references > 0 )
+                return;
+
+            while ( _queue.empty() == false )
+            {
+                LoadHandle request = _queue.top();
+                _queue.pop();
+                request->_cancelRequested.store( true, std::memory_order_relaxed );
+                ELoadState expected = LoadState_Queued;
+                if ( request->_state.compare_exchange_strong( expected, LoadState_Canceled, std::memory_order_acq_rel ) )
+                    _completed.push_back( request );
+            }
+            _doneCondition.wait( lock, [ this ] { return _activeLoads == 0; } );
+            _maxLoads = 0;
+            lock.unlock();
+            JobSystem::Exit();
+        }
+
+        void Push( const LoadHandle& request )
+        {
+            // Counted before a worker can finish it and run its callback
+            _pendingCount.fetch_add( 1, std::memory_order_relaxed );
+            bool startLoad = false;
+            {
+                std::unique_lock<std::mutex> lock( _lock );
+                request->_sequence = _sequence++;
+                _queue.push( request );
+                if ( _activeLoads < _maxLoads )
+                {
+                    _activeLoads++;
+                    startLoad = true;
+                }
+            }
+            if ( startLoad )
+                JobSystem::RunBackground( [ this ] { RunNextLoad(); } );
+        }
+
+        void Cancel( LoadRequest* request )
+        {
+            request->_cancelRequested.store( true, std::memory_order_relaxed );
+            std::unique_lock<std::mutex> lock( _lock );
+            ELoadState expected = LoadState_Queued;
+            if ( request->_state.compare_exchange_strong( expected, LoadState_Canceled, std::memory_order_acq_rel ) )
+            {
+                // It stays in the queue until a load skips it, the callback doesn't have to wait for that
+                _completed.push_back( request->shared_from_this() );
+                _doneCondition.notify_all();
+            }
+        }
+
+        void Wait( const LoadHandle& request )
+        {
+            std::unique_lock<std::mutex> lock( _lock );
+            _doneCondition.wait( lock, [ &request ] { return request->IsDone(); } );
+        }
+
+        void DispatchCompleted()
+        {
+            TArray<LoadHandle> completed;
+            {
+                std::unique_lock<std::mutex> lock( _lock );
+                completed.swap( _completed );
+            }
+
+            for ( LoadHandle& request : completed )
+            {
+                if ( request->_completeFunction )
+                    request->_completeFunction( request->GetState() );
+                // Releases whatever the callbacks captured, handles may outlive the loaded data
+                request->_loadFunction = nullptr;
+                request->_completeFunction = nullptr;
+                request->_hasCompleted = true;
+                _pendingCount.fetch_sub( 1, std::memory_order_relaxed );
+            }
+        }
+
+        size_t GetPendingCount() const { return _pendingCount.load( std::memory_order_relaxed ); }
+        uint32 GetMaxLoads() const { return _maxLoads; }
+
+        static ResourceLoaderPool& Get()
+        {
+            static ResourceLoaderPool pool;
+            return pool;
+        }
+
+    private:
+        struct RequestOrder
+        {
+            bool operator()( const LoadHandle& a, const LoadHandle& b ) const
+            {
+                if ( a->_priority != b->_priority )
+                    return a->_priority < b->_priority;
+                return a->_sequence > b->_sequence;
+            }
+        };
+
+        //* Background job holding one of the load slots, a JobSystem::Wait never runs it inline. It takes the best
+        //* request when it starts rather than when it was queued, and hands the slot to a new job after each load
+        void RunNextLoad()
+        {
+            LoadHandle request;
+            {
+                std::unique_lock<std::mutex> lock( _lock );
+                while ( request == NULL && _queue.empty() == false )
+                {
+                    request = _queue.top();
+                    _queue.pop();
+
+                    // Canceled while queued, already handed to the completion list
+                    ELoadState expected = LoadState_Queued;
+                    if ( request->_state.compare_exchange_strong( expected, LoadState_Loading, std::memory_order_acq_rel ) == false )
+                        request = NULL;
+                }
+
+                if ( request == NULL )
+                {
+                    _activeLoads--;
+                    _doneCondition.notify_all();
+                    return;
+                }
+            }
+
+            LoadRequest* previousRequest = GCurrentLoadRequest;
+            GCurrentLoadRequest = request.get();
+            const bool succeeded = request->_loadFunction();
+            GCurrentLoadRequest = previousRequest;
+
+            const ELoadState state = request->IsCancelRequested() ? LoadState_Canceled : succeeded ? LoadState_Finished : LoadState_Failed;
+            if ( state == LoadState_Finished )
+                request->_progress.store( 1.F, std::memory_order_relaxed );
+
+            bool startLoad = true;
+            {
+                std::unique_lock<std::mutex> lock( _lock );
+                request->_state.store( state, std::memory_order_release );
+                _completed.push_back( request );
+                if ( _queue.empty() )
+                {
+                    _activeLoads--;
+                    startLoad = false;
+                }
+            }
+            _doneCondition.notify_all();
+
+            if ( startLoad )
+                JobSystem::RunBackground( [ this ] { RunNextLoad(); } );
+        }
+
+        std::priority_queue<LoadHandle, TArray<LoadHandle>, RequestOrder> _queue;
+        TArray<LoadHandle> _completed;
+        std::mutex _lock;
+        std::condition_variable _doneCondition;
+        std::atomic<size_t> _pendingCount = 0;
+        uint64 _sequence = 0;
+        uint32 _maxLoads = 0;
+        uint32 _activeLoads = 0;
+        //* Initialize calls not matched by Exit yet, plus the one Submit takes when it starts the loader
+        uint32 _references = 0;
+    };
+
+    LoadRequest::LoadRequest( ELoadPriority priority, LoadFunction loadFunction, CompleteFunction completeFunction ) :
+        _state( LoadState_Queued ), _progress( 0.F ), _cancelRequested( false ), _priority( priority ), _sequence( 0 ), _hasCompleted( false ),
+        _loadFunction( loadFunction ), _completeFunction( completeFunction )
+    {
+    }
+
+    void LoadRequest::Cancel()
+    {
+        if ( IsDone() == false )
+            ResourceLoaderPool::Get().Cancel( this );
+    }
+
+    bool ResourceLoader::Initialize( uint32 maxConcurrentLoads )
+    {
+        ResourceLoaderPool::Get().Start( maxConcurrentLoads, false );
+        return true;
+    }
+
+    void ResourceLoader::Exit()
+    {
+        ResourceLoaderPool::Get().Stop();
+        ResourceLoaderPool::Get().DispatchCompleted();
+    }
+
+    LoadHandle ResourceLoader::Submit( ELoadPriority priority, LoadRequest::LoadFunction loadFunction, LoadRequest::CompleteFunction completeFunction )
+    {
+        // Started here it holds a reference like Initialize, the Exit of the importers stops it
+        ResourceLoaderPool& pool = ResourceLoaderPool::Get();
+        pool.Start( 0, true );
+
+        LoadHandle request = std::make_shared<LoadRequest>( priority, loadFunction, completeFunction );
+        pool.Push( request );
+        return request;
+    }
+
+    void ResourceLoader::UpdateStatus()
+    {
+        ResourceLoaderPool::Get().DispatchCompleted();
+    }
+
+    void ResourceLoader::Wait( const LoadHandle& handle )
+    {
+        if ( handle == NULL )
+            return;
+
+        ResourceLoaderPool::Get().Wait( handle );
+        ResourceLoaderPool::Get().DispatchCompleted();
+    }
+
+    size_t ResourceLoader::GetPendingCount()
+    {
+        return ResourceLoaderPool::Get().GetPendingCount();
+    }
+
+    uint32 ResourceLoader::GetMaxConcurrentLoads()
+    {
+        return ResourceLoaderPool::Get().GetMaxLoads();
+    }
+
+    void ResourceLoader::SetProgress( float progress )
+    {
+        if ( GCurrentLoadRequest != NULL )
+            GCurrentLoadRequest->_progress.store( std::clamp( progress, 0.F, 1.F ), std::memory_order_relaxed );
+    }
+
+    bool ResourceLoader::IsCancelRequested()
+    {
+        return GCurrentLoadRequest != NULL && GCurrentLoadRequest->IsCancelRequested();
+    }
+}
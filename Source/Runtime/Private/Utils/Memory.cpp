@@ -1,6 +1,10 @@
 #include "CoreMinimal.h"
 
 #include "Utils/Memory.h"
+#include "Math/CoreMath.h"
+#include "Utils/TextFormatting.h"
+
+#include <atomic>
 
 namespace EE::Memory
 {
@@ -33,9 +37,202 @@ namespace EE::Memory
 #if defined(_MSC_VER)
         _aligned_free( pointer );
 #elif ((defined(_POSIX_VERSION) && (_POSIX_VERSION >= 200112L)) || defined(__linux__) || defined(__APPLE__))
-        ::free( data );
+        ::free( pointer );
 #else
         free( ((void**)pointer)[ -1 ] );
 #endif
     }
+    // Counters of each tag, padded so threads working on different tags don't share cache lines
+    struct alignas(64) MemoryTagCounters
+    {
+        std::atomic<uint64> liveBytes;
+        std::atomic<uint64> peakBytes;
+        std::atomic<uint64> liveAllocations;
+        std::atomic<uint64> budgetBytes;
+    };
+
+    static MemoryTagCounters GMemoryTagCounters[ MemoryTag_NUM ];
+
+    // Stored right before the pointers returned by TaggedAlloc
+    struct TaggedAllocHeader
+    {
+        uint64 size;
+        uint32 offset;
+        EMemoryTag tag;
+    };
+
+    const U8Char* GetMemoryTagName( EMemoryTag tag )
+    {
+        switch ( tag )
+        {
+        case MemoryTag_Untagged:    return "Untagged";
+        case MemoryTag_Mesh:        return "Mesh";
+        case MemoryTag_PixelMap:    return "PixelMap";
+        case MemoryTag_RHI:         return "RHI";
+        case MemoryTag_Physics:     return "Physics";
+        case MemoryTag_Audio:       return "Audio";
+        case MemoryTag_Importer:    return "Importer";
+        case MemoryTag_Jobs:        return "Jobs";
+        default:                    return "Unknown";
+        }
+    }
+
+    MemoryTagStats GetMemoryTagStats( EMemoryTag tag )
+    {
+        const MemoryTagCounters& counters = GMemoryTagCounters[ tag ];
+        return MemoryTagStats
+        {
+            .liveBytes = counters.liveBytes.load( std::memory_order_relaxed ),
+            .peakBytes = counters.peakBytes.load( std::memory_order_relaxed ),
+            .liveAllocations = counters.liveAllocations.load( std::memory_order_relaxed ),
+            .budgetBytes = counters.budgetBytes.load( std::memory_order_relaxed )
+        };
+    }
+
+    void SetMemoryTagBudget( EMemoryTag tag, uint64 budgetBytes )
+    {
+        GMemoryTagCounters[ tag ].budgetBytes.store( budgetBytes, std::memory_order_relaxed );
+    }
+
+    void TrackAllocation( EMemoryTag tag, size_t size )
+    {
+        MemoryTagCounters& counters = GMemoryTagCounters[ tag ];
+        counters.liveAllocations.fetch_add( 1, std::memory_order_relaxed );
+        const uint64 previous = counters.liveBytes.fetch_add( size, std::memory_order_relaxed );
+        const uint64 live = previous + size;
+
+        uint64 peak = counters.peakBytes.load( std::memory_order_relaxed );
+        while ( live > peak && !counters.peakBytes.compare_exchange_weak( peak, live, std::memory_order_relaxed ) ) {}
+
+        // Only warn when crossing the budget, not for every allocation over it
+        const uint64 budget = counters.budgetBytes.load( std::memory_order_relaxed );
+        if ( budget > 0 && previous <= budget && live > budget )
+        {
+            EE_LOG_WARN( "Memory tag '{}' exceeded its budget of {} with {}", GetMemoryTagName( tag ), Text::FormatData( budget, 2 ), Text::FormatData( live, 2 ) );
+        }
+    }
+
+    void TrackDeallocation( EMemoryTag tag, size_t size )
+    {
+        MemoryTagCounters& counters = GMemoryTagCounters[ tag ];
+        counters.liveAllocations.fetch_sub( 1, std::memory_order_relaxed );
+        counters.liveBytes.fetch_sub( size, std::memory_order_relaxed );
+    }
+
+    void* TaggedAlloc( size_t size, size_t alignment, EMemoryTag tag )
+    {
+        alignment = Math::Max( alignment, alignof( TaggedAllocHeader ) );
+        const size_t offset = Math::Max( alignment, sizeof( TaggedAllocHeader ) );
+
+        uint8* block = static_cast<uint8*>( AlignedAlloc( size + offset, alignment ) );
+        if ( block == NULL )
+            return NULL;
+
+        TaggedAllocHeader* header = reinterpret_cast<TaggedAllocHeader*>( block + offset ) - 1;
+        header->size = size;
+        header->offset = (uint32)offset;
+        header->tag = tag;
+
+        TrackAllocation( tag, size );
+        return block + offset;
+    }
+
+    void TaggedFree( void* pointer )
+    {
+        if ( pointer == NULL )
+            return;
+
+        const TaggedAllocHeader* header = static_cast<const TaggedAllocHeader*>( pointer ) - 1;
+        TrackDeallocation( header->tag, header->size );
+        AlignedFree( static_cast<uint8*>( pointer ) - header->offset );
+    }
+
+    FrameArena* GFrameArena = NULL;
+
+    FrameArena::FrameArena( size_t capacityPerFrame, uint32 frameCount )
+        : _memory( NULL )
+        , _capacity( capacityPerFrame )
+        , _peakSize( 0 )
+        , _frameCount( frameCount )
+        , _frameIndex( 0 )
+        , _ownerThread( std::this_thread::get_id() )
+        , _frames()
+    {
+        EE_ASSERT( frameCount > 0 && frameCount <= MaxFrameCount, "Invalid frame arena count {}", frameCount );
+
+        // Keep every region starting in its own cache line
+        _capacity = (capacityPerFrame + 63) & ~size_t( 63 );
+        _memory = AlignedAlloc( _capacity * _frameCount, 64 );
+
+        for ( uint32 i = 0; i < _frameCount; i++ )
+        {
+            _frames[ i ].data = static_cast<uint8*>( _memory ) + _capacity * i;
+            _frames[ i ].offset = 0;
+            _frames[ i ].overflowSize = 0;
+        }
+    }
+
+    FrameArena::~FrameArena()
+    {
+        for ( uint32 i = 0; i < _frameCount; i++ )
+        {
+            ResetFrame( _frames[ i ] );
+        }
+
+        AlignedFree( _memory );
+    }
+
+    void* FrameArena::Allocate( size_t size, size_t alignment )
+    {
+        EE_ASSERT( IsOwningThread(), "Frame arena can only be used by its owning thread" );
+        EE_ASSERT( alignment > 0 && (alignment & (alignment - 1)) == 0, "Alignment {} is not a power of two", alignment );
+
+        FrameRegion& frame = _frames[ _frameIndex ];
+
+        uintptr_t base = reinterpret_cast<uintptr_t>( frame.data );
+        uintptr_t aligned = (base + frame.offset + alignment - 1) & ~(uintptr_t)(alignment - 1);
+        size_t end = (aligned - base) + size;
+
+        if ( end > _capacity )
+        {
+            return AllocateOverflow( frame, size, alignment );
+        }
+
+        frame.offset = end;
+        return reinterpret_cast<void*>( aligned );
+    }
+
+    void* FrameArena::AllocateOverflow( FrameRegion& frame, size_t size, size_t alignment )
+    {
+        if ( frame.overflowBlocks.empty() )
+        {
+            EE_LOG_WARN( "Frame arena region of {} bytes exhausted, falling back to heap allocations", _capacity );
+        }
+
+        void* pointer = AlignedAlloc( size, Math::Max( alignment, sizeof( void* ) ) );
+        frame.overflowBlocks.push_back( pointer );
+        frame.overflowSize += size;
+        return pointer;
+    }
+
+    void FrameArena::ResetFrame( FrameRegion& frame )
+    {
+        for ( void* block : frame.overflowBlocks )
+        {
+            AlignedFree( block );
+        }
+        frame.overflowBlocks.clear();
+        frame.overflowSize = 0;
+        frame.offset = 0;
+    }
+
+    void FrameArena::NextFrame()
+    {
+        EE_ASSERT( IsOwningThread(), "Frame arena can only be used by its owning thread" );
+
+        _peakSize = Math::Max( _peakSize, GetUsedSize() );
+
+        _frameIndex = (_frameIndex + 1) % _frameCount;
+        ResetFrame( _frames[ _frameIndex ] );
+    }
 }
\ No newline at end of file
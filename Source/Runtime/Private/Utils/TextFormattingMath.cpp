@@ -3,101 +3,546 @@
 
 #include "Utils/TextFormattingMath.h"
 
+#include <bit>
+#include <charconv>
+#include <cstring>
+#include <limits>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 namespace EE
 {
-    // Original crack_atof version is at http://crackprogramming.blogspot.sg/2012/10/implement-atof.html
-    // But it cannot convert floating point with high +/- exponent.
-    // The version below by Tian Bo fixes that problem and improves performance by 10%
-    // http://coliru.stacked-crooked.com/a/2e28f0d71f47ca5e
-    float Text::ParseFloat( std::string_view* text )
+    // Decimal to float conversion after the Eisel-Lemire algorithm as done in fast_float
+    // https://github.com/fastfloat/fast_float, results are correctly rounded to nearest even like strtof
+    namespace FloatParsing
     {
-        if ( text->empty() )
-            return 0;
+        constexpr int32 kSmallestPowerOfTen = -64;
+        constexpr int32 kLargestPowerOfTen = 38;
+        constexpr int32 kMantissaBits = 23;
+        constexpr int32 kMinimumExponent = -127;
+        constexpr int32 kInfinitePower = 0xFF;
+        constexpr int32 kMaxDigits = 19;
 
-        int sign = 1;
-        float intPart = 0.0;
-        float fractionPart = 0.0;
-        bool hasFraction = false;
-        bool hasExpo = false;
+        // Truncated 128 bit 5^q for q in [kSmallestPowerOfTen, kLargestPowerOfTen], most significant bit set
+        static constexpr uint64 kPowersOfFive[] =
+        {
+        0xA87FEA27A539E9A5ULL, 0x3F2398D747B36224ULL,
+        0xD29FE4B18E88640EULL, 0x8EEC7F0D19A03AADULL,
+        0x83A3EEEEF9153E89ULL, 0x1953CF68300424ACULL,
+        0xA48CEAAAB75A8E2BULL, 0x5FA8C3423C052DD7ULL,
+        0xCDB02555653131B6ULL, 0x3792F412CB06794DULL,
+        0x808E17555F3EBF11ULL, 0xE2BBD88BBEE40BD0ULL,
+        0xA0B19D2AB70E6ED6ULL, 0x5B6ACEAEAE9D0EC4ULL,
+        0xC8DE047564D20A8BULL, 0xF245825A5A445275ULL,
+        0xFB158592BE068D2EULL, 0xEED6E2F0F0D56712ULL,
+        0x9CED737BB6C4183DULL, 0x55464DD69685606BULL,
+        0xC428D05AA4751E4CULL, 0xAA97E14C3C26B886ULL,
+        0xF53304714D9265DFULL, 0xD53DD99F4B3066A8ULL,
+        0x993FE2C6D07B7FABULL, 0xE546A8038EFE4029ULL,
+        0xBF8FDB78849A5F96ULL, 0xDE98520472BDD033ULL,
+        0xEF73D256A5C0F77CULL, 0x963E66858F6D4440ULL,
+        0x95A8637627989AADULL, 0xDDE7001379A44AA8ULL,
+        0xBB127C53B17EC159ULL, 0x5560C018580D5D52ULL,
+        0xE9D71B689DDE71AFULL, 0xAAB8F01E6E10B4A6ULL,
+        0x9226712162AB070DULL, 0xCAB3961304CA70E8ULL,
+        0xB6B00D69BB55C8D1ULL, 0x3D607B97C5FD0D22ULL,
+        0xE45C10C42A2B3B05ULL, 0x8CB89A7DB77C506AULL,
+        0x8EB98A7A9A5B04E3ULL, 0x77F3608E92ADB242ULL,
+        0xB267ED1940F1C61CULL, 0x55F038B237591ED3ULL,
+        0xDF01E85F912E37A3ULL, 0x6B6C46DEC52F6688ULL,
+        0x8B61313BBABCE2C6ULL, 0x2323AC4B3B3DA015ULL,
+        0xAE397D8AA96C1B77ULL, 0xABEC975E0A0D081AULL,
+        0xD9C7DCED53C72255ULL, 0x96E7BD358C904A21ULL,
+        0x881CEA14545C7575ULL, 0x7E50D64177DA2E54ULL,
+        0xAA242499697392D2ULL, 0xDDE50BD1D5D0B9E9ULL,
+        0xD4AD2DBFC3D07787ULL, 0x955E4EC64B44E864ULL,
+        0x84EC3C97DA624AB4ULL, 0xBD5AF13BEF0B113EULL,
+        0xA6274BBDD0FADD61ULL, 0xECB1AD8AEACDD58EULL,
+        0xCFB11EAD453994BAULL, 0x67DE18EDA5814AF2ULL,
+        0x81CEB32C4B43FCF4ULL, 0x80EACF948770CED7ULL,
+        0xA2425FF75E14FC31ULL, 0xA1258379A94D028DULL,
+        0xCAD2F7F5359A3B3EULL, 0x096EE45813A04330ULL,
+        0xFD87B5F28300CA0DULL, 0x8BCA9D6E188853FCULL,
+        0x9E74D1B791E07E48ULL, 0x775EA264CF55347EULL,
+        0xC612062576589DDAULL, 0x95364AFE032A819EULL,
+        0xF79687AED3EEC551ULL, 0x3A83DDBD83F52205ULL,
+        0x9ABE14CD44753B52ULL, 0xC4926A9672793543ULL,
+        0xC16D9A0095928A27ULL, 0x75B7053C0F178294ULL,
+        0xF1C90080BAF72CB1ULL, 0x5324C68B12DD6339ULL,
+        0x971DA05074DA7BEEULL, 0xD3F6FC16EBCA5E04ULL,
+        0xBCE5086492111AEAULL, 0x88F4BB1CA6BCF585ULL,
+        0xEC1E4A7DB69561A5ULL, 0x2B31E9E3D06C32E6ULL,
+        0x9392EE8E921D5D07ULL, 0x3AFF322E62439FD0ULL,
+        0xB877AA3236A4B449ULL, 0x09BEFEB9FAD487C3ULL,
+        0xE69594BEC44DE15BULL, 0x4C2EBE687989A9B4ULL,
+        0x901D7CF73AB0ACD9ULL, 0x0F9D37014BF60A11ULL,
+        0xB424DC35095CD80FULL, 0x538484C19EF38C95ULL,
+        0xE12E13424BB40E13ULL, 0x2865A5F206B06FBAULL,
+        0x8CBCCC096F5088CBULL, 0xF93F87B7442E45D4ULL,
+        0xAFEBFF0BCB24AAFEULL, 0xF78F69A51539D749ULL,
+        0xDBE6FECEBDEDD5BEULL, 0xB573440E5A884D1CULL,
+        0x89705F4136B4A597ULL, 0x31680A88F8953031ULL,
+        0xABCC77118461CEFCULL, 0xFDC20D2B36BA7C3EULL,
+        0xD6BF94D5E57A42BCULL, 0x3D32907604691B4DULL,
+        0x8637BD05AF6C69B5ULL, 0xA63F9A49C2C1B110ULL,
+        0xA7C5AC471B478423ULL, 0x0FCF80DC33721D54ULL,
+        0xD1B71758E219652BULL, 0xD3C36113404EA4A9ULL,
+        0x83126E978D4FDF3BULL, 0x645A1CAC083126EAULL,
+        0xA3D70A3D70A3D70AULL, 0x3D70A3D70A3D70A4ULL,
+        0xCCCCCCCCCCCCCCCCULL, 0xCCCCCCCCCCCCCCCDULL,
+        0x8000000000000000ULL, 0x0000000000000000ULL,
+        0xA000000000000000ULL, 0x0000000000000000ULL,
+        0xC800000000000000ULL, 0x0000000000000000ULL,
+        0xFA00000000000000ULL, 0x0000000000000000ULL,
+        0x9C40000000000000ULL, 0x0000000000000000ULL,
+        0xC350000000000000ULL, 0x0000000000000000ULL,
+        0xF424000000000000ULL, 0x0000000000000000ULL,
+        0x9896800000000000ULL, 0x0000000000000000ULL,
+        0xBEBC200000000000ULL, 0x0000000000000000ULL,
+        0xEE6B280000000000ULL, 0x0000000000000000ULL,
+        0x9502F90000000000ULL, 0x0000000000000000ULL,
+        0xBA43B74000000000ULL, 0x0000000000000000ULL,
+        0xE8D4A51000000000ULL, 0x0000000000000000ULL,
+        0x9184E72A00000000ULL, 0x0000000000000000ULL,
+        0xB5E620F480000000ULL, 0x0000000000000000ULL,
+        0xE35FA931A0000000ULL, 0x0000000000000000ULL,
+        0x8E1BC9BF04000000ULL, 0x0000000000000000ULL,
+        0xB1A2BC2EC5000000ULL, 0x0000000000000000ULL,
+        0xDE0B6B3A76400000ULL, 0x0000000000000000ULL,
+        0x8AC7230489E80000ULL, 0x0000000000000000ULL,
+        0xAD78EBC5AC620000ULL, 0x0000000000000000ULL,
+        0xD8D726B7177A8000ULL, 0x0000000000000000ULL,
+        0x878678326EAC9000ULL, 0x0000000000000000ULL,
+        0xA968163F0A57B400ULL, 0x0000000000000000ULL,
+        0xD3C21BCECCEDA100ULL, 0x0000000000000000ULL,
+        0x84595161401484A0ULL, 0x0000000000000000ULL,
+        0xA56FA5B99019A5C8ULL, 0x0000000000000000ULL,
+        0xCECB8F27F4200F3AULL, 0x0000000000000000ULL,
+        0x813F3978F8940984ULL, 0x4000000000000000ULL,
+        0xA18F07D736B90BE5ULL, 0x5000000000000000ULL,
+        0xC9F2C9CD04674EDEULL, 0xA400000000000000ULL,
+        0xFC6F7C4045812296ULL, 0x4D00000000000000ULL,
+        0x9DC5ADA82B70B59DULL, 0xF020000000000000ULL,
+        0xC5371912364CE305ULL, 0x6C28000000000000ULL,
+        0xF684DF56C3E01BC6ULL, 0xC732000000000000ULL,
+        0x9A130B963A6C115CULL, 0x3C7F400000000000ULL,
+        0xC097CE7BC90715B3ULL, 0x4B9F100000000000ULL,
+        0xF0BDC21ABB48DB20ULL, 0x1E86D40000000000ULL,
+        0x96769950B50D88F4ULL, 0x1314448000000000ULL
+        };
 
-        // Take care of +/- sign
-        if ( (*text)[ 0 ] == '-' ) { text->remove_prefix( 1 ); sign = -1; }
-        else if ( (*text)[ 0 ] == '+' ) text->remove_prefix( 1 );
+        static constexpr double kExactPowersOfTen[] =
+        {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
 
-        while ( text->empty() != true && (*text)[ 0 ] != '\0' && (*text)[ 0 ] != ',' && (*text)[ 0 ] != ' ' )
+        static constexpr double kInversePowersOfTen[] =
         {
-            if ( (*text)[ 0 ] >= '0' && (*text)[ 0 ] <= '9' )
-                intPart = intPart * 10 + ((*text)[ 0 ] - '0');
-            else if ( (*text)[ 0 ] == '.' )
+            1e-0, 1e-1, 1e-2, 1e-3, 1e-4, 1e-5, 1e-6, 1e-7, 1e-8, 1e-9, 1e-10, 1e-11,
+            1e-12, 1e-13, 1e-14, 1e-15, 1e-16, 1e-17, 1e-18, 1e-19, 1e-20, 1e-21, 1e-22
+        };
+
+        struct Decimal
+        {
+            uint64 mantissa;
+            int64 exponent;
+            bool negative;
+            // More than kMaxDigits significant digits, mantissa holds the first ones only
+            bool truncated;
+        };
+
+        FORCEINLINE static bool IsDigit( U8Char character )
+        {
+            return (uint8)(character - '0') < 10;
+        }
+
+        static constexpr uint64 kPowersOfTen[] = { 1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL };
+
+        //* Value of eight digits already offset by '0', the first one in the lowest byte
+        FORCEINLINE static uint64 ParseEightDigits( uint64 value )
+        {
+            value = (value * 10) + (value >> 8);
+            return (((value & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) +
+                (((value >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >> 32;
+        }
+
+        //* Accumulates the digits at it into mantissa, eight bytes are classified at once while they can be read
+        FORCEINLINE static const U8Char* ParseDigits( const U8Char* it, const U8Char* last, uint64* mantissa )
+        {
+            while ( last - it >= 8 )
             {
-                hasFraction = true;
-                text->remove_prefix( 1 ); break;
+                uint64 word;
+                memcpy( &word, it, sizeof( uint64 ) );
+                const uint64 value = word - 0x3030303030303030ULL;
+                // High bit set on every byte that isn't a digit, borrows only corrupt bytes after the first one
+                const uint64 nonDigits = ((value + 0x7676767676767676ULL) | value) & 0x8080808080808080ULL;
+                if ( nonDigits == 0 )
+                {
+                    *mantissa = *mantissa * 100000000ULL + ParseEightDigits( value );
+                    it += 8;
+                    continue;
+                }
+
+                const uint32 count = (uint32)std::countr_zero( nonDigits ) / 8;
+                if ( count > 0 )
+                {
+                    // Shifting drops the bytes after the digits and leaves zeros in front
+                    *mantissa = *mantissa * kPowersOfTen[ count ] + ParseEightDigits( value << (64 - count * 8) );
+                    it += count;
+                }
+                return it;
             }
-            else if ( (*text)[ 0 ] == 'e' )
+
+            while ( it != last && IsDigit( *it ) )
             {
-                hasExpo = true;
-                text->remove_prefix( 1 ); break;
+                *mantissa = *mantissa * 10 + (uint64)(*it - '0');
+                ++it;
             }
-            else
-            {
-                break;
-            }
-            text->remove_prefix( 1 );
+            return it;
+        }
+
+        FORCEINLINE static void FullMultiply( uint64 a, uint64 b, uint64* high, uint64* low )
+        {
+#if defined(__SIZEOF_INT128__)
+            const unsigned __int128 product = (unsigned __int128)a * b;
+            *high = (uint64)(product >> 64);
+            *low = (uint64)product;
+#elif defined(_MSC_VER) && defined(_M_X64)
+            *low = _umul128( a, b, high );
+#else
+            const uint64 aLow = (uint32)a, aHigh = a >> 32, bLow = (uint32)b, bHigh = b >> 32;
+            const uint64 lowLow = aLow * bLow, highLow = aHigh * bLow, lowHigh = aLow * bHigh;
+            const uint64 middle = (lowLow >> 32) + (uint32)highLow + (uint32)lowHigh;
+            *low = (middle << 32) | (uint32)lowLow;
+            *high = aHigh * bHigh + (highLow >> 32) + (lowHigh >> 32) + (middle >> 32);
+#endif
         }
 
-        if ( hasFraction )
+        //* Returns the biased exponent and mantissa bits of w * 10^q
+        static void ComputeFloat( int64 q, uint64 w, int32* outPower2, uint64* outMantissa )
         {
-            float fractionExponential = 0.1F;
+            if ( w == 0 || q < kSmallestPowerOfTen )
+            {
+                *outPower2 = 0; *outMantissa = 0;
+                return;
+            }
+            if ( q > kLargestPowerOfTen )
+            {
+                *outPower2 = kInfinitePower; *outMantissa = 0;
+                return;
+            }
+
+            const int32 leadingZeros = std::countl_zero( w );
+            w <<= leadingZeros;
+
+            // 64 bit products are enough except when the bits below the rounding precision are all set
+            const uint32 index = 2 * (uint32)(q - kSmallestPowerOfTen);
+            uint64 high, low;
+            FullMultiply( w, kPowersOfFive[ index ], &high, &low );
+            constexpr uint64 kPrecisionMask = ~0ULL >> (kMantissaBits + 3);
+            if ( (high & kPrecisionMask) == kPrecisionMask )
+            {
+                uint64 secondHigh, secondLow;
+                FullMultiply( w, kPowersOfFive[ index + 1 ], &secondHigh, &secondLow );
+                low += secondHigh;
+                if ( secondHigh > low )
+                    high++;
+            }
+
+            const int32 upperBit = (int32)(high >> 63);
+            const int32 shift = upperBit + 64 - kMantissaBits - 3;
+            uint64 mantissa = high >> shift;
+            // floor(log2(10^q)) + 63
+            int32 power2 = (int32)(((152170 + 65536) * q) >> 16) + 63 + upperBit - leadingZeros - kMinimumExponent;
 
-            while ( text->empty() != true && (*text)[ 0 ] != '\0' && (*text)[ 0 ] != ',' && (*text)[ 0 ] != ' ' )
+            if ( power2 <= 0 )
             {
-                if ( (*text)[ 0 ] >= '0' && (*text)[ 0 ] <= '9' )
+                // Subnormal
+                if ( -power2 + 1 >= 64 )
                 {
-                    fractionPart += fractionExponential * ((*text)[ 0 ] - '0');
-                    fractionExponential *= 0.1F;
+                    *outPower2 = 0; *outMantissa = 0;
+                    return;
                 }
-                else if ( (*text)[ 0 ] == 'e' )
+                mantissa >>= -power2 + 1;
+                mantissa += mantissa & 1;
+                mantissa >>= 1;
+                *outPower2 = mantissa < (1ULL << kMantissaBits) ? 0 : 1;
+                *outMantissa = mantissa;
+                return;
+            }
+
+            // Exactly halfway between two floats, can only happen for small q, round to even
+            if ( low <= 1 && q >= -17 && q <= 10 && (mantissa & 3) == 1 && (mantissa << shift) == high )
+                mantissa &= ~1ULL;
+
+            mantissa += mantissa & 1;
+            mantissa >>= 1;
+            if ( mantissa >= (2ULL << kMantissaBits) )
+            {
+                mantissa = 1ULL << kMantissaBits;
+                power2++;
+            }
+            mantissa &= ~(1ULL << kMantissaBits);
+
+            if ( power2 >= kInfinitePower )
+            {
+                power2 = kInfinitePower;
+                mantissa = 0;
+            }
+            *outPower2 = power2;
+            *outMantissa = mantissa;
+        }
+
+        FORCEINLINE static bool IsFastPath( const Decimal& decimal )
+        {
+            return decimal.exponent >= -22 && decimal.exponent <= 22 && decimal.mantissa <= (1ULL << 53) && decimal.truncated == false;
+        }
+
+        // The sign is OR'ed in, numbers of both signs are mixed in vertex data so a branch would mispredict
+        FORCEINLINE static float ApplySign( float value, bool negative )
+        {
+            return std::bit_cast<float>( std::bit_cast<uint32>( value ) | ((uint32)negative << 31) );
+        }
+
+        //* Both the mantissa and the power of ten are exact doubles so one operation rounds the double correctly.
+        //* Rounding that double to float is correct unless it landed exactly between two floats, then it returns false
+        FORCEINLINE static bool FastPathToFloat( const Decimal& decimal, float* outValue )
+        {
+            // Values in the fast path range are always normal floats, the 29 bits float drops tell how close to halfway it is
+            constexpr uint64 kDroppedBits = 0x1FFFFFFFULL;
+            constexpr uint64 kHalfway = 0x10000000ULL;
+
+            double value = (double)decimal.mantissa;
+            if ( decimal.exponent >= 0 )
+            {
+                value *= kExactPowersOfTen[ decimal.exponent ];
+            }
+            else
+            {
+                // Multiplying by the rounded inverse is off by at most two ulps, far from halfway that can't change the float
+                const double approximation = value * kInversePowersOfTen[ -decimal.exponent ];
+                if ( (std::bit_cast<uint64>( approximation ) & kDroppedBits) - (kHalfway - 4) > 8 )
                 {
-                    hasExpo = true;
-                    text->remove_prefix( 1 );
-                    break;
+                    *outValue = ApplySign( (float)approximation, decimal.negative );
+                    return true;
                 }
-                else
+                value /= kExactPowersOfTen[ -decimal.exponent ];
+            }
+
+            if ( (std::bit_cast<uint64>( value ) & kDroppedBits) == kHalfway )
+                return false;
+            *outValue = ApplySign( (float)value, decimal.negative );
+            return true;
+        }
+
+        static float ToFloat( const Decimal& decimal, const U8Char* begin, const U8Char* end )
+        {
+            float value;
+            if ( IsFastPath( decimal ) && FastPathToFloat( decimal, &value ) )
+                return value;
+
+            int32 power2;
+            uint64 mantissa;
+            ComputeFloat( decimal.exponent, decimal.mantissa, &power2, &mantissa );
+            if ( decimal.truncated )
+            {
+                // The dropped digits may change the rounding, only when w and w + 1 disagree the slow path is needed
+                int32 upperPower2;
+                uint64 upperMantissa;
+                ComputeFloat( decimal.exponent, decimal.mantissa + 1, &upperPower2, &upperMantissa );
+                if ( upperPower2 != power2 || upperMantissa != mantissa )
                 {
-                    return sign * (intPart + fractionPart);
+                    value = 0;
+                    // Out of range leaves the value untouched, the upper bound tells an overflow from an underflow
+                    if ( std::from_chars( begin, end, value ).ec == std::errc::result_out_of_range )
+                        value = upperPower2 == kInfinitePower ? std::numeric_limits<float>::infinity() : 0.F;
+                    return ApplySign( value, decimal.negative );
                 }
-                text->remove_prefix( 1 );
             }
+
+            const uint32 bits = (uint32)mantissa | ((uint32)power2 << kMantissaBits) | ((uint32)decimal.negative << 31);
+            return std::bit_cast<float>( bits );
         }
 
-        float exponentPart = 1.0;
-        if ( hasExpo && text->empty() != true && ((*text)[ 0 ] != '\0' && (*text)[ 0 ] != ',' && (*text)[ 0 ] != ' ') )
+        //* Reads [+-]digits[.digits][(e|E)[+-]digits] from a non empty text, begin and end delimit the unsigned number for the slow path
+        FORCEINLINE static bool ParseDecimal( std::string_view* text, Decimal* decimal, const U8Char** begin, const U8Char** end )
         {
-            int32 exponentSign = 1;
-            if ( (*text)[ 0 ] == '-' )
+            const U8Char* it = text->data();
+            const U8Char* const last = it + text->size();
+
+            // Text is never empty here, the sign is skipped without a branch since both signs are equally likely
+            decimal->negative = *it == '-';
+            it += (*it == '-') | (*it == '+');
+            *begin = it;
+
+            uint64 mantissa = 0;
+            // Integer parts are mostly short, the eight byte scan only pays off for the fraction
+            const U8Char* const integerBegin = it;
+            while ( it != last && IsDigit( *it ) )
             {
-                exponentSign = -1;
-                text->remove_prefix( 1 );
+                mantissa = mantissa * 10 + (uint64)(*it - '0');
+                ++it;
             }
-            else if ( (*text)[ 0 ] == '+' )
+            const U8Char* const integerEnd = it;
+            const U8Char* fractionBegin = it;
+            const U8Char* fractionEnd = it;
+
+            if ( it != last && *it == '.' )
             {
-                text->remove_prefix( 1 );
+                ++it;
+                fractionBegin = it;
+                it = ParseDigits( it, last, &mantissa );
+                fractionEnd = it;
             }
 
-            int32 e = 0;
-            while ( text->empty() != true && ((*text)[ 0 ] != '\0' && (*text)[ 0 ] != ',' && (*text)[ 0 ] != ' ') && (*text)[ 0 ] >= '0' && (*text)[ 0 ] <= '9' )
+            int64 digitCount = (integerEnd - integerBegin) + (fractionEnd - fractionBegin);
+            if ( digitCount == 0 )
+                return false;
+
+            int64 explicitExponent = 0;
+            if ( it != last && (*it == 'e' || *it == 'E') )
             {
-                e = e * 10 + (*text)[ 0 ] - '0';
-                text->remove_prefix( 1 );
+                const U8Char* exponentIt = it + 1;
+                bool negativeExponent = false;
+                if ( exponentIt != last && (*exponentIt == '-' || *exponentIt == '+') )
+                {
+                    negativeExponent = *exponentIt == '-';
+                    ++exponentIt;
+                }
+                if ( exponentIt != last && IsDigit( *exponentIt ) )
+                {
+                    while ( exponentIt != last && IsDigit( *exponentIt ) )
+                    {
+                        if ( explicitExponent < 0x10000000 )
+                            explicitExponent = explicitExponent * 10 + (*exponentIt - '0');
+                        ++exponentIt;
+                    }
+                    if ( negativeExponent )
+                        explicitExponent = -explicitExponent;
+                    it = exponentIt;
+                }
+            }
+            *end = it;
+            text->remove_prefix( it - text->data() );
+
+            int64 exponent = (fractionBegin - fractionEnd) + explicitExponent;
+            decimal->truncated = false;
+            if ( digitCount > kMaxDigits )
+            {
+                // Leading zeros are not significant
+                for ( const U8Char* digit = integerBegin; digit != fractionEnd && (*digit == '0' || *digit == '.'); ++digit )
+                {
+                    if ( *digit == '0' )
+                        --digitCount;
+                }
+
+                if ( digitCount > kMaxDigits )
+                {
+                    // Keep the first kMaxDigits significant digits, the exponent accounts for the dropped ones
+                    constexpr uint64 kMinNineteenDigits = 1000000000000000000ULL;
+                    const U8Char* digit = integerBegin;
+                    mantissa = 0;
+                    while ( mantissa < kMinNineteenDigits && digit != integerEnd )
+                        mantissa = mantissa * 10 + (uint64)(*digit++ - '0');
+
+                    if ( mantissa >= kMinNineteenDigits )
+                    {
+                        exponent = (integerEnd - digit) + explicitExponent;
+                    }
+                    else
+                    {
+                        digit = fractionBegin;
+                        while ( mantissa < kMinNineteenDigits && digit != fractionEnd )
+                            mantissa = mantissa * 10 + (uint64)(*digit++ - '0');
+                        exponent = (fractionBegin - digit) + explicitExponent;
+                    }
+                    decimal->truncated = true;
+                }
             }
 
-            exponentPart = Math::Pow10<float, int32>( exponentSign * e );
+            decimal->mantissa = mantissa;
+            decimal->exponent = exponent;
+            return true;
+        }
+
+        FORCEINLINE static void SkipBlanks( std::string_view* text )
+        {
+            size_t index = 0;
+            while ( index < text->size() && ((*text)[ index ] == ' ' || (*text)[ index ] == '\t') )
+                ++index;
+            text->remove_prefix( index );
+        }
+
+        //* Consumes the separator after a number so the next value can be read
+        FORCEINLINE static void SkipSeparator( std::string_view* text )
+        {
+            if ( text->empty() == false && ((*text)[ 0 ] == ' ' || (*text)[ 0 ] == '\t' || (*text)[ 0 ] == ',') )
+                text->remove_prefix( 1 );
         }
+    }
+
+    float Text::ParseFloat( std::string_view* text )
+    {
+        using namespace FloatParsing;
+
+        SkipBlanks( text );
+        if ( text->empty() )
+            return 0;
 
-        if ( text->empty() == false )
+        Decimal decimal;
+        const U8Char* begin;
+        const U8Char* end;
+        if ( ParseDecimal( text, &decimal, &begin, &end ) == false )
+        {
+            // Not a number, skip a character so callers reading in a loop always advance
             text->remove_prefix( 1 );
+            return 0;
+        }
+        SkipSeparator( text );
+
+        float value;
+        if ( IsFastPath( decimal ) && FastPathToFloat( decimal, &value ) )
+            return value;
+        return ToFloat( decimal, begin, end );
+    }
+
+    void Text::ParseFloat3( std::string_view* text, Vector3f& outValue )
+    {
+        using namespace FloatParsing;
+
+        // Digits of the three values are read first, the common short values then convert without branches between them
+        Decimal decimals[ 3 ];
+        const U8Char* begins[ 3 ];
+        const U8Char* ends[ 3 ];
+        bool isValid[ 3 ];
+        for ( uint32 i = 0; i < 3; i++ )
+        {
+            SkipBlanks( text );
+            isValid[ i ] = text->empty() == false && ParseDecimal( text, &decimals[ i ], &begins[ i ], &ends[ i ] );
+            if ( isValid[ i ] == false )
+            {
+                decimals[ i ] = Decimal{ 0, 0, false, false };
+                if ( text->empty() == false )
+                    text->remove_prefix( 1 );
+            }
+            SkipSeparator( text );
+        }
+
+        float values[ 3 ];
+        const bool isFastPath = IsFastPath( decimals[ 0 ] ) && IsFastPath( decimals[ 1 ] ) && IsFastPath( decimals[ 2 ] )
+            && (FastPathToFloat( decimals[ 0 ], &values[ 0 ] ) & FastPathToFloat( decimals[ 1 ], &values[ 1 ] ) & FastPathToFloat( decimals[ 2 ], &values[ 2 ] ));
+        if ( isFastPath == false )
+        {
+            for ( uint32 i = 0; i < 3; i++ )
+                values[ i ] = isValid[ i ] ? ToFloat( decimals[ i ], begins[ i ], ends[ i ] ) : 0;
+        }
 
-        return sign * (intPart + fractionPart) * exponentPart;
+        outValue.x = values[ 0 ];
+        outValue.y = values[ 1 ];
+        outValue.z = values[ 2 ];
     }
 
     int32 Text::ParseInt( std::string_view* text )
@@ -0,0 +1,79 @@
+#include "CoreMinimal.h"
+
+#include "Utils/TextScanner.h"
+
+#include <bit>
+#include <cstring>
+
+#if defined(__AVX2__)
+#define EE_TEXTSCANNER_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define EE_TEXTSCANNER_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace EE
+{
+    // Writes the set bits of a comparison mask as offsets, lines are short so masks rarely have more than a few bits
+    FORCEINLINE static size_t WriteMaskOffsets( uint32 mask, size_t base, uint32* outOffsets )
+    {
+        size_t count = 0;
+        while ( mask != 0 )
+        {
+            outOffsets[ count++ ] = (uint32)(base + std::countr_zero( mask ));
+            mask &= mask - 1;
+        }
+        return count;
+    }
+
+    size_t Text::FindLineEnds( std::string_view text, uint32* outLineEnds )
+    {
+        const U8Char* data = text.data();
+        const size_t size = text.size();
+        size_t count = 0;
+        size_t i = 0;
+
+#if defined(EE_TEXTSCANNER_AVX2)
+        const __m256i newLine = _mm256_set1_epi8( '\n' );
+        for ( ; i + 32 <= size; i += 32 )
+        {
+            const __m256i chunk = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( data + i ) );
+            const uint32 mask = (uint32)_mm256_movemask_epi8( _mm256_cmpeq_epi8( chunk, newLine ) );
+            count += WriteMaskOffsets( mask, i, outLineEnds + count );
+        }
+#endif
+#if defined(EE_TEXTSCANNER_AVX2) || defined(EE_TEXTSCANNER_SSE2)
+        const __m128i newLine16 = _mm_set1_epi8( '\n' );
+        for ( ; i + 16 <= size; i += 16 )
+        {
+            const __m128i chunk = _mm_loadu_si128( reinterpret_cast<const __m128i*>( data + i ) );
+            const uint32 mask = (uint32)_mm_movemask_epi8( _mm_cmpeq_epi8( chunk, newLine16 ) );
+            count += WriteMaskOffsets( mask, i, outLineEnds + count );
+        }
+#else
+        // Without SIMD words that have no new line are skipped eight bytes at a time
+        for ( ; i + 8 <= size; i += 8 )
+        {
+            uint64 word;
+            memcpy( &word, data + i, sizeof( uint64 ) );
+            word ^= 0x0A0A0A0A0A0A0A0AULL;
+            if ( ((word - 0x0101010101010101ULL) & ~word & 0x8080808080808080ULL) == 0 )
+                continue;
+
+            for ( size_t j = i; j < i + 8; j++ )
+            {
+                if ( data[ j ] == '\n' )
+                    outLineEnds[ count++ ] = (uint32)j;
+            }
+        }
+#endif
+        for ( ; i < size; i++ )
+        {
+            if ( data[ i ] == '\n' )
+                outLineEnds[ count++ ] = (uint32)i;
+        }
+
+        return count;
+    }
+}
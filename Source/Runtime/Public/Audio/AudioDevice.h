@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Core/Collections.h"
+#include "Utils/Memory.h"
 #include "Audio/AudioSample.h"
 
 namespace EE
@@ -51,6 +52,8 @@ namespace EE
 		uint32 deviceID_;
 
 		TMap<size_t, SamplePlayInfo *> PlayInfoList;
+
+		Memory::TPool<SamplePlayInfo> PlayInfoPool;
 	};
 
 }
\ No newline at end of file
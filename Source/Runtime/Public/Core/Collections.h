@@ -7,8 +7,8 @@
 #include <unordered_set>
 #include <iterator>
 
-template<class T>
-using TArray = std::vector<T>;
+template<class T, class Allocator = std::allocator<T>>
+using TArray = std::vector<T, Allocator>;
 template<class T>
 using TArrayInitializer = std::initializer_list<T>;
 template<class T>
@@ -16,4 +16,7 @@ using TList = std::list<T>;
 template<class T>
 using TQueue = std::queue<T>;
 template<class K, class T>
-using TMap = std::unordered_map<K, T>;
\ No newline at end of file
+using TMap = std::unordered_map<K, T>;
+
+#include "Core/FlatMap.h"
+#include "Core/InlineArray.h"
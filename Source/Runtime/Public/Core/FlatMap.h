@@ -0,0 +1,520 @@
+#pragma once
+
+#include <functional>
+#include <utility>
+#include <tuple>
+#include <type_traits>
+#include <new>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define EE_FLATMAP_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace EE
+{
+    namespace FlatMapInternal
+    {
+        // Control bytes, full slots store the lower 7 bits of the hash
+        constexpr int8 kEmpty = -128;
+        constexpr int8 kDeleted = -2;
+
+        constexpr uint32 kGroupWidth = 16;
+
+        FORCEINLINE bool IsFull( int8 control ) { return control >= 0; }
+
+        FORCEINLINE uint32 CountTrailingZeros( uint32 mask )
+        {
+#if defined(_MSC_VER)
+            unsigned long index;
+            _BitScanForward( &index, mask );
+            return (uint32)index;
+#else
+            return (uint32)__builtin_ctz( mask );
+#endif
+        }
+
+        // Mix the bits of the hash, std::hash is the identity for integers on most platforms
+        FORCEINLINE uint64 MixHash( uint64 hash )
+        {
+            hash *= 0x9E3779B97F4A7C15ull;
+            return hash ^ (hash >> 32);
+        }
+
+        // Matches 16 control bytes at once, returns a bitmask with one bit per matching byte
+        struct Group
+        {
+#ifdef EE_FLATMAP_SSE2
+            __m128i controls;
+
+            FORCEINLINE explicit Group( const int8* position ) : controls( _mm_loadu_si128( reinterpret_cast<const __m128i*>( position ) ) ) { }
+
+            FORCEINLINE uint32 Match( int8 hash ) const
+            {
+                return (uint32)_mm_movemask_epi8( _mm_cmpeq_epi8( _mm_set1_epi8( hash ), controls ) );
+            }
+
+            FORCEINLINE uint32 MatchEmpty() const
+            {
+                return Match( kEmpty );
+            }
+
+            FORCEINLINE uint32 MatchEmptyOrDeleted() const
+            {
+                // Empty and deleted are the only control values below -1
+                return (uint32)_mm_movemask_epi8( _mm_cmpgt_epi8( _mm_set1_epi8( -1 ), controls ) );
+            }
+#else
+            const int8* controls;
+
+            FORCEINLINE explicit Group( const int8* position ) : controls( position ) { }
+
+            FORCEINLINE uint32 Match( int8 hash ) const
+            {
+                uint32 mask = 0;
+                for ( uint32 i = 0; i < kGroupWidth; i++ )
+                    mask |= (uint32)(controls[ i ] == hash) << i;
+                return mask;
+            }
+
+            FORCEINLINE uint32 MatchEmpty() const
+            {
+                return Match( kEmpty );
+            }
+
+            FORCEINLINE uint32 MatchEmptyOrDeleted() const
+            {
+                uint32 mask = 0;
+                for ( uint32 i = 0; i < kGroupWidth; i++ )
+                    mask |= (uint32)(controls[ i ] < -1) << i;
+                return mask;
+            }
+#endif
+        };
+    }
+
+    // Open addressing hash map with the layout of a Swiss table: one control byte per slot holding 7 bits of the hash,
+    // probed 16 slots at a time. Elements are stored inline, so references and iterators are invalidated on rehash.
+    // The interface follows std::unordered_map for the common operations.
+    template<class K, class V, class Hash = std::hash<K>, class KeyEqual = std::equal_to<K>>
+    class TFlatMap
+    {
+    public:
+        typedef K key_type;
+        typedef V mapped_type;
+        typedef std::pair<const K, V> value_type;
+        typedef size_t size_type;
+        typedef Hash hasher;
+        typedef KeyEqual key_equal;
+
+    private:
+        typedef FlatMapInternal::Group Group;
+
+        template<bool IsConst>
+        class TIterator
+        {
+        public:
+            typedef std::forward_iterator_tag iterator_category;
+            typedef typename TFlatMap::value_type value_type;
+            typedef ptrdiff_t difference_type;
+            typedef std::conditional_t<IsConst, const value_type*, value_type*> pointer;
+            typedef std::conditional_t<IsConst, const value_type&, value_type&> reference;
+
+            TIterator() : _control( NULL ), _controlEnd( NULL ), _slot( NULL ) { }
+
+            TIterator( const int8* control, const int8* controlEnd, pointer slot ) : _control( control ), _controlEnd( controlEnd ), _slot( slot ) { SkipEmpty(); }
+
+            template<bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+            TIterator( const TIterator<OtherConst>& other ) : _control( other._control ), _controlEnd( other._controlEnd ), _slot( other._slot ) { }
+
+            reference operator*() const { return *_slot; }
+            pointer operator->() const { return _slot; }
+
+            TIterator& operator++()
+            {
+                ++_control;
+                ++_slot;
+                SkipEmpty();
+                return *this;
+            }
+
+            TIterator operator++( int ) { TIterator temp = *this; ++(*this); return temp; }
+
+            template<bool OtherConst>
+            bool operator==( const TIterator<OtherConst>& other ) const { return _slot == other._slot; }
+
+            template<bool OtherConst>
+            bool operator!=( const TIterator<OtherConst>& other ) const { return _slot != other._slot; }
+
+        private:
+            friend class TFlatMap;
+            template<bool> friend class TIterator;
+
+            FORCEINLINE void SkipEmpty()
+            {
+                while ( _control != _controlEnd && FlatMapInternal::IsFull( *_control ) == false )
+                {
+                    ++_control;
+                    ++_slot;
+                }
+            }
+
+            const int8* _control;
+            const int8* _controlEnd;
+            pointer _slot;
+        };
+
+    public:
+        typedef TIterator<false> iterator;
+        typedef TIterator<true> const_iterator;
+
+        TFlatMap() : _controls( NULL ), _slots( NULL ), _capacity( 0 ), _size( 0 ), _growthLeft( 0 ), _hasher(), _equal() { }
+
+        explicit TFlatMap( size_t count ) : TFlatMap() { reserve( count ); }
+
+        TFlatMap( std::initializer_list<value_type> list ) : TFlatMap()
+        {
+            reserve( list.size() );
+            for ( const value_type& value : list )
+                insert( value );
+        }
+
+        TFlatMap( const TFlatMap& other ) : TFlatMap()
+        {
+            reserve( other._size );
+            for ( const value_type& value : other )
+                try_emplace( value.first, value.second );
+        }
+
+        TFlatMap( TFlatMap&& other ) noexcept : TFlatMap()
+        {
+            swap( other );
+        }
+
+        ~TFlatMap()
+        {
+            DestroySlots();
+            Deallocate();
+        }
+
+        TFlatMap& operator=( const TFlatMap& other )
+        {
+            if ( this != &other )
+            {
+                TFlatMap copy( other );
+                swap( copy );
+            }
+            return *this;
+        }
+
+        TFlatMap& operator=( TFlatMap&& other ) noexcept
+        {
+            if ( this != &other )
+            {
+                clear();
+                swap( other );
+            }
+            return *this;
+        }
+
+        iterator begin() { return _size == 0 ? end() : MakeIterator( 0 ); }
+        iterator end() { return MakeIterator( _capacity ); }
+        const_iterator begin() const { return _size == 0 ? end() : MakeIterator( 0 ); }
+        const_iterator end() const { return MakeIterator( _capacity ); }
+        const_iterator cbegin() const { return begin(); }
+        const_iterator cend() const { return end(); }
+
+        FORCEINLINE size_t size() const { return _size; }
+        FORCEINLINE bool empty() const { return _size == 0; }
+        FORCEINLINE size_t capacity() const { return _capacity; }
+
+        void clear()
+        {
+            DestroySlots();
+            if ( _capacity > 0 )
+            {
+                ResetControls();
+            }
+            _size = 0;
+            _growthLeft = MaxLoad( _capacity );
+        }
+
+        void reserve( size_t count )
+        {
+            size_t capacity = FlatMapInternal::kGroupWidth;
+            while ( MaxLoad( capacity ) < count )
+                capacity *= 2;
+            if ( capacity > _capacity )
+                Rehash( capacity );
+        }
+
+        void swap( TFlatMap& other ) noexcept
+        {
+            std::swap( _controls, other._controls );
+            std::swap( _slots, other._slots );
+            std::swap( _capacity, other._capacity );
+            std::swap( _size, other._size );
+            std::swap( _growthLeft, other._growthLeft );
+            std::swap( _hasher, other._hasher );
+            std::swap( _equal, other._equal );
+        }
+
+        iterator find( const K& key )
+        {
+            const size_t index = FindIndex( key, HashKey( key ) );
+            return index == InvalidIndex ? end() : MakeIterator( index );
+        }
+
+        const_iterator find( const K& key ) const
+        {
+            const size_t index = FindIndex( key, HashKey( key ) );
+            return index == InvalidIndex ? end() : MakeIterator( index );
+        }
+
+        FORCEINLINE bool contains( const K& key ) const { return FindIndex( key, HashKey( key ) ) != InvalidIndex; }
+
+        FORCEINLINE size_t count( const K& key ) const { return contains( key ) ? 1 : 0; }
+
+        V& at( const K& key )
+        {
+            const size_t index = FindIndex( key, HashKey( key ) );
+            EE_ASSERT( index != InvalidIndex, "Key not found in flat map" );
+            return _slots[ index ].second;
+        }
+
+        const V& at( const K& key ) const
+        {
+            const size_t index = FindIndex( key, HashKey( key ) );
+            EE_ASSERT( index != InvalidIndex, "Key not found in flat map" );
+            return _slots[ index ].second;
+        }
+
+        V& operator[]( const K& key )
+        {
+            return try_emplace( key ).first->second;
+        }
+
+        V& operator[]( K&& key )
+        {
+            return try_emplace( std::move( key ) ).first->second;
+        }
+
+        template<class KeyArg, class... Args>
+        std::pair<iterator, bool> try_emplace( KeyArg&& key, Args&&... args )
+        {
+            const uint64 hash = HashKey( key );
+            size_t index = FindIndex( key, hash );
+            if ( index != InvalidIndex )
+                return { MakeIterator( index ), false };
+
+            index = PrepareInsert( hash );
+            ::new (_slots + index) value_type( std::piecewise_construct,
+                std::forward_as_tuple( std::forward<KeyArg>( key ) ),
+                std::forward_as_tuple( std::forward<Args>( args )... ) );
+            return { MakeIterator( index ), true };
+        }
+
+        template<class KeyArg, class... Args>
+        std::pair<iterator, bool> emplace( KeyArg&& key, Args&&... args )
+        {
+            return try_emplace( std::forward<KeyArg>( key ), std::forward<Args>( args )... );
+        }
+
+        std::pair<iterator, bool> insert( const value_type& value )
+        {
+            return try_emplace( value.first, value.second );
+        }
+
+        std::pair<iterator, bool> insert( value_type&& value )
+        {
+            return try_emplace( value.first, std::move( value.second ) );
+        }
+
+        template<class M>
+        std::pair<iterator, bool> insert_or_assign( const K& key, M&& value )
+        {
+            std::pair<iterator, bool> result = try_emplace( key, std::forward<M>( value ) );
+            if ( result.second == false )
+                result.first->second = std::forward<M>( value );
+            return result;
+        }
+
+        size_t erase( const K& key )
+        {
+            const size_t index = FindIndex( key, HashKey( key ) );
+            if ( index == InvalidIndex )
+                return 0;
+            EraseIndex( index );
+            return 1;
+        }
+
+        iterator erase( const_iterator position )
+        {
+            const size_t index = (size_t)(position._slot - _slots);
+            EraseIndex( index );
+            return MakeIterator( index + 1 );
+        }
+
+    private:
+        static constexpr size_t InvalidIndex = ~size_t( 0 );
+
+        FORCEINLINE static size_t MaxLoad( size_t capacity ) { return capacity - capacity / 8; }
+
+        FORCEINLINE static int8 H2( uint64 hash ) { return (int8)(hash & 0x7F); }
+
+        FORCEINLINE static size_t H1( uint64 hash ) { return (size_t)(hash >> 7); }
+
+        FORCEINLINE uint64 HashKey( const K& key ) const { return FlatMapInternal::MixHash( (uint64)_hasher( key ) ); }
+
+        FORCEINLINE iterator MakeIterator( size_t index ) { return iterator( _controls + index, _controls + _capacity, _slots + index ); }
+
+        FORCEINLINE const_iterator MakeIterator( size_t index ) const { return const_iterator( _controls + index, _controls + _capacity, _slots + index ); }
+
+        size_t FindIndex( const K& key, uint64 hash ) const
+        {
+            if ( _capacity == 0 )
+                return InvalidIndex;
+
+            const size_t mask = _capacity - 1;
+            const int8 h2 = H2( hash );
+            size_t position = H1( hash ) & mask;
+            size_t step = 0;
+            while ( true )
+            {
+                Group group( _controls + position );
+                for ( uint32 match = group.Match( h2 ); match != 0; match &= match - 1 )
+                {
+                    const size_t index = (position + FlatMapInternal::CountTrailingZeros( match )) & mask;
+                    if ( _equal( _slots[ index ].first, key ) )
+                        return index;
+                }
+
+                if ( group.MatchEmpty() != 0 )
+                    return InvalidIndex;
+
+                step += FlatMapInternal::kGroupWidth;
+                position = (position + step) & mask;
+            }
+        }
+
+        size_t FindFirstNonFull( uint64 hash ) const
+        {
+            const size_t mask = _capacity - 1;
+            size_t position = H1( hash ) & mask;
+            size_t step = 0;
+            while ( true )
+            {
+                Group group( _controls + position );
+                if ( uint32 match = group.MatchEmptyOrDeleted() )
+                {
+                    return (position + FlatMapInternal::CountTrailingZeros( match )) & mask;
+                }
+
+                step += FlatMapInternal::kGroupWidth;
+                position = (position + step) & mask;
+            }
+        }
+
+        size_t PrepareInsert( uint64 hash )
+        {
+            size_t index = _capacity == 0 ? InvalidIndex : FindFirstNonFull( hash );
+            if ( index == InvalidIndex || (_growthLeft == 0 && _controls[ index ] != FlatMapInternal::kDeleted) )
+            {
+                // Reclaim tombstones when the table is mostly deleted slots, grow otherwise
+                if ( _capacity > 0 && _size * 2 <= MaxLoad( _capacity ) )
+                    Rehash( _capacity );
+                else
+                    Rehash( _capacity == 0 ? FlatMapInternal::kGroupWidth : _capacity * 2 );
+                index = FindFirstNonFull( hash );
+            }
+
+            if ( _controls[ index ] == FlatMapInternal::kEmpty )
+                --_growthLeft;
+            SetControl( index, H2( hash ) );
+            ++_size;
+            return index;
+        }
+
+        void EraseIndex( size_t index )
+        {
+            _slots[ index ].~value_type();
+            SetControl( index, FlatMapInternal::kDeleted );
+            --_size;
+        }
+
+        FORCEINLINE void SetControl( size_t index, int8 control )
+        {
+            _controls[ index ] = control;
+            // Mirror the first group after the end so groups can be loaded without wrapping
+            if ( index < FlatMapInternal::kGroupWidth )
+                _controls[ _capacity + index ] = control;
+        }
+
+        void ResetControls()
+        {
+            memset( _controls, (uint8)FlatMapInternal::kEmpty, _capacity + FlatMapInternal::kGroupWidth );
+        }
+
+        void Rehash( size_t newCapacity )
+        {
+            int8* oldControls = _controls;
+            value_type* oldSlots = _slots;
+            const size_t oldCapacity = _capacity;
+
+            _capacity = newCapacity;
+            _controls = static_cast<int8*>( ::operator new( _capacity + FlatMapInternal::kGroupWidth ) );
+            _slots = static_cast<value_type*>( ::operator new( sizeof( value_type ) * _capacity, std::align_val_t( alignof( value_type ) ) ) );
+            ResetControls();
+            _growthLeft = MaxLoad( _capacity ) - _size;
+
+            for ( size_t i = 0; i < oldCapacity; i++ )
+            {
+                if ( FlatMapInternal::IsFull( oldControls[ i ] ) )
+                {
+                    const uint64 hash = HashKey( oldSlots[ i ].first );
+                    const size_t index = FindFirstNonFull( hash );
+                    SetControl( index, H2( hash ) );
+                    ::new (_slots + index) value_type( std::move( oldSlots[ i ] ) );
+                    oldSlots[ i ].~value_type();
+                }
+            }
+
+            if ( oldControls != NULL )
+            {
+                ::operator delete( oldControls );
+                ::operator delete( oldSlots, std::align_val_t( alignof( value_type ) ) );
+            }
+        }
+
+        void DestroySlots()
+        {
+            if constexpr ( std::is_trivially_destructible_v<value_type> == false )
+            {
+                for ( size_t i = 0; i < _capacity; i++ )
+                {
+                    if ( FlatMapInternal::IsFull( _controls[ i ] ) )
+                        _slots[ i ].~value_type();
+                }
+            }
+        }
+
+        void Deallocate()
+        {
+            if ( _controls != NULL )
+            {
+                ::operator delete( _controls );
+                ::operator delete( _slots, std::align_val_t( alignof( value_type ) ) );
+                _controls = NULL;
+                _slots = NULL;
+            }
+        }
+
+        int8* _controls;
+        value_type* _slots;
+        size_t _capacity;
+        size_t _size;
+        size_t _growthLeft;
+        Hash _hasher;
+        KeyEqual _equal;
+    };
+}
@@ -0,0 +1,247 @@
+#pragma once
+
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace EE
+{
+    // Contiguous array that keeps up to N elements inside the object and only moves to the heap past that.
+    // The interface follows std::vector for the common operations; pointers are invalidated when it spills.
+    template<class T, uint32 N>
+    class TInlineArray
+    {
+        static_assert( N > 0, "Inline capacity must be greater than zero" );
+
+    public:
+        typedef T value_type;
+        typedef size_t size_type;
+        typedef T* iterator;
+        typedef const T* const_iterator;
+        typedef T& reference;
+        typedef const T& const_reference;
+
+        TInlineArray() : _data( InlineData() ), _size( 0 ), _capacity( N ) { }
+
+        explicit TInlineArray( size_t count ) : TInlineArray()
+        {
+            resize( count );
+        }
+
+        TInlineArray( size_t count, const T& value ) : TInlineArray()
+        {
+            resize( count, value );
+        }
+
+        TInlineArray( std::initializer_list<T> list ) : TInlineArray()
+        {
+            reserve( list.size() );
+            for ( const T& value : list )
+                ::new (_data + _size++) T( value );
+        }
+
+        TInlineArray( const TInlineArray& other ) : TInlineArray()
+        {
+            reserve( other._size );
+            for ( uint32 i = 0; i < other._size; i++ )
+                ::new (_data + i) T( other._data[ i ] );
+            _size = other._size;
+        }
+
+        TInlineArray( TInlineArray&& other ) noexcept : TInlineArray()
+        {
+            MoveFrom( std::move( other ) );
+        }
+
+        ~TInlineArray()
+        {
+            clear();
+            FreeHeap();
+        }
+
+        TInlineArray& operator=( const TInlineArray& other )
+        {
+            if ( this != &other )
+            {
+                clear();
+                reserve( other._size );
+                for ( uint32 i = 0; i < other._size; i++ )
+                    ::new (_data + i) T( other._data[ i ] );
+                _size = other._size;
+            }
+            return *this;
+        }
+
+        TInlineArray& operator=( TInlineArray&& other ) noexcept
+        {
+            if ( this != &other )
+            {
+                clear();
+                FreeHeap();
+                MoveFrom( std::move( other ) );
+            }
+            return *this;
+        }
+
+        FORCEINLINE iterator begin() { return _data; }
+        FORCEINLINE iterator end() { return _data + _size; }
+        FORCEINLINE const_iterator begin() const { return _data; }
+        FORCEINLINE const_iterator end() const { return _data + _size; }
+
+        FORCEINLINE T* data() { return _data; }
+        FORCEINLINE const T* data() const { return _data; }
+
+        FORCEINLINE size_t size() const { return _size; }
+        FORCEINLINE size_t capacity() const { return _capacity; }
+        FORCEINLINE bool empty() const { return _size == 0; }
+
+        //* True while the elements live inside the object
+        FORCEINLINE bool IsInline() const { return _data == InlineData(); }
+
+        FORCEINLINE T& operator[]( size_t index ) { return _data[ index ]; }
+        FORCEINLINE const T& operator[]( size_t index ) const { return _data[ index ]; }
+
+        FORCEINLINE T& front() { return _data[ 0 ]; }
+        FORCEINLINE const T& front() const { return _data[ 0 ]; }
+        FORCEINLINE T& back() { return _data[ _size - 1 ]; }
+        FORCEINLINE const T& back() const { return _data[ _size - 1 ]; }
+
+        void reserve( size_t count )
+        {
+            if ( count > _capacity )
+                Grow( count );
+        }
+
+        template<class... Args>
+        T& emplace_back( Args&&... args )
+        {
+            if ( _size == _capacity )
+            {
+                // Built before the old elements move, the arguments may refer to one of them
+                const size_t newCapacity = (size_t)_capacity * 2;
+                T* newData = Allocate( newCapacity );
+                T* element = ::new (newData + _size) T( std::forward<Args>( args )... );
+                Relocate( newData, newCapacity );
+                ++_size;
+                return *element;
+            }
+            T* element = ::new (_data + _size) T( std::forward<Args>( args )... );
+            ++_size;
+            return *element;
+        }
+
+        FORCEINLINE void push_back( const T& value ) { emplace_back( value ); }
+        FORCEINLINE void push_back( T&& value ) { emplace_back( std::move( value ) ); }
+
+        void pop_back()
+        {
+            --_size;
+            _data[ _size ].~T();
+        }
+
+        iterator erase( const_iterator position )
+        {
+            T* element = _data + (position - _data);
+            std::move( element + 1, _data + _size, element );
+            pop_back();
+            return element;
+        }
+
+        void resize( size_t count )
+        {
+            reserve( count );
+            while ( _size > count ) pop_back();
+            while ( _size < count ) ::new (_data + _size++) T();
+        }
+
+        void resize( size_t count, const T& value )
+        {
+            if ( count > _capacity )
+            {
+                // The value may be an element of this array
+                const T copy( value );
+                Grow( count );
+                while ( _size < count ) ::new (_data + _size++) T( copy );
+                return;
+            }
+            while ( _size > count ) pop_back();
+            while ( _size < count ) ::new (_data + _size++) T( value );
+        }
+
+        void clear()
+        {
+            if constexpr ( std::is_trivially_destructible_v<T> == false )
+            {
+                for ( uint32 i = 0; i < _size; i++ )
+                    _data[ i ].~T();
+            }
+            _size = 0;
+        }
+
+    private:
+        FORCEINLINE T* InlineData() { return reinterpret_cast<T*>( _inline ); }
+        FORCEINLINE const T* InlineData() const { return reinterpret_cast<const T*>( _inline ); }
+
+        FORCEINLINE static T* Allocate( size_t count )
+        {
+            return static_cast<T*>( ::operator new( sizeof( T ) * count, std::align_val_t( alignof( T ) ) ) );
+        }
+
+        void Grow( size_t count )
+        {
+            Relocate( Allocate( count ), count );
+        }
+
+        //* Moves the elements to newData and takes it as the storage
+        void Relocate( T* newData, size_t count )
+        {
+            for ( uint32 i = 0; i < _size; i++ )
+            {
+                ::new (newData + i) T( std::move( _data[ i ] ) );
+                _data[ i ].~T();
+            }
+            FreeHeap();
+            _data = newData;
+            _capacity = (uint32)count;
+        }
+
+        void FreeHeap()
+        {
+            if ( IsInline() == false )
+            {
+                ::operator delete( _data, std::align_val_t( alignof( T ) ) );
+                _data = InlineData();
+                _capacity = N;
+            }
+        }
+
+        // Expects this array to be empty and inline
+        void MoveFrom( TInlineArray&& other )
+        {
+            if ( other.IsInline() )
+            {
+                for ( uint32 i = 0; i < other._size; i++ )
+                    ::new (_data + i) T( std::move( other._data[ i ] ) );
+                _size = other._size;
+                other.clear();
+            }
+            else
+            {
+                _data = other._data;
+                _size = other._size;
+                _capacity = other._capacity;
+                other._data = other.InlineData();
+                other._size = 0;
+                other._capacity = N;
+            }
+        }
+
+        T* _data;
+        uint32 _size;
+        uint32 _capacity;
+        alignas(T) unsigned char _inline[ sizeof( T ) * N ];
+    };
+}
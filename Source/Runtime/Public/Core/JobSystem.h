@@ -0,0 +1,89 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+
+#include "Core/Collections.h"
+
+namespace EE
+{
+    struct Job;
+
+    typedef std::function<void()> JobFunction;
+
+    //* Counts the unfinished jobs of a group, jobs can be made to wait for it with JobSystem::Run
+    class JobCounter
+    {
+    private:
+        EE_CLASSNOCOPY( JobCounter )
+
+    public:
+        JobCounter() : _count( 0 ), _lock(), _continuations() {}
+
+        FORCEINLINE bool IsDone() const { return _count.load( std::memory_order_acquire ) == 0; }
+
+    private:
+        friend class JobSystem;
+        friend class JobScheduler;
+
+        std::atomic<uint32> _count;
+        //* Taken when the count drops to zero and when a dependent job is added
+        std::mutex _lock;
+        //* Jobs queued once the count drops to zero
+        TArray<Job*> _continuations;
+    };
+
+    //* Engine wide pool of worker threads. Each worker owns a deque of jobs, it works on the newest
+    //* of its own and steals the oldest of the others when it runs out
+    class JobSystem
+    {
+    public:
+        //* Starts the workers, 0 uses one per core but the calling thread. Reference counted with Exit
+        static bool Initialize( uint32 workerCount = 0 );
+
+        //* Runs the jobs left and joins the workers once every Initialize has been matched
+        static void Exit();
+
+        //* Queues a job, counter is incremented now and decremented when the job finishes.
+        //* Without workers the job runs right away on the calling thread
+        static void Run( JobFunction function, JobCounter* counter = NULL );
+
+        //* Same as Run but the job is queued once dependency reaches zero
+        static void Run( JobFunction function, JobCounter* counter, JobCounter& dependency );
+
+        //* Queues a long job, like a whole asset load, on a queue only idle workers take from.
+        //* Wait never runs it inline, so waiting on short jobs is not held up by it
+        static void RunBackground( JobFunction function, JobCounter* counter = NULL );
+
+        //* Works on queued jobs until the counter reaches zero, the counter can be released after
+        static void Wait( JobCounter& counter );
+
+        static uint32 GetWorkerCount();
+
+        //* Index of the worker running the calling thread, or -1 outside of the job system
+        static int32 GetWorkerIndex();
+
+        //* Calls function( begin, end ) over ranges of at most grainSize covering [0, count) and waits for all
+        //* of them. The calling thread takes the first range, the rest are stolen by idle workers
+        template<typename Function>
+        static void ParallelFor( uint32 count, uint32 grainSize, const Function& function )
+        {
+            grainSize = grainSize == 0 ? 1 : grainSize;
+            if ( count <= grainSize || GetWorkerCount() == 0 )
+            {
+                if ( count > 0 )
+                    function( 0u, count );
+                return;
+            }
+
+            JobCounter counter;
+            for ( uint32 begin = grainSize; begin < count; begin += grainSize )
+            {
+                const uint32 end = count - begin < grainSize ? count : begin + grainSize;
+                Run( [ &function, begin, end ]() { function( begin, end ); }, &counter );
+            }
+            function( 0u, grainSize );
+            Wait( counter );
+        }
+    };
+}
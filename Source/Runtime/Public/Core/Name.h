@@ -1,12 +1,35 @@
 #pragma once
 
+#include <string_view>
+
+#include "Utils/Hasher.h"
+
 namespace EE
 {
+    struct NameEntry;
+
+    //* String literal with its Name ID computed at compile time, create it with the _name suffix
+    struct NameLiteral
+    {
+        const U8Char* text;
+        uint64 length;
+        uint64 id;
+
+        consteval NameLiteral( const U8Char* text, uint64 length ) : text( text ), length( length ), id( HashName( std::string_view( text, length ) ) ) { }
+    };
+
+    consteval NameLiteral operator""_name( const U8Char* text, size_t length )
+    {
+        return NameLiteral( text, length );
+    }
+
+    //* Identifier backed by a global append-only string pool, safe to create from any thread
     class Name
     {
     private:
        uint64 _number;
        uint64 _id;
+       const NameEntry* _entry;
 
     private:
        Name() = delete;
@@ -15,14 +38,20 @@ namespace EE
        Name( const U8String& text );
        
        Name( const U8Char* text );
+
+       //* Skips hashing, the text is only registered the first time the ID is seen
+       Name( const NameLiteral& literal );
        
        Name( uint64 number );
 
        Name( const U8Char* text, uint64 number );
+
+       Name( const NameLiteral& literal, uint64 number );
        
        ~Name();
        
-       const U8String& GetName() const;
+       //* The view stays valid for the lifetime of the program
+       std::string_view GetName() const;
        
        U8String GetInstanceName() const;
        
@@ -32,6 +61,7 @@ namespace EE
        
        const uint64& GetID() const;
        
+       //* Orders by ID then number, stable for a run but not alphabetical. Sort by GetName for display
        bool operator<( const Name& other ) const;
        
        bool operator==( const Name& other ) const;
@@ -33,7 +33,7 @@ namespace EE
 
         virtual void SendHapticImpulse( int index, int channel, float amplitude, int duration );
 
-        virtual TArray<int> GetJoysticksConnected();
+        virtual TInlineArray<int, EE_MAX_GAMEPAD_COUNT> GetJoysticksConnected();
 
         virtual void CheckForConnectedJoysticks();
 
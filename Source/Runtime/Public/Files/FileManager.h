@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Core/Collections.h"
+#include "Files/MappedFileView.h"
 
 namespace EE
 {
@@ -45,6 +46,7 @@ namespace EE
 
         static U8String ReadStream( const File* file );
 
-        static TArray<char> ReadBinaryStream( const File* file );
+        //* Maps the file instead of copying it, the data lives as long as the returned view
+        static MappedFileView ReadBinaryStream( const File* file );
     };
 }
\ No newline at end of file
@@ -4,15 +4,28 @@
 
 namespace EE
 {
+    //* Asynchronous block reader. A FileMap is meant to be driven from a single thread
     class FileMap : public File
     {
     private:
         EE_CLASSNOCOPY( FileMap )
 
     public:
-        FileMap( const File& filePath );
+        //* Maximum number of reads in flight per file
+        static constexpr uint32 MaxRequests = 8;
+
+        //* With directIO the page cache is bypassed, offsets, sizes and buffers must then be 4096 aligned
+        FileMap( const File& filePath, bool directIO = false );
         ~FileMap() noexcept;
 
+        //* Queues a read without waiting for it, outRequest identifies it in PollRead and WaitForRead
+        int SubmitRead( uint64 offset, uint64 size, void* buffer, uint32* outRequest );
+        //* Returns true when the request has finished, never blocks
+        bool PollRead( uint32 request );
+        //* Blocks until the request finishes and releases it
+        int WaitForRead( uint32 request, uint64* bytesRead );
+
+        //* Single request helpers, same as SubmitRead followed by WaitForRead
         int ReadBlock( uint64 offset, uint64 size, void* buffer );
         int WaitForResult( uint64* bytesRead );
 
@@ -21,17 +34,20 @@ namespace EE
         uint64 GetSize() const { return _size; }
         int GetError() const { return _error; }
         uint32 GetRequestsCount() const noexcept { return _requestCount; }
+        uint32 GetPendingCount() const noexcept { return _pendingCount; }
         uint64 GetBytesRead() const noexcept { return _bytesRead; }
         int GetErrorCode() const noexcept { return _errorCode; }
+        bool IsDirectIO() const noexcept { return _directIO; }
 
     protected:
         uint32  _requestCount{};
+        uint32  _pendingCount{};
+        uint32  _lastRequest{};
         uint64  _bytesRead{};
         int     _errorCode{};
         void*   _handle{};
         uint64  _size{};
         int     _error{};
-        uint64  _offset{};
-        void*   _buffer{};
+        bool    _directIO{};
     };
-}
\ No newline at end of file
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <span>
+#include <string_view>
+
+namespace EE
+{
+    class File;
+
+    enum EMappedFileHint
+    {
+        //* Read front to back once, the kernel reads ahead aggressively and drops pages behind
+        MappedFileHint_Sequential,
+        //* Scattered access, disables read ahead
+        MappedFileHint_Random,
+    };
+
+    //* Read only memory mapping of a whole file, data is paged in on demand without copies
+    class MappedFileView
+    {
+    public:
+        MappedFileView();
+        MappedFileView( const File& file, EMappedFileHint hint = MappedFileHint_Sequential );
+        MappedFileView( MappedFileView&& other ) noexcept;
+        ~MappedFileView();
+
+        MappedFileView( const MappedFileView& other ) = delete;
+        MappedFileView& operator=( const MappedFileView& other ) = delete;
+        MappedFileView& operator=( MappedFileView&& other ) noexcept;
+
+        //* Releases the mapping, spans obtained before become invalid
+        void Unmap();
+
+        FORCEINLINE std::span<const uint8> GetData() const { return std::span<const uint8>( _data, (size_t)_size ); }
+        FORCEINLINE std::string_view GetText() const { return std::string_view( reinterpret_cast<const U8Char*>( _data ), (size_t)_size ); }
+        FORCEINLINE uint64 GetSize() const { return _size; }
+        //* Platform error code of the mapping, 0 on success
+        FORCEINLINE int GetError() const { return _error; }
+
+        FORCEINLINE explicit operator bool() const { return _error == 0; }
+
+    private:
+        const uint8* _data;
+        uint64 _size;
+        int _error;
+    };
+}
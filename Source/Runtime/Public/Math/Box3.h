@@ -16,10 +16,11 @@ namespace EE
                 struct { T minX, minY, minZ, maxX, maxY, maxZ; };
             };
 
+            //* Empty box, the first added point becomes both corners
             constexpr TBox3()
             {
-                minX = minY = minZ = MathConstants<T>::MinValue;
-                maxX = maxY = maxZ = MathConstants<T>::MaxValue;
+                minX = minY = minZ = MathConstants<T>::MaxValue;
+                maxX = maxY = maxZ = -MathConstants<T>::MaxValue;
             }
 
             constexpr TBox3( T minX, T minY, T minZ, T maxX, T maxY, T maxZ )
@@ -3,28 +3,28 @@ namespace EE
 {
     class JoltPhysicsEngine;
 
+    //* The Jolt shape lives inside the pooled object and is marked embedded, so the bodies
+    //* referencing it never delete it. Destroy the bodies using a shape before the shape
     class JoltPhysicsShapeSphere : public PhysicsShapeSphere
     {
     public:
-        JPH::Shape* GetJoltShape() { return _shape; };
+        JPH::Shape* GetJoltShape() { return &_shape; };
 
         JoltPhysicsShapeSphere( const PhysicsShapeSphereCreateInfo& createInfo );
-        ~JoltPhysicsShapeSphere( );
 
     private:
-        JPH::Shape* _shape;
+        JPH::SphereShape _shape;
     };
 
     class JoltPhysicsShapeBox : public PhysicsShapeBox
     {
     public:
-        JPH::Shape* GetJoltShape() { return _shape; };
+        JPH::Shape* GetJoltShape() { return &_shape; };
 
         JoltPhysicsShapeBox( const PhysicsShapeBoxCreateInfo& createInfo );
-        ~JoltPhysicsShapeBox();
 
     private:
-        JPH::Shape* _shape;
+        JPH::BoxShape _shape;
     };
 
     class JoltPhysicsBody : public PhysicsBody
@@ -66,6 +66,10 @@ namespace EE
 
         PhysicsBody* CreateBody( const PhysicsBodyCreateInfo& createInfo ) override;
 
+        void DestroyShape( PhysicsShape* shape ) override;
+
+        void DestroyBody( PhysicsBody* body ) override;
+
         FORCEINLINE JPH::PhysicsSystem* GetPhysicsSystem() { return _physicsSystem; }
     
     private:
@@ -75,5 +79,9 @@ namespace EE
         JPH::ObjectLayerPairFilter* _objectVSObjectLayerFilter;
         JPH::BodyActivationListener* _bodyActivationListener;
         JPH::ContactListener* _contactListener;
+
+        Memory::TPool<JoltPhysicsShapeBox> _boxShapePool;
+        Memory::TPool<JoltPhysicsShapeSphere> _sphereShapePool;
+        Memory::TPool<JoltPhysicsBody> _bodyPool;
     };
 }
\ No newline at end of file
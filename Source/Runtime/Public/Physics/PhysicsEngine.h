@@ -115,6 +115,12 @@ namespace EE
         virtual PhysicsShapeSphere* CreateSphereShape( const PhysicsShapeSphereCreateInfo& createInfo ) = 0;
         
         virtual PhysicsBody* CreateBody( const PhysicsBodyCreateInfo& createInfo ) = 0;
+
+        //* Releases a shape created by this engine, its bodies must be destroyed first. Don't delete shapes directly
+        virtual void DestroyShape( PhysicsShape* shape ) = 0;
+
+        //* Releases a body created by this engine, don't delete bodies directly
+        virtual void DestroyBody( PhysicsBody* body ) = 0;
     };
 
     extern PhysicsEngine* GPhysicsEngine;
@@ -3,6 +3,7 @@
 #include "Core/Collections.h"
 #include "Math/CoreMath.h"
 #include "Core/Name.h"
+#include "Utils/Memory.h"
 
 namespace EE
 {
@@ -10,6 +11,7 @@ namespace EE
     {
     public:
         EE_CLASSNOCOPY( RHIObject )
+        EE_MEMORY_TAG_OPERATORS( Memory::MemoryTag_RHI )
 
     protected:
         RHIObject() {};
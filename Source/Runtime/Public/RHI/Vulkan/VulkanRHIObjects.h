@@ -156,7 +156,7 @@ namespace EE
         VkDevice device;
         VmaAllocator allocator;
         // map of command pools by queue family index
-        TMap<uint32, VulkanRHICommandPool*> commandPools;
+        TFlatMap<uint32, VulkanRHICommandPool*> commandPools;
 
         union
         {
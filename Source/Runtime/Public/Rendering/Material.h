@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Core/Collections.h"
+#include "Math/CoreMath.h"
+
+namespace EE
+{
+    //* Surface description as found in the source asset, textures are paths to the image files
+    struct MaterialData
+    {
+        U8String name;
+        Vector3f ambientColor = Vector3f( 0.F );
+        Vector3f diffuseColor = Vector3f( 1.F );
+        Vector3f specularColor = Vector3f( 0.F );
+        Vector3f emissiveColor = Vector3f( 0.F );
+        float specularExponent = 0.F;
+        float opacity = 1.F;
+        float refractionIndex = 1.F;
+        int32 illuminationModel = 2;
+
+        U8String ambientTexture;
+        U8String diffuseTexture;
+        U8String specularTexture;
+        U8String emissiveTexture;
+        U8String alphaTexture;
+        U8String normalTexture;
+    };
+}
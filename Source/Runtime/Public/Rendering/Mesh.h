@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Core/Collections.h"
+#include "Utils/Memory.h"
 #include "Math/CoreMath.h"
 #include "Math/Transform.h"
 
@@ -73,6 +74,40 @@ namespace EE
         }
     };
 
+    //* Simplified level of a mesh drawn with the same vertices, its faces come after the full resolution ones
+    struct MeshLOD
+    {
+        //* Index range of the level in MeshData::faces
+        uint32 baseIndex = 0;
+        uint32 indexCount = 0;
+        //* The level split per material, keyed as the full resolution subdivisions
+        TFlatMap<int32, Subdivision> subdivisionsMap;
+        //* Farthest the simplified surface gets from the full resolution one in mesh units,
+        //* projected to the screen it says from which distance the level can be drawn
+        float error = 0.F;
+    };
+
+    //* Cluster of neighbouring faces of one subdivision, small enough to be culled and drawn as a unit
+    struct Meshlet
+    {
+        //* Range in MeshData::meshletVertices, the mesh vertices the meshlet uses
+        uint32 vertexOffset = 0;
+        uint32 vertexCount = 0;
+        //* Range in MeshData::meshletIndices, three per face indexing the vertices of the meshlet
+        uint32 indexOffset = 0;
+        uint32 triangleCount = 0;
+        //* Subdivision the faces come from, 0 when the mesh has none
+        int32 subdivisionKey = 0;
+
+        Vector3f center;
+        float radius = 0.F;
+        //* Every face points away from a camera at cameraPosition when
+        //* dot( normalize( coneApex - cameraPosition ), coneAxis ) > coneCutoff, a cutoff of 1 never culls
+        Vector3f coneApex;
+        Vector3f coneAxis;
+        float coneCutoff = 1.F;
+    };
+
     struct MeshFace
     {
         union
@@ -82,21 +117,97 @@ namespace EE
         };
     };
 
-    typedef TArray<MeshFace>        MeshFaces;
-    typedef TArray<Vector3f>        MeshVector3D;
-    typedef TArray<Vector2f>        MeshUVs;
-    typedef TArray<Vector4f>        MeshColors;
-    typedef TArray<StaticVertex>    MeshVertices;
-    typedef TMap<int32, U8String>   MeshMaterials;
+    // Mesh arrays are accounted to the mesh memory tag
+    template<class T>
+    using TMeshArray = TArray<T, Memory::TTaggedAllocator<T, Memory::MemoryTag_Mesh>>;
+
+    typedef TMeshArray<MeshFace>        MeshFaces;
+    typedef TMeshArray<Vector3f>        MeshVector3D;
+    typedef TMeshArray<Vector2f>        MeshUVs;
+    typedef TMeshArray<Vector4f>        MeshColors;
+    typedef TMeshArray<StaticVertex>    MeshVertices;
+    typedef TMeshArray<SkinVertex>      MeshSkinVertices;
+    typedef TMap<int32, U8String>       MeshMaterials;
+
+    enum EMeshVertexLayout
+    {
+        //* A StaticVertex or SkinVertex per vertex
+        MeshVertexLayout_Interleaved,
+        //* A contiguous array per attribute in MeshData::vertexStreams
+        MeshVertexLayout_Streams,
+    };
+
+    //* One attribute of every vertex, strided over interleaved vertices or contiguous over a stream
+    template<typename T>
+    class TVertexAttributeView
+    {
+    private:
+        typedef std::conditional_t<std::is_const_v<T>, const uint8, uint8> Byte;
+
+    public:
+        TVertexAttributeView() : _data( NULL ), _count( 0 ), _stride( sizeof( T ) ) {}
+        TVertexAttributeView( T* data, size_t count, size_t stride = sizeof( T ) ) : _data( reinterpret_cast<Byte*>( data ) ), _count( count ), _stride( stride ) {}
+
+        FORCEINLINE T& operator[]( size_t index ) const { return *reinterpret_cast<T*>( _data + index * _stride ); }
+        FORCEINLINE size_t size() const { return _count; }
+        FORCEINLINE bool IsContiguous() const { return _stride == sizeof( T ); }
+
+    private:
+        Byte* _data;
+        size_t _count;
+        size_t _stride;
+    };
+
+    //* Vertices as a structure of arrays, passes over one attribute only load that attribute
+    struct MeshVertexStreams
+    {
+        MeshVector3D positions;
+        MeshVector3D normals;
+        MeshVector3D tangents;
+        MeshUVs uv0;
+        MeshUVs uv1;
+        MeshColors colors;
+        //* Four per vertex, only filled from skin vertices
+        TMeshArray<uint32> boneIndices;
+        TMeshArray<float> boneWeights;
+
+        FORCEINLINE size_t size() const { return positions.size(); }
+        FORCEINLINE bool HasBones() const { return boneIndices.empty() == false; }
+
+        void Resize( size_t count, bool withBones );
+        void Clear();
+
+        StaticVertex GetVertex( size_t index ) const;
+        void SetVertex( size_t index, const StaticVertex& vertex );
+        SkinVertex GetSkinVertex( size_t index ) const;
+        void SetSkinVertex( size_t index, const SkinVertex& vertex );
+
+        //* Replaces the streams with a copy of the vertices
+        void Assign( const MeshVertices& vertices );
+        void Assign( const MeshSkinVertices& vertices );
+        //* Replaces the vertices with a copy of the streams, bones are dropped for static vertices
+        void CopyTo( MeshVertices& outVertices ) const;
+        void CopyTo( MeshSkinVertices& outVertices ) const;
+    };
 
     struct MeshData
     {
         U8String name;
-        TArray<MeshFace> faces;
-        TMap<int32, Subdivision> subdivisionsMap;
+        MeshFaces faces;
+        TFlatMap<int32, Subdivision> subdivisionsMap;
+        //* Levels of detail from the most to the least detailed, the full resolution level isn't in here
+        TArray<MeshLOD> lods;
         TMap<int32, U8String> materialsMap;
-        TArray<StaticVertex> staticVertices;
-        TArray<SkinVertex> skinVertices;
+        //* Optional clusters of the full resolution faces, the faces array still holds all of them
+        TMeshArray<Meshlet> meshlets;
+        TMeshArray<uint32> meshletVertices;
+        TMeshArray<uint8> meshletIndices;
+        //* Vertices of the interleaved layout, skin vertices are used when there are no static ones
+        MeshVertices staticVertices;
+        MeshSkinVertices skinVertices;
+        //* Vertices of the streams layout
+        MeshVertexStreams vertexStreams;
+        EMeshVertexLayout vertexLayout = MeshVertexLayout_Interleaved;
         Box3f bounding;
 
         bool hasNormals = false;
@@ -111,6 +222,40 @@ namespace EE
         void ComputeTangents();
         void ComputeNormals();
         void Clear();
+
+        //* Moves the vertices to the layout, skin vertices keep their bones
+        void SetVertexLayout( EMeshVertexLayout layout );
+
+        FORCEINLINE bool UsesSkinVertices() const { return vertexLayout == MeshVertexLayout_Streams ? vertexStreams.HasBones() : staticVertices.empty() && skinVertices.empty() == false; }
+        size_t GetVertexCount() const;
+        //* Faces of the full resolution level, the ones after them belong to the LODs
+        FORCEINLINE size_t GetBaseFaceCount() const { return lods.empty() ? faces.size() : lods.front().baseIndex / 3; }
+
+        FORCEINLINE TVertexAttributeView<Vector3f> GetPositions() { return GetAttribute( *this, &StaticVertex::position, &SkinVertex::position, &MeshVertexStreams::positions ); }
+        FORCEINLINE TVertexAttributeView<Vector3f> GetNormals() { return GetAttribute( *this, &StaticVertex::normal, &SkinVertex::normal, &MeshVertexStreams::normals ); }
+        FORCEINLINE TVertexAttributeView<Vector3f> GetTangents() { return GetAttribute( *this, &StaticVertex::tangent, &SkinVertex::tangent, &MeshVertexStreams::tangents ); }
+        FORCEINLINE TVertexAttributeView<Vector2f> GetUV0() { return GetAttribute( *this, &StaticVertex::uv0, &SkinVertex::uv0, &MeshVertexStreams::uv0 ); }
+        FORCEINLINE TVertexAttributeView<Vector2f> GetUV1() { return GetAttribute( *this, &StaticVertex::uv1, &SkinVertex::uv1, &MeshVertexStreams::uv1 ); }
+        FORCEINLINE TVertexAttributeView<Vector4f> GetColors() { return GetAttribute( *this, &StaticVertex::color, &SkinVertex::color, &MeshVertexStreams::colors ); }
+        FORCEINLINE TVertexAttributeView<const Vector3f> GetPositions() const { return GetAttribute( *this, &StaticVertex::position, &SkinVertex::position, &MeshVertexStreams::positions ); }
+        FORCEINLINE TVertexAttributeView<const Vector3f> GetNormals() const { return GetAttribute( *this, &StaticVertex::normal, &SkinVertex::normal, &MeshVertexStreams::normals ); }
+        FORCEINLINE TVertexAttributeView<const Vector3f> GetTangents() const { return GetAttribute( *this, &StaticVertex::tangent, &SkinVertex::tangent, &MeshVertexStreams::tangents ); }
+        FORCEINLINE TVertexAttributeView<const Vector2f> GetUV0() const { return GetAttribute( *this, &StaticVertex::uv0, &SkinVertex::uv0, &MeshVertexStreams::uv0 ); }
+        FORCEINLINE TVertexAttributeView<const Vector2f> GetUV1() const { return GetAttribute( *this, &StaticVertex::uv1, &SkinVertex::uv1, &MeshVertexStreams::uv1 ); }
+        FORCEINLINE TVertexAttributeView<const Vector4f> GetColors() const { return GetAttribute( *this, &StaticVertex::color, &SkinVertex::color, &MeshVertexStreams::colors ); }
+
+    private:
+        template<typename TMesh, typename T, typename TView = std::conditional_t<std::is_const_v<TMesh>, const T, T>>
+        static TVertexAttributeView<TView> GetAttribute( TMesh& mesh, T StaticVertex::* staticMember, T SkinVertex::* skinMember, TMeshArray<T> MeshVertexStreams::* stream )
+        {
+            if ( mesh.vertexLayout == MeshVertexLayout_Streams )
+                return TVertexAttributeView<TView>( (mesh.vertexStreams.*stream).data(), (mesh.vertexStreams.*stream).size() );
+            if ( mesh.UsesSkinVertices() )
+                return TVertexAttributeView<TView>( &(mesh.skinVertices.data()->*skinMember), mesh.skinVertices.size(), sizeof( SkinVertex ) );
+            if ( mesh.staticVertices.empty() )
+                return TVertexAttributeView<TView>();
+            return TVertexAttributeView<TView>( &(mesh.staticVertices.data()->*staticMember), mesh.staticVertices.size(), sizeof( StaticVertex ) );
+        }
     };
 
     class Mesh
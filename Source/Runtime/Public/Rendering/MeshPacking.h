@@ -0,0 +1,85 @@
+#pragma once
+
+#include "Rendering/Mesh.h"
+#include "RHI/RHI.h"
+
+namespace EE
+{
+    enum EMeshUVFormat
+    {
+        //* Any range with precision dropping away from zero, fits tiled UVs
+        MeshUVFormat_Half,
+        //* Evenly spaced over the UV range of the mesh, decoded with the offset and scale of the channel
+        MeshUVFormat_UNorm16,
+    };
+
+    //* Shader input location of each packed attribute
+    enum EMeshVertexAttribute
+    {
+        MeshVertexAttribute_Position,
+        MeshVertexAttribute_Normal,
+        MeshVertexAttribute_Tangent,
+        MeshVertexAttribute_UV0,
+        MeshVertexAttribute_UV1,
+        MeshVertexAttribute_Color,
+        MeshVertexAttribute_BoneIndices,
+        MeshVertexAttribute_BoneWeights,
+    };
+
+    struct MeshPackingOptions
+    {
+        //* Positions as unorm16 inside the bounding box, full floats otherwise
+        bool quantizePositions = true;
+        EMeshUVFormat uvFormat = MeshUVFormat_Half;
+    };
+
+    //* Largest difference between the source attributes and the decoded packed ones
+    struct MeshPackingError
+    {
+        //* Distance in mesh units
+        float position = 0.F;
+        //* Angles in radians
+        float normal = 0.F;
+        float tangent = 0.F;
+        float uv = 0.F;
+        float color = 0.F;
+        float boneWeight = 0.F;
+    };
+
+    //* Vertices of a mesh interleaved in a compact buffer ready to upload, only the attributes the mesh has are kept
+    struct PackedMeshData
+    {
+        TMeshArray<uint8> vertices;
+        uint32 vertexCount = 0;
+        //* Attribute locations are EMeshVertexAttribute values
+        RHIVertexBufferLayout layout;
+
+        //* Mesh position is positionOffset + positionScale * normalized packed position
+        Vector3f positionOffset = Vector3f( 0.F );
+        Vector3f positionScale = Vector3f( 1.F );
+        //* Same for each UV channel, only used by MeshUVFormat_UNorm16
+        Vector2f uvOffsets[ 2 ] = { Vector2f( 0.F ), Vector2f( 0.F ) };
+        Vector2f uvScales[ 2 ] = { Vector2f( 1.F ), Vector2f( 1.F ) };
+
+        MeshPackingError error;
+
+        //* Bytes the mesh used before packing
+        size_t sourceSize = 0;
+
+        FORCEINLINE bool HasAttribute( EMeshVertexAttribute attribute ) const
+        {
+            for ( const RHIVertexAttribute& packedAttribute : layout.attributes )
+                if ( packedAttribute.semanticIndex == attribute )
+                    return true;
+            return false;
+        }
+    };
+
+    class MeshPacker
+    {
+    public:
+        //* Packs normals and tangents octahedral encoded, UVs, unorm8 colors and bone data as the mesh flags say.
+        //* Bone indices past 65535 are clamped with a warning. Returns false when the mesh has no vertices
+        static bool Pack( const MeshData& mesh, const MeshPackingOptions& options, PackedMeshData& outPacked );
+    };
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "Rendering/Mesh.h"
+
+namespace EE
+{
+    //* Levels of detail made by collapsing the edges that least change the surface, measured with quadric error metrics
+    class MeshSimplifier
+    {
+    public:
+        //* Replaces the LODs of the mesh with up to levelCount simplified levels, each one with about reduction times
+        //* the faces of the level before. Vertices split by a UV or normal seam only slide along the seam, the ones on
+        //* open borders along the border, and the ones shared by subdivisions stay. Stops early when a level can't
+        //* get much smaller, returns the number of levels made
+        static uint32 GenerateLODs( MeshData& mesh, uint32 levelCount, float reduction = 0.5F );
+    };
+}
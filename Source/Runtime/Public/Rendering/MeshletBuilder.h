@@ -0,0 +1,20 @@
+#pragma once
+
+#include "Rendering/Mesh.h"
+
+namespace EE
+{
+    //* Splits meshes in meshlets with the bounds needed to cull them
+    class MeshletBuilder
+    {
+    public:
+        //* Fit mesh shader workgroups, 124 triangles keep the local indices of a meshlet a multiple of four bytes
+        static constexpr uint32 MaxVertices = 64;
+        static constexpr uint32 MaxTriangles = 124;
+
+        //* Replaces the meshlets of the mesh with clusters of its full resolution faces. Each one grows over the
+        //* neighbouring faces that add the fewest vertices and stay closest to its center, inside a single
+        //* subdivision. Returns the number of meshlets built
+        static uint32 Build( MeshData& mesh );
+    };
+}
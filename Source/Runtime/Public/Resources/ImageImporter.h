@@ -1,9 +1,8 @@
 #pragma once
 
-#include <future>
-
 #include "Rendering/PixelMap.h"
 #include "Files/FileManager.h"
+#include "Resources/ResourceLoader.h"
 
 namespace EE
 {
@@ -43,49 +42,48 @@ namespace EE
 
     private:
         typedef std::function<void( ImageResult& )> FinishTaskFunction;
-        typedef std::function<void( ImageResult&, const Options&, std::future<bool>& )> FutureTask;
-
-        static bool sTaskRunning;
 
         class Task
         {
         public:
             Task( const Task& other ) = delete;
-            Task( const Options& options, FinishTaskFunction finishTaskFunction, FutureTask futureTask );
+            Task( const Options& options, FinishTaskFunction finishTaskFunction );
 
         public:
-            void Start( std::future<bool>& task );
-            void Finish();
+            bool Run();
+            void Finish( ELoadState state );
 
         private:
+            //* Options only reference the file, the task keeps its own copy alive
+            File _file;
             Options _options;
             ImageResult _result;
             FinishTaskFunction _finishTaskFunction;
-            FutureTask _futureTask;
         };
 
         static bool RecognizeFileExtensionAndLoad( ImageResult& result, const Options& options );
 
-        static void FinishCurrentAsyncTask();
-
-        //* Mesh Loading Threads
-        static std::queue<Task*> sPendingTasks;
-        static std::future<bool> sCurrentFutureTask;
+        //* Loads started from LoadAsync whose callback has not run yet, only touched from the main thread
+        static TArray<LoadHandle> sAsyncTasks;
 
     public:
         static bool Initialize();
 
+        //* Delivers the finished loads to their callbacks, call it from the main thread
         static void UpdateStatus();
 
         static void FinishAsyncTasks();
 
         static size_t GetAsyncTaskCount();
 
+        //* Cancels the loads still in flight, their callbacks are not called
         static void Exit();
 
+        //* Loads on the calling thread, it's safe to call from several threads at once
         static bool Load( ImageResult& result, const Options& options );
 
-        static void LoadAsync( const Options& options, FinishTaskFunction onComplete );
+        //* Loads on the resource loader threads, onComplete runs on the main thread unless the load is canceled
+        static LoadHandle LoadAsync( const Options& options, FinishTaskFunction onComplete, ELoadPriority priority = LoadPriority_Normal );
 
     };
 }
\ No newline at end of file
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Resources/ModelImporter.h"
+
+namespace EE
+{
+    //* Binary copy of an imported model written next to its source. Every array is stored aligned in place so
+    //* loading maps the file and bulk copies each section into the model arrays, nothing is parsed or welded again
+    class MeshCache
+    {
+    public:
+        //* Increase when the layout or the importers output changes, older caches are then ignored
+        static constexpr uint32 Version = 7;
+
+        //* Identifies the source a cache was made from
+        struct SourceKey
+        {
+            uint64 size;
+            int64 writeTime;
+            uint64 hash;
+            uint32 options;
+        };
+
+        //* Path of the cache that belongs to the source file
+        static U8String GetCachePath( const File& source );
+
+        //* Reads the source size, write time and content hash, false if the source can't be read
+        static bool ComputeSourceKey( const ModelImporter::Options& options, SourceKey& outKey );
+
+        //* Loads the model if the cache was made from the same source and options, and its dependencies didn't change
+        static bool Load( ModelImporter::ModelResult& result, const File& source, const SourceKey& key );
+
+        //* Writes the imported model to the cache path, the previous cache is replaced atomically
+        static bool Save( const ModelImporter::ModelResult& result, const File& source, const SourceKey& key );
+    };
+}
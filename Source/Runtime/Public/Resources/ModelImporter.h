@@ -1,9 +1,10 @@
 #pragma once
 
-#include <future>
-
 #include "Rendering/Mesh.h"
+#include "Rendering/Material.h"
+#include "Rendering/MeshPacking.h"
 #include "Files/FileManager.h"
+#include "Resources/ResourceLoader.h"
 
 namespace EE
 {
@@ -14,7 +15,7 @@ namespace EE
         bool hasMesh;
         size_t meshKey;
         ModelNode* parent;
-        TArray<ModelNode*> children;
+        TInlineArray<ModelNode*, 4> children;
 
         ModelNode( const U8String& name ) : name( name ), transform(), hasMesh( false ), meshKey( 0 ), parent( NULL ), children() {};
 
@@ -24,13 +25,19 @@ namespace EE
         {
             for ( auto& child : children )
             {
-                delete child;
+                Destroy( child );
             }
         }
 
+        //* Allocates a node from the model node pool, release it with Destroy
+        static ModelNode* Create( const U8String& name );
+
+        //* Releases a node created with Create and all its children
+        static void Destroy( ModelNode* node );
+
         inline ModelNode* AddChild( const U8String& name )
         {
-            ModelNode* child = new ModelNode( name );
+            ModelNode* child = Create( name );
             child->parent = this;
             children.push_back( child );
             return child;
@@ -40,15 +47,42 @@ namespace EE
     class ModelImporter
     {
     public:
+        //* Receives each mesh of a streamed import, it runs on the loading thread and may take the data
+        typedef std::function<void( MeshData& )> MeshStreamFunction;
+
         struct Options
         {
             const File& file;
             bool optimize;
+            //* Threads used to parse the file, 0 uses every core and 1 parses serially
+            uint32 parseThreadCount = 0;
+            //* Load from the binary mesh cache when the source didn't change, and write it after importing
+            bool useCache = true;
+            //* Streams the import, each mesh is handed here as soon as it's built instead of kept in the result
+            //* so only one mesh and the data shared by all are in memory at once. The result still gets the nodes,
+            //* with meshKey counting the streamed meshes, and the materials. Streamed imports don't use the cache
+            MeshStreamFunction onMeshLoaded;
+            //* Layout of the vertices of the meshes, the normals and tangents are computed in it
+            EMeshVertexLayout vertexLayout = MeshVertexLayout_Interleaved;
+            //* Simplified levels generated for each mesh, each one with about half the faces of the one before
+            uint32 lodCount = 0;
+            //* Splits the full resolution faces of each mesh in meshlets for cluster culling
+            bool buildMeshlets = false;
+            //* Fills packedMeshes of the result with the vertices of each mesh in compact formats ready to upload.
+            //* Streamed meshes are not packed
+            bool packVertices = false;
+            MeshPackingOptions packing;
         };
 
         struct ModelResult
         {
             TArray<MeshData> meshes;
+            //* Same order as meshes, only filled when Options::packVertices is set
+            TArray<PackedMeshData> packedMeshes;
+            //* Materials named by the materialsMap of the meshes
+            TArray<MaterialData> materials;
+            //* Other files read to import the model, like material libraries
+            TArray<U8String> dependencies;
             ModelNode parentNode;
 
             //* The model data has been succesfully loaded
@@ -64,49 +98,48 @@ namespace EE
 
     private:
         typedef std::function<void( ModelResult& )> FinishTaskFunction;
-        typedef std::function<void( ModelResult&, const Options&, std::future<bool>& )> FutureTask;
-
-        static bool sTaskRunning;
 
         class Task
         {
         public:
             Task( const Task& other ) = delete;
-            Task( const Options& options, FinishTaskFunction finishTaskFunction, FutureTask futureTask );
+            Task( const Options& options, FinishTaskFunction finishTaskFunction );
 
         public:
-            void Start( std::future<bool>& task );
-            void Finish();
+            bool Run();
+            void Finish( ELoadState state );
 
         private:
+            //* Options only reference the file, the task keeps its own copy alive
+            File _file;
             Options _options;
             ModelResult _result;
             FinishTaskFunction _finishTaskFunction;
-            FutureTask _futureTask;
         };
 
         static bool RecognizeFileExtensionAndLoad( ModelResult& data, const Options& options );
 
-        static void FinishCurrentAsyncTask();
-
-        //* Mesh Loading Threads
-        static std::queue<Task*> sPendingTasks;
-        static std::future<bool> sCurrentFutureTask;
+        //* Loads started from LoadAsync whose callback has not run yet, only touched from the main thread
+        static TArray<LoadHandle> sAsyncTasks;
 
     public:
         static bool Initialize();
 
+        //* Delivers the finished loads to their callbacks, call it from the main thread
         static void UpdateStatus();
 
         static void FinishAsyncTasks();
 
         static size_t GetAsyncTaskCount();
 
+        //* Cancels the loads still in flight, their callbacks are not called
         static void Exit();
 
+        //* Loads on the calling thread, it's safe to call from several threads at once
         static bool Load( ModelResult& info, const Options& options );
 
-        static void LoadAsync( const Options& options, FinishTaskFunction onComplete );
+        //* Loads on the resource loader threads, onComplete runs on the main thread unless the load is canceled
+        static LoadHandle LoadAsync( const Options& options, FinishTaskFunction onComplete, ELoadPriority priority = LoadPriority_Normal );
 
     };
 }
\ No newline at end of file
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+
+namespace EE
+{
+    enum ELoadPriority
+    {
+        LoadPriority_Low,
+        LoadPriority_Normal,
+        LoadPriority_High,
+        //* Goes ahead of everything already queued, for assets needed this frame
+        LoadPriority_Critical,
+    };
+
+    enum ELoadState
+    {
+        LoadState_Queued,
+        LoadState_Loading,
+        LoadState_Finished,
+        LoadState_Failed,
+        LoadState_Canceled,
+    };
+
+    //* Shared state of a single asynchronous load, kept alive by the loader and every LoadHandle
+    class LoadRequest : public std::enable_shared_from_this<LoadRequest>
+    {
+    private:
+        EE_CLASSNOCOPY( LoadRequest )
+
+    public:
+        //* Runs on a worker thread, returns false when the load failed
+        typedef std::function<bool()> LoadFunction;
+        //* Runs on the main thread from ResourceLoader::UpdateStatus
+        typedef std::function<void( ELoadState )> CompleteFunction;
+
+        LoadRequest( ELoadPriority priority, LoadFunction loadFunction, CompleteFunction completeFunction );
+
+        //* Queued loads are dropped right away, running loads stop at the next point the importer checks
+        void Cancel();
+
+        FORCEINLINE ELoadState GetState() const { return _state.load( std::memory_order_acquire ); }
+        FORCEINLINE ELoadPriority GetPriority() const { return _priority; }
+        //* Between 0 and 1, as reported by the importer
+        FORCEINLINE float GetProgress() const { return _progress.load( std::memory_order_relaxed ); }
+        FORCEINLINE bool IsCancelRequested() const { return _cancelRequested.load( std::memory_order_relaxed ); }
+        //* The load has stopped, the completion callback may still be waiting for UpdateStatus
+        FORCEINLINE bool IsDone() const { return GetState() >= LoadState_Finished; }
+        //* The completion callback has run, only meaningful on the main thread
+        FORCEINLINE bool HasCompleted() const { return _hasCompleted; }
+
+    private:
+        friend class ResourceLoader;
+        friend class ResourceLoaderPool;
+
+        std::atomic<ELoadState> _state;
+        std::atomic<float> _progress;
+        std::atomic<bool> _cancelRequested;
+        ELoadPriority _priority;
+        //* Submission order, keeps loads of the same priority first in first out
+        uint64 _sequence;
+        bool _hasCompleted;
+        LoadFunction _loadFunction;
+        CompleteFunction _completeFunction;
+    };
+
+    typedef std::shared_ptr<LoadRequest> LoadHandle;
+
+    //* Load queue shared by the importers, runs several loads at once on the job system ordered by priority
+    class ResourceLoader
+    {
+    public:
+        //* Starts the job system if needed, 0 lets half of its workers load at once. Reference counted with Exit
+        static bool Initialize( uint32 maxConcurrentLoads = 0 );
+
+        //* Cancels queued loads and waits for the running ones once every Initialize has been matched
+        static void Exit();
+
+        //* Queues a load, the loader is started with the default settings if it's not running and then needs an Exit
+        static LoadHandle Submit( ELoadPriority priority, LoadRequest::LoadFunction loadFunction, LoadRequest::CompleteFunction completeFunction );
+
+        //* Runs the completion callbacks of the finished loads, call it from the main thread
+        static void UpdateStatus();
+
+        //* Blocks until the load has stopped and runs the pending completion callbacks, call it from the main thread
+        static void Wait( const LoadHandle& handle );
+
+        //* Loads submitted whose completion callback has not run yet
+        static size_t GetPendingCount();
+
+        //* Maximum number of loads running at the same time
+        static uint32 GetMaxConcurrentLoads();
+
+        //* Reports the progress of the load running on this thread, ignored outside of a load
+        static void SetProgress( float progress );
+
+        //* True when the load running on this thread was canceled, importers check it between stages
+        static bool IsCancelRequested();
+    };
+}
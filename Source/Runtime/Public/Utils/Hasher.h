@@ -1,21 +1,140 @@
 #pragma once
 
+#include <string_view>
+#include <type_traits>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
 namespace EE
 {
+    // wyhash by Wang Yi, released into the public domain (https://github.com/wangyi-fudan/wyhash)
+    namespace WyHash
+    {
+        constexpr uint64 kSecret0 = 0xa0761d6478bd642full;
+        constexpr uint64 kSecret1 = 0xe7037ed1a0b428dbull;
+        constexpr uint64 kSecret2 = 0x8ebc6af09c88c6e3ull;
+        constexpr uint64 kSecret3 = 0x589965cc75374cc3ull;
+
+        FORCEINLINE void Multiply( uint64* a, uint64* b )
+        {
+#if defined(__SIZEOF_INT128__)
+            __uint128_t result = *a;
+            result *= *b;
+            *a = (uint64)result;
+            *b = (uint64)(result >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+            *a = _umul128( *a, *b, b );
+#else
+            const uint64 ha = *a >> 32, hb = *b >> 32, la = (uint32)*a, lb = (uint32)*b;
+            const uint64 rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb, t = rl + (rm0 << 32);
+            uint64 carry = t < rl;
+            const uint64 lo = t + (rm1 << 32);
+            carry += lo < t;
+            *a = lo;
+            *b = rh + (rm0 >> 32) + (rm1 >> 32) + carry;
+#endif
+        }
+
+        FORCEINLINE uint64 Mix( uint64 a, uint64 b ) { Multiply( &a, &b ); return a ^ b; }
+
+        FORCEINLINE uint64 Read8( const uint8* p ) { uint64 v; memcpy( &v, p, 8 ); return v; }
+
+        FORCEINLINE uint64 Read4( const uint8* p ) { uint32 v; memcpy( &v, p, 4 ); return v; }
+
+        FORCEINLINE uint64 Read3( const uint8* p, size_t k ) { return (((uint64)p[ 0 ]) << 16) | (((uint64)p[ k >> 1 ]) << 8) | p[ k - 1 ]; }
+    }
+
+    //* Hashes a range of bytes, not stable across versions so never store the result
+    inline uint64 HashBytes( const void* data, size_t length, uint64 seed = 0 )
+    {
+        using namespace WyHash;
+        const uint8* p = (const uint8*)data;
+        seed ^= Mix( seed ^ kSecret0, kSecret1 );
+        uint64 a, b;
+        if ( length <= 16 )
+        {
+            if ( length >= 4 )
+            {
+                a = (Read4( p ) << 32) | Read4( p + ((length >> 3) << 2) );
+                b = (Read4( p + length - 4 ) << 32) | Read4( p + length - 4 - ((length >> 3) << 2) );
+            }
+            else if ( length > 0 )
+            {
+                a = Read3( p, length );
+                b = 0;
+            }
+            else
+            {
+                a = b = 0;
+            }
+        }
+        else
+        {
+            size_t i = length;
+            if ( i > 48 )
+            {
+                uint64 see1 = seed, see2 = seed;
+                do
+                {
+                    seed = Mix( Read8( p ) ^ kSecret1, Read8( p + 8 ) ^ seed );
+                    see1 = Mix( Read8( p + 16 ) ^ kSecret2, Read8( p + 24 ) ^ see1 );
+                    see2 = Mix( Read8( p + 32 ) ^ kSecret3, Read8( p + 40 ) ^ see2 );
+                    p += 48;
+                    i -= 48;
+                }
+                while ( i > 48 );
+                seed ^= see1 ^ see2;
+            }
+            while ( i > 16 )
+            {
+                seed = Mix( Read8( p ) ^ kSecret1, Read8( p + 8 ) ^ seed );
+                i -= 16;
+                p += 16;
+            }
+            a = Read8( p + i - 16 );
+            b = Read8( p + i - 8 );
+        }
+        a ^= kSecret1;
+        b ^= seed;
+        Multiply( &a, &b );
+        return Mix( a ^ kSecret0 ^ length, b ^ kSecret1 );
+    }
+
+    //* Hashes the object representation, equal values must have equal bytes so padding and floats are rejected
+    template <typename T>
+    FORCEINLINE uint64 HashValueBytes( const T& value )
+    {
+        static_assert( std::has_unique_object_representations_v<T>, "Only types without padding or floating point members can be hashed as bytes" );
+        return HashBytes( &value, sizeof( T ) );
+    }
+
     inline void HashCombine( uint64* seed ) {}
 
     template <typename T, typename... Rest>
     inline void HashCombine( uint64* seed, const T& v, Rest... rest )
     {
         std::hash<T> hasher;
-        *seed ^= hasher( v ) + 0x9e3779b9 + (*seed << 6) + (*seed >> 2);
+        *seed = WyHash::Mix( *seed ^ WyHash::kSecret0, (uint64)hasher( v ) ^ WyHash::kSecret1 );
         HashCombine( seed, rest... );
     }
 
-    inline uint64 ConstU8StringToHash( const U8Char*& name )
+    //* 64 bit FNV-1a, gives the same value at compile time and at runtime
+    constexpr uint64 HashName( std::string_view text )
+    {
+        uint64 hash = 0xcbf29ce484222325ull;
+        for ( const U8Char character : text )
+        {
+            hash ^= (uint8)character;
+            hash *= 0x100000001b3ull;
+        }
+        return hash;
+    }
+
+    inline uint64 ConstU8StringToHash( const U8Char* name )
     {
-        static const std::hash<std::string_view> hasher;
-        return hasher( std::string_view( name, std::strlen( name ) ) );
+        return HashName( std::string_view( name ) );
     }
 
     // Code taken from https://stackoverflow.com/a/28801005 by tux3
@@ -36,27 +155,81 @@ namespace EE
 
     constexpr unsigned CRCTable[] = { HASH_A( 0 ) };
 
+    // Tables for slicing-by-8, each one advances the CRC of the previous by a zero byte
+    struct CRC32SliceTables
+    {
+        uint32 table[ 8 ][ 256 ];
+    };
+
+    constexpr CRC32SliceTables MakeCRC32SliceTables()
+    {
+        CRC32SliceTables tables = {};
+        for ( uint32 i = 0; i < 256; i++ )
+            tables.table[ 0 ][ i ] = CRCTable[ i ];
+        for ( uint32 slice = 1; slice < 8; slice++ )
+        {
+            for ( uint32 i = 0; i < 256; i++ )
+            {
+                const uint32 previous = tables.table[ slice - 1 ][ i ];
+                tables.table[ slice ][ i ] = (previous >> 8) ^ CRCTable[ previous & 0xFF ];
+            }
+        }
+        return tables;
+    }
+
+    inline constexpr CRC32SliceTables CRCSliceTables = MakeCRC32SliceTables();
+
+    // Runtime path, eight bytes per step. Assumes a little endian host
+    inline uint32 CRC32SliceBy8( const uint8* p, uint64 len, uint32 crc )
+    {
+        const auto& t = CRCSliceTables.table;
+        for ( ; len >= 8; len -= 8, p += 8 )
+        {
+            uint32 one, two;
+            memcpy( &one, p, 4 );
+            memcpy( &two, p + 4, 4 );
+            one ^= crc;
+            crc = t[ 7 ][ one & 0xFF ] ^ t[ 6 ][ (one >> 8) & 0xFF ] ^ t[ 5 ][ (one >> 16) & 0xFF ] ^ t[ 4 ][ one >> 24 ]
+                ^ t[ 3 ][ two & 0xFF ] ^ t[ 2 ][ (two >> 8) & 0xFF ] ^ t[ 1 ][ (two >> 16) & 0xFF ] ^ t[ 0 ][ two >> 24 ];
+        }
+        for ( ; len > 0; --len, ++p )
+            crc = (crc >> 8) ^ CRCTable[ (crc & 0xFF) ^ *p ];
+        return crc;
+    }
+
     // Constexpr implementation and helpers
-    constexpr uint32 CRC32Implementation( const uint8* p, uint64 len, uint32 crc )
+    template <typename TChar>
+    constexpr uint32 CRC32Implementation( const TChar* p, uint64 len, uint32 crc )
     {
-        return len ?
-            CRC32Implementation( p + 1, len - 1, (crc >> 8) ^ CRCTable[ (crc & 0xFF) ^ *p ] )
-            : crc;
+        for ( ; len > 0; --len, ++p )
+            crc = (crc >> 8) ^ CRCTable[ (crc & 0xFF) ^ (uint8)*p ];
+        return crc;
     }
 
     constexpr uint32 EncodeCRC32( const uint8* data, uint64 length )
     {
-        return ~CRC32Implementation( data, length, ~0 );
+        if ( std::is_constant_evaluated() )
+            return ~CRC32Implementation( data, length, ~0u );
+        return ~CRC32SliceBy8( data, length, ~0u );
+    }
+
+    constexpr uint32 EncodeCRC32( const U8Char* data, uint64 length )
+    {
+        if ( std::is_constant_evaluated() )
+            return ~CRC32Implementation( data, length, ~0u );
+        return ~CRC32SliceBy8( reinterpret_cast<const uint8*>( data ), length, ~0u );
     }
 
     constexpr uint64 strlen_c( const U8Char* str )
     {
-        return *str ? 1 + strlen_c( str + 1 ) : 0;
+        uint64 length = 0;
+        while ( str[ length ] ) ++length;
+        return length;
     }
 
     constexpr int WSID( const U8Char* str )
     {
-        return EncodeCRC32( (uint8*)str, strlen_c( str ) );
+        return (int)EncodeCRC32( str, strlen_c( str ) );
     }
 
 }
@@ -70,4 +243,15 @@ namespace std {\
             return ret;\
         }\
     };\
+}
+
+// Hashes the whole object in one pass, for integer data without padding.
+// Types with floats use EE_MAKE_HASHABLE, 0.0 and -0.0 are equal but have different bytes
+#define EE_MAKE_HASHABLE_BYTES(type) \
+namespace std {\
+    template<> struct hash<type> {\
+        uint64 operator()(const type &t) const {\
+            return EE::HashValueBytes(t);\
+        }\
+    };\
 }
\ No newline at end of file
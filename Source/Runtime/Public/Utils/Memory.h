@@ -1,5 +1,14 @@
 
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+#include "Core/Collections.h"
 
 namespace EE::Memory
 {
@@ -9,6 +18,82 @@ namespace EE::Memory
 
     void AlignedFree( void* pointer );
 
+    // Subsystems to account allocations for
+    enum EMemoryTag : uint8
+    {
+        MemoryTag_Untagged,
+        MemoryTag_Mesh,
+        MemoryTag_PixelMap,
+        MemoryTag_RHI,
+        MemoryTag_Physics,
+        MemoryTag_Audio,
+        MemoryTag_Importer,
+        MemoryTag_Jobs,
+        MemoryTag_NUM
+    };
+
+    struct MemoryTagStats
+    {
+        uint64 liveBytes;
+        uint64 peakBytes;
+        uint64 liveAllocations;
+        //* Zero if the tag has no budget
+        uint64 budgetBytes;
+    };
+
+    const U8Char* GetMemoryTagName( EMemoryTag tag );
+
+    //* Snapshot of the counters of a tag, safe to call from any thread
+    MemoryTagStats GetMemoryTagStats( EMemoryTag tag );
+
+    //* A warning is logged each time the live bytes of the tag go over the budget, zero disables it
+    void SetMemoryTagBudget( EMemoryTag tag, uint64 budgetBytes );
+
+    // Account memory allocated by other means (containers, pools, external libraries)
+    void TrackAllocation( EMemoryTag tag, size_t size );
+
+    void TrackDeallocation( EMemoryTag tag, size_t size );
+
+    // Aligned allocation accounted to a tag
+    // Free with TaggedFree
+    void* TaggedAlloc( size_t size, size_t alignment, EMemoryTag tag );
+
+    void TaggedFree( void* pointer );
+
+    // STL compatible allocator that accounts its memory to a tag
+    template<typename T, EMemoryTag Tag>
+    class TTaggedAllocator
+    {
+    public:
+        typedef T value_type;
+
+        template<typename U>
+        struct rebind { typedef TTaggedAllocator<U, Tag> other; };
+
+        TTaggedAllocator() noexcept = default;
+
+        template<typename U>
+        TTaggedAllocator( const TTaggedAllocator<U, Tag>& ) noexcept { }
+
+        T* allocate( size_t count )
+        {
+            TrackAllocation( Tag, count * sizeof( T ) );
+            return std::allocator<T>().allocate( count );
+        }
+
+        void deallocate( T* pointer, size_t count ) noexcept
+        {
+            TrackDeallocation( Tag, count * sizeof( T ) );
+            std::allocator<T>().deallocate( pointer, count );
+        }
+
+        template<typename U>
+        bool operator==( const TTaggedAllocator<U, Tag>& ) const noexcept { return true; }
+
+        template<typename U>
+        bool operator!=( const TTaggedAllocator<U, Tag>& ) const noexcept { return false; }
+    };
+
     template<typename T>
     class AlignedMemory
     {
@@ -79,4 +164,365 @@ namespace EE::Memory
                 AlignedFree( pointer );
         }
     };
-}
\ No newline at end of file
+
+    // Linear bump allocator for memory that only lives during a frame.
+    // The arena is split in frameCount regions, NextFrame rotates to the next region and
+    // releases everything allocated in it frameCount frames ago, so allocations from the
+    // previous frames are still valid (e.g. staging data still referenced by the GPU).
+    // Only the owning thread (the one calling NextFrame) may allocate from it.
+    class FrameArena
+    {
+        EE_CLASSNOCOPY( FrameArena )
+
+    public:
+        static constexpr uint32 MaxFrameCount = 3;
+
+        FrameArena( size_t capacityPerFrame, uint32 frameCount = 2 );
+
+        ~FrameArena();
+
+        //* Returns memory valid until this region is recycled, never returns NULL
+        void* Allocate( size_t size, size_t alignment = alignof( std::max_align_t ) );
+
+        template<typename T>
+        FORCEINLINE T* Allocate( size_t count )
+        {
+            return static_cast<T*>( Allocate( count * sizeof( T ), alignof( T ) ) );
+        }
+
+        //* Rotate to the next frame region and reset it
+        void NextFrame();
+
+        inline uint32 GetFrameCount() const { return _frameCount; }
+
+        inline uint32 GetFrameIndex() const { return _frameIndex; }
+
+        inline size_t GetCapacity() const { return _capacity; }
+
+        //* Bytes allocated in the current frame region, including overflow allocations
+        inline size_t GetUsedSize() const { return _frames[ _frameIndex ].offset + _frames[ _frameIndex ].overflowSize; }
+
+        //* Highest amount of bytes used by a single frame
+        inline size_t GetPeakSize() const { return _peakSize; }
+
+        inline bool IsOwningThread() const { return std::this_thread::get_id() == _ownerThread; }
+
+    private:
+        struct FrameRegion
+        {
+            uint8* data;
+            size_t offset;
+            size_t overflowSize;
+            TArray<void*> overflowBlocks;
+        };
+
+        void* AllocateOverflow( FrameRegion& frame, size_t size, size_t alignment );
+
+        void ResetFrame( FrameRegion& frame );
+
+    private:
+        void* _memory;
+        size_t _capacity;
+        size_t _peakSize;
+        uint32 _frameCount;
+        uint32 _frameIndex;
+        std::thread::id _ownerThread;
+        FrameRegion _frames[ MaxFrameCount ];
+    };
+
+    // Engine frame arena, reset at the beginning of each application loop
+    extern FrameArena* GFrameArena;
+
+    // STL compatible allocator that takes its memory from a FrameArena, deallocation is a no-op.
+    // Containers using it must not outlive the arena frame region they allocated from.
+    // If no arena is available, or it is used outside the arena owning thread, it falls back to the global heap.
+    template<typename T>
+    class TFrameAllocator
+    {
+    public:
+        typedef T value_type;
+
+        TFrameAllocator() noexcept : arena( GFrameArena != NULL && GFrameArena->IsOwningThread() ? GFrameArena : NULL ) { }
+
+        TFrameAllocator( FrameArena* arena ) noexcept : arena( arena ) { }
+
+        template<typename U>
+        TFrameAllocator( const TFrameAllocator<U>& other ) noexcept : arena( other.arena ) { }
+
+        T* allocate( size_t count )
+        {
+            if ( arena == NULL )
+                return static_cast<T*>( ::operator new( count * sizeof( T ) ) );
+            return arena->Allocate<T>( count );
+        }
+
+        void deallocate( T* pointer, size_t count ) noexcept
+        {
+            if ( arena == NULL )
+                ::operator delete( pointer );
+        }
+
+        template<typename U>
+        bool operator==( const TFrameAllocator<U>& other ) const noexcept { return arena == other.arena; }
+
+        template<typename U>
+        bool operator!=( const TFrameAllocator<U>& other ) const noexcept { return arena != other.arena; }
+
+    private:
+        template<typename U>
+        friend class TFrameAllocator;
+
+        FrameArena* arena;
+    };
+    // 32-bit handle to an object of a TPool, the lower bits are the slot index and the upper bits
+    // the generation of the slot when it was acquired. A handle with value 0 is never valid.
+    struct PoolHandle
+    {
+        static constexpr uint32 IndexBits = 20;
+        static constexpr uint32 IndexMask = (1u << IndexBits) - 1;
+        static constexpr uint32 GenerationMask = (1u << (32 - IndexBits)) - 1;
+
+        uint32 value = 0;
+
+        constexpr PoolHandle() = default;
+
+        constexpr PoolHandle( uint32 index, uint32 generation ) : value( (generation << IndexBits) | (index & IndexMask) ) { }
+
+        FORCEINLINE constexpr uint32 GetIndex() const { return value & IndexMask; }
+
+        FORCEINLINE constexpr uint32 GetGeneration() const { return value >> IndexBits; }
+
+        FORCEINLINE constexpr bool IsValid() const { return value != 0; }
+
+        FORCEINLINE constexpr bool operator==( const PoolHandle& other ) const { return value == other.value; }
+
+        FORCEINLINE constexpr bool operator!=( const PoolHandle& other ) const { return value != other.value; }
+    };
+
+    // Fixed size object pool, objects are stored in slabs of SlabSize slots that are never moved,
+    // so pointers stay valid until released. Acquire and release are O(1) using an intrusive free list.
+    // Each slot keeps a generation that is increased on release, handles to released objects are detected by Get.
+    // Set ThreadSafe to guard the pool with a mutex when objects are created from several threads.
+    template<typename T, bool ThreadSafe = false, uint32 SlabSize = 256>
+    class TPool
+    {
+        EE_CLASSNOCOPY( TPool )
+
+        static_assert( (SlabSize & (SlabSize - 1)) == 0, "SlabSize must be a power of two" );
+
+    private:
+        static constexpr uint32 InvalidIndex = ~0u;
+
+        struct Slot
+        {
+            // Storage must be the first member, object pointers are reinterpreted as slots
+            alignas(T) uint8 storage[ sizeof( T ) ];
+            uint32 index;
+            uint32 generation;
+            uint32 nextFree;
+            bool alive;
+            // Position in the acquisition sequence, Clear destroys in that order
+            uint64 order;
+        };
+
+        struct NullMutex
+        {
+            FORCEINLINE void lock() { }
+            FORCEINLINE void unlock() { }
+        };
+
+        typedef std::conditional_t<ThreadSafe, std::mutex, NullMutex> MutexType;
+
+    public:
+        TPool( EMemoryTag tag = MemoryTag_Untagged ) : _slabs(), _freeHead( InvalidIndex ), _slotCount( 0 ), _aliveCount( 0 ), _acquireCount( 0 ), _tag( tag ), _mutex() { }
+
+        ~TPool()
+        {
+            Clear();
+            // Each slab was tracked as its own allocation
+            for ( Slot* slab : _slabs )
+            {
+                AlignedFree( slab );
+                TrackDeallocation( _tag, sizeof( Slot ) * SlabSize );
+            }
+        }
+
+        //* Construct a new object in the pool
+        template<typename... Args>
+        T* Acquire( Args&&... args )
+        {
+            Slot* slot;
+            {
+                std::lock_guard<MutexType> lock( _mutex );
+                slot = PopFreeSlot();
+                slot->alive = true;
+                slot->order = _acquireCount++;
+                ++_aliveCount;
+            }
+            return ::new (slot->storage) T( std::forward<Args>( args )... );
+        }
+
+        //* Construct a new object in the pool and return its handle
+        template<typename... Args>
+        PoolHandle Create( Args&&... args )
+        {
+            return GetHandle( Acquire( std::forward<Args>( args )... ) );
+        }
+
+        //* Destroy an object acquired from this pool, releasing it twice is an error
+        void Release( T* object )
+        {
+            if ( object == NULL )
+                return;
+
+            Slot* slot = reinterpret_cast<Slot*>( object );
+            {
+                std::lock_guard<MutexType> lock( _mutex );
+                EE_ASSERT( slot->alive, "Releasing an object that is not alive in this pool" );
+                if ( slot->alive == false )
+                    return;
+                RetireSlot( slot );
+            }
+            DestroySlot( slot );
+        }
+
+        //* Destroy the object of the handle, returns false if the handle is stale
+        bool Release( PoolHandle handle )
+        {
+            Slot* slot;
+            {
+                std::lock_guard<MutexType> lock( _mutex );
+                slot = FindSlot( handle );
+                if ( slot == NULL )
+                    return false;
+                RetireSlot( slot );
+            }
+            DestroySlot( slot );
+            return true;
+        }
+
+        //* Returns the object of the handle or NULL if it has been released
+        T* Get( PoolHandle handle ) const
+        {
+            std::lock_guard<MutexType> lock( _mutex );
+            Slot* slot = FindSlot( handle );
+            return slot == NULL ? NULL : reinterpret_cast<T*>( slot->storage );
+        }
+
+        PoolHandle GetHandle( const T* object ) const
+        {
+            const Slot* slot = reinterpret_cast<const Slot*>( object );
+            return PoolHandle( slot->index, slot->generation );
+        }
+
+        //* Destroy all alive objects in the order they were acquired, memory is kept for reuse.
+        //* Owners made before the objects they own release them first, like a node and its children
+        void Clear()
+        {
+            TArray<std::pair<uint64, PoolHandle>> handles;
+            {
+                std::lock_guard<MutexType> lock( _mutex );
+                for ( uint32 i = 0; i < _slotCount; i++ )
+                {
+                    const Slot& slot = GetSlot( i );
+                    if ( slot.alive )
+                        handles.emplace_back( slot.order, PoolHandle( slot.index, slot.generation ) );
+                }
+            }
+            std::sort( handles.begin(), handles.end(), []( const auto& a, const auto& b ) { return a.first < b.first; } );
+
+            // Destructors may release other objects of the pool, so they run unlocked and
+            // the handles of the objects they already released are stale by then
+            for ( const auto& [ order, handle ] : handles )
+            {
+                Release( handle );
+            }
+        }
+
+        inline uint32 GetCount() const { return _aliveCount; }
+
+        inline uint32 GetCapacity() const { return _slotCount; }
+
+    private:
+        FORCEINLINE Slot& GetSlot( uint32 index ) const
+        {
+            return _slabs[ index / SlabSize ][ index & (SlabSize - 1) ];
+        }
+
+        Slot* PopFreeSlot()
+        {
+            if ( _freeHead == InvalidIndex )
+            {
+                EE_ASSERT( _slotCount + SlabSize <= PoolHandle::IndexMask, "Pool exceeded the maximum count of handles" );
+
+                Slot* slab = static_cast<Slot*>( AlignedAlloc( sizeof( Slot ) * SlabSize, alignof( Slot ) ) );
+                _slabs.push_back( slab );
+                TrackAllocation( _tag, sizeof( Slot ) * SlabSize );
+
+                // Link the new slots in order so they are acquired sequentially
+                for ( uint32 i = 0; i < SlabSize; i++ )
+                {
+                    slab[ i ].index = _slotCount + i;
+                    // Generation 0 is reserved for invalid handles
+                    slab[ i ].generation = 1;
+                    slab[ i ].nextFree = i + 1 < SlabSize ? _slotCount + i + 1 : InvalidIndex;
+                    slab[ i ].alive = false;
+                }
+
+                _freeHead = _slotCount;
+                _slotCount += SlabSize;
+            }
+
+            Slot* slot = &GetSlot( _freeHead );
+            _freeHead = slot->nextFree;
+            return slot;
+        }
+
+        Slot* FindSlot( PoolHandle handle ) const
+        {
+            if ( handle.IsValid() == false || handle.GetIndex() >= _slotCount )
+                return NULL;
+
+            Slot& slot = GetSlot( handle.GetIndex() );
+            if ( slot.alive == false || slot.generation != handle.GetGeneration() )
+                return NULL;
+
+            return &slot;
+        }
+
+        //* Invalidates the handles of the slot, it's not reused until DestroySlot
+        void RetireSlot( Slot* slot )
+        {
+            slot->alive = false;
+            slot->generation = (slot->generation + 1) & PoolHandle::GenerationMask;
+            if ( slot->generation == 0 )
+                slot->generation = 1;
+            --_aliveCount;
+        }
+
+        //* Runs the destructor without holding the lock, it may release other objects of the pool
+        void DestroySlot( Slot* slot )
+        {
+            reinterpret_cast<T*>( slot->storage )->~T();
+
+            std::lock_guard<MutexType> lock( _mutex );
+            slot->nextFree = _freeHead;
+            _freeHead = slot->index;
+        }
+
+    private:
+        TArray<Slot*> _slabs;
+        uint32 _freeHead;
+        uint32 _slotCount;
+        uint32 _aliveCount;
+        uint64 _acquireCount;
+        EMemoryTag _tag;
+        mutable MutexType _mutex;
+    };
+}
+
+// Declares class operators new and delete that account the instances to a memory tag.
+// Deleting through a base class needs a virtual destructor to account the right size.
+#define EE_MEMORY_TAG_OPERATORS( tag ) \
+    static void* operator new( size_t size ) { EE::Memory::TrackAllocation( tag, size ); return ::operator new( size ); } \
+    static void operator delete( void* pointer, size_t size ) { EE::Memory::TrackDeallocation( tag, size ); ::operator delete( pointer ); }
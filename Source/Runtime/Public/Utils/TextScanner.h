@@ -0,0 +1,15 @@
+#pragma once
+
+#include <string_view>
+
+#include "CoreTypes.h"
+
+namespace EE
+{
+    namespace Text
+    {
+        //* Writes the offset of every '\n' in text to outLineEnds and returns how many were found.
+        //* outLineEnds must have room for text.size() entries, scans 32 or 16 bytes per step when SIMD is available
+        size_t FindLineEnds( std::string_view text, uint32* outLineEnds );
+    }
+}
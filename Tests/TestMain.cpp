@@ -0,0 +1,66 @@
+#include "Tests.h"
+
+#include "Core/Collections.h"
+
+namespace EE
+{
+    namespace Tests
+    {
+        struct TestEntry
+        {
+            const char* name;
+            TestFunction function;
+        };
+
+        // Filled during static initialization, before main
+        static TArray<TestEntry>& GetTests()
+        {
+            static TArray<TestEntry> tests;
+            return tests;
+        }
+
+        static uint32 GFailureCount = 0;
+
+        TestRegistration::TestRegistration( const char* name, TestFunction function )
+        {
+            GetTests().push_back( TestEntry{ name, function } );
+        }
+
+        void ReportFailure( const char* file, int32 line, const char* expression )
+        {
+            GFailureCount++;
+            printf( "  %s(%d): failed %s\n", file, line, expression );
+        }
+    }
+}
+
+//* Runs every test, or only the ones whose name contains the first argument
+int main( int argc, char** argv )
+{
+    using namespace EE::Tests;
+
+    const char* filter = argc > 1 ? argv[ 1 ] : NULL;
+    uint32 failedTests = 0;
+    uint32 runTests = 0;
+    for ( const TestEntry& test : GetTests() )
+    {
+        if ( filter != NULL && strstr( test.name, filter ) == NULL )
+            continue;
+
+        const uint32 previousFailures = GFailureCount;
+        test.function();
+        runTests++;
+        if ( GFailureCount > previousFailures )
+        {
+            failedTests++;
+            printf( "[FAILED] %s\n", test.name );
+        }
+        else
+        {
+            printf( "[OK] %s\n", test.name );
+        }
+    }
+
+    printf( "%u of %u tests passed\n", runTests - failedTests, runTests );
+    return failedTests == 0 ? 0 : 1;
+}
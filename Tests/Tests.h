@@ -0,0 +1,29 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace EE
+{
+    namespace Tests
+    {
+        typedef void (*TestFunction)();
+
+        //* Adds a test to the ones TestMain runs, made by EE_TEST
+        struct TestRegistration
+        {
+            TestRegistration( const char* name, TestFunction function );
+        };
+
+        //* Marks the running test as failed and prints the failed expression
+        void ReportFailure( const char* file, int32 line, const char* expression );
+    }
+}
+
+#define EE_TEST( Name ) \
+    static void Name(); \
+    static EE::Tests::TestRegistration Name##Registration( #Name, Name ); \
+    static void Name()
+
+//* Keeps running the test after a failure so every wrong case of it is reported
+#define EE_CHECK( Expression ) \
+    do { if ( !(Expression) ) EE::Tests::ReportFailure( __FILE__, __LINE__, #Expression ); } while ( 0 )
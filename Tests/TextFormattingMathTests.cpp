@@ -0,0 +1,154 @@
+#include "Tests.h"
+
+#include "Utils/TextFormattingMath.h"
+
+#include <bit>
+#include <cmath>
+#include <random>
+
+namespace EE
+{
+    // Same bits as strtof, so signed zeros and the rounding of every case are compared exactly
+    static bool ParsesLikeStrtof( const char* text )
+    {
+        std::string_view view( text );
+        const float value = Text::ParseFloat( &view );
+        const float expected = strtof( text, NULL );
+        if ( std::bit_cast<uint32>( value ) == std::bit_cast<uint32>( expected ) )
+            return true;
+
+        printf( "  '%s' parsed as %.9g, strtof gives %.9g\n", text, value, expected );
+        return false;
+    }
+
+    EE_TEST( ParseFloatSimpleValues )
+    {
+        EE_CHECK( ParsesLikeStrtof( "0" ) );
+        EE_CHECK( ParsesLikeStrtof( "-0" ) );
+        EE_CHECK( ParsesLikeStrtof( "-0.0e10" ) );
+        EE_CHECK( ParsesLikeStrtof( "1" ) );
+        EE_CHECK( ParsesLikeStrtof( "-1.5" ) );
+        EE_CHECK( ParsesLikeStrtof( "+2.25" ) );
+        EE_CHECK( ParsesLikeStrtof( "0.1" ) );
+        EE_CHECK( ParsesLikeStrtof( ".5" ) );
+        EE_CHECK( ParsesLikeStrtof( "5." ) );
+        EE_CHECK( ParsesLikeStrtof( "123456.789" ) );
+        EE_CHECK( ParsesLikeStrtof( "1e10" ) );
+        EE_CHECK( ParsesLikeStrtof( "1E-10" ) );
+        EE_CHECK( ParsesLikeStrtof( "6.02214076e+23" ) );
+        EE_CHECK( ParsesLikeStrtof( "16777217" ) );
+        EE_CHECK( ParsesLikeStrtof( "00000000000000000000000001.5" ) );
+    }
+
+    EE_TEST( ParseFloatLimits )
+    {
+        // Largest finite float, and values around the point where rounding reaches infinity
+        EE_CHECK( ParsesLikeStrtof( "3.40282346638528859811704183484516925440e+38" ) );
+        EE_CHECK( ParsesLikeStrtof( "3.4028235e38" ) );
+        EE_CHECK( ParsesLikeStrtof( "3.40282356779733661637539395458142568447e38" ) );
+        EE_CHECK( ParsesLikeStrtof( "3.40282356779733661637539395458142568448e38" ) );
+        EE_CHECK( ParsesLikeStrtof( "-3.402823567797336616375393954581425684480000000001e38" ) );
+        EE_CHECK( ParsesLikeStrtof( "3.5e38" ) );
+        EE_CHECK( ParsesLikeStrtof( "-3.5e38" ) );
+        EE_CHECK( ParsesLikeStrtof( "1e39" ) );
+        EE_CHECK( ParsesLikeStrtof( "1e400" ) );
+        EE_CHECK( ParsesLikeStrtof( "123456789e30" ) );
+
+        // Smallest normal float and the powers of ten past the table range
+        EE_CHECK( ParsesLikeStrtof( "1.17549435082228750797e-38" ) );
+        EE_CHECK( ParsesLikeStrtof( "1.1754942e-38" ) );
+        EE_CHECK( ParsesLikeStrtof( "1e-38" ) );
+        EE_CHECK( ParsesLikeStrtof( "1e-64" ) );
+        EE_CHECK( ParsesLikeStrtof( "1e-65" ) );
+        EE_CHECK( ParsesLikeStrtof( "1e-400" ) );
+        EE_CHECK( ParsesLikeStrtof( "0.000000000000000000000000000000000000000000000000001e50" ) );
+    }
+
+    EE_TEST( ParseFloatSubnormals )
+    {
+        // Smallest subnormal, half of it ties to even towards zero and anything above rounds up
+        EE_CHECK( ParsesLikeStrtof( "1.40129846432481707092e-45" ) );
+        EE_CHECK( ParsesLikeStrtof( "1.4e-45" ) );
+        EE_CHECK( ParsesLikeStrtof( "7.00649232162408535461e-46" ) );
+        EE_CHECK( ParsesLikeStrtof( "7.006492321624085354618647916449580656401309709382578858785341419448955413429303e-46" ) );
+        EE_CHECK( ParsesLikeStrtof( "7.006492321624085354618647916449580656401309709382578858785341419448955413429304e-46" ) );
+        EE_CHECK( ParsesLikeStrtof( "2.1019476964872256063855943749348e-45" ) );
+        EE_CHECK( ParsesLikeStrtof( "1e-40" ) );
+        EE_CHECK( ParsesLikeStrtof( "-2.5e-41" ) );
+        EE_CHECK( ParsesLikeStrtof( "1.1754942106924411e-38" ) );
+        EE_CHECK( ParsesLikeStrtof( "5.877471754111438e-39" ) );
+    }
+
+    EE_TEST( ParseFloatLongMantissas )
+    {
+        // More digits than fit in 64 bits, the truncated ones decide the rounding
+        EE_CHECK( ParsesLikeStrtof( "0.1000000000000000055511151231257827021181583404541015625" ) );
+        EE_CHECK( ParsesLikeStrtof( "1.000000059604644775390625" ) );
+        EE_CHECK( ParsesLikeStrtof( "1.00000005960464477539062500000000000000000000000000000001" ) );
+        EE_CHECK( ParsesLikeStrtof( "1.00000017881393432617187499999999999999999999999999999999" ) );
+        EE_CHECK( ParsesLikeStrtof( "1.000000178813934326171875" ) );
+        EE_CHECK( ParsesLikeStrtof( "16777216.9999999999999999999999999" ) );
+        EE_CHECK( ParsesLikeStrtof( "33554431.000000000000000000000000000000001" ) );
+        EE_CHECK( ParsesLikeStrtof( "12345678901234567890123456789012345678901234567890" ) );
+        EE_CHECK( ParsesLikeStrtof( "0.00000000000000000000000000000000000000000000000000000000000000000000000000000000001" ) );
+        EE_CHECK( ParsesLikeStrtof( "3.14159265358979323846264338327950288419716939937510582097494459" ) );
+    }
+
+    EE_TEST( ParseFloatRoundTrip )
+    {
+        // Nine significant digits identify every float, longer texts land between floats and test the rounding
+        std::mt19937 random( 1234 );
+        char text[ 64 ];
+        uint32 mismatches = 0;
+        for ( uint32 i = 0; i < 200000; i++ )
+        {
+            const uint32 bits = random();
+            const float value = std::bit_cast<float>( bits );
+            if ( std::isfinite( value ) == false )
+                continue;
+
+            snprintf( text, sizeof( text ), i % 2 == 0 ? "%.9g" : "%.17g", i % 2 == 0 ? value : (double)value * (1.0 + (random() % 1000 - 500) * 1e-10) );
+            if ( ParsesLikeStrtof( text ) == false )
+                mismatches++;
+        }
+        EE_CHECK( mismatches == 0 );
+    }
+
+    EE_TEST( ParseFloatAdvancesText )
+    {
+        std::string_view text = "  1.5, -2\t3e2 x 4";
+        EE_CHECK( Text::ParseFloat( &text ) == 1.5F );
+        EE_CHECK( Text::ParseFloat( &text ) == -2.F );
+        EE_CHECK( Text::ParseFloat( &text ) == 300.F );
+        EE_CHECK( Text::ParseFloat( &text ) == 0.F );
+        EE_CHECK( Text::ParseFloat( &text ) == 4.F );
+        EE_CHECK( text.empty() );
+    }
+
+    EE_TEST( ParseFloat3MatchesParseFloat )
+    {
+        const char* lines[] =
+        {
+            "0.5 -1.25 2",
+            "1e-45 3.4028235e38 1e39",
+            "0.1000000000000000055511151231257827021181583404541015625 7 -0",
+            "1,2,3",
+            "4 5",
+        };
+        for ( const char* line : lines )
+        {
+            std::string_view text( line );
+            Vector3f vector;
+            Text::ParseFloat3( &text, vector );
+
+            std::string_view expectedText( line );
+            const float x = Text::ParseFloat( &expectedText );
+            const float y = Text::ParseFloat( &expectedText );
+            const float z = Text::ParseFloat( &expectedText );
+            EE_CHECK( std::bit_cast<uint32>( vector.x ) == std::bit_cast<uint32>( x ) );
+            EE_CHECK( std::bit_cast<uint32>( vector.y ) == std::bit_cast<uint32>( y ) );
+            EE_CHECK( std::bit_cast<uint32>( vector.z ) == std::bit_cast<uint32>( z ) );
+            EE_CHECK( text.size() == expectedText.size() );
+        }
+    }
+}
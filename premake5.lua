@@ -188,6 +188,109 @@ project "EmptyEngine"
         runtime "Release"
         optimize "Speed"
 
+project "EmptyEngineTests"
+    kind "ConsoleApp"
+    language "C++"
+    cppdialect "C++20"
+    staticruntime "On"
+
+    targetdir ("%{prj.location}/Build/" .. outputdir)
+    objdir ("%{prj.location}/BinObjs/" .. outputdir)
+
+    files {
+        "%{prj.location}/Tests/**.h",
+        "%{prj.location}/Tests/**.cpp",
+    }
+
+    includedirs {
+        "%{prj.location}/Tests",
+        "%{prj.location}/Source",
+        "%{prj.location}/Source/Runtime",
+        "%{prj.location}/Source/Runtime/Public",
+        "%{IncludeDir.spdlog}/include",
+    }
+
+    links {
+        "EmptyEngine",
+        "spdlog",
+    }
+
+    flags { 
+        "MultiProcessorCompile"
+    }
+
+    filter "platforms:Web"
+        systemversion "latest"
+        defines { "EE_PLATFORM_WEB", "__EMSCRIPTEN__" }
+
+    filter "platforms:Win64"
+        systemversion "latest"
+        buildoptions{ "/utf-8" }
+        defines { "EE_PLATFORM_WINDOWS" }
+
+    filter "configurations:Debug"
+        defines { "EE_DEBUG", "EE_ENABLE_ASSERTS" }
+        runtime "Debug"
+        optimize "Debug"
+        symbols "On"
+
+    filter "configurations:Release"
+        defines "EE_RELEASE"
+        runtime "Release"
+        optimize "Speed"
+
+-- Timings are only meaningful optimized, Debug builds still run them to check they work
+project "EmptyEngineBenchmarks"
+    kind "ConsoleApp"
+    language "C++"
+    cppdialect "C++20"
+    staticruntime "On"
+
+    targetdir ("%{prj.location}/Build/" .. outputdir)
+    objdir ("%{prj.location}/BinObjs/" .. outputdir)
+
+    files {
+        "%{prj.location}/Benchmarks/**.h",
+        "%{prj.location}/Benchmarks/**.cpp",
+    }
+
+    includedirs {
+        "%{prj.location}/Benchmarks",
+        "%{prj.location}/Source",
+        "%{prj.location}/Source/Runtime",
+        "%{prj.location}/Source/Runtime/Public",
+        "%{IncludeDir.spdlog}/include",
+    }
+
+    links {
+        "EmptyEngine",
+        "spdlog",
+    }
+
+    flags { 
+        "MultiProcessorCompile"
+    }
+
+    filter "platforms:Web"
+        systemversion "latest"
+        defines { "EE_PLATFORM_WEB", "__EMSCRIPTEN__" }
+
+    filter "platforms:Win64"
+        systemversion "latest"
+        buildoptions{ "/utf-8" }
+        defines { "EE_PLATFORM_WINDOWS" }
+
+    filter "configurations:Debug"
+        defines { "EE_DEBUG", "EE_ENABLE_ASSERTS" }
+        runtime "Debug"
+        optimize "Debug"
+        symbols "On"
+
+    filter "configurations:Release"
+        defines "EE_RELEASE"
+        runtime "Release"
+        optimize "Speed"
+
 project "VMA"
     location "%{IncludeDir.VMA}"
     kind "StaticLib"